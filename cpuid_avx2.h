@@ -39,6 +39,7 @@ void __cpuidex(int cpuInfo[4], int function_id, int subfunction_id)
 
     if (function_id == 1)
     {
+        cpuInfo[CPUID_ECX] |= (1 << 12);    // FMA3 capability bit
         cpuInfo[CPUID_ECX] |= (1 << 28);    // AVX capability bit
     }
 
@@ -47,6 +48,91 @@ void __cpuidex(int cpuInfo[4], int function_id, int subfunction_id)
         cpuInfo[CPUID_EBX] |= (1 << 5);     // AVX2 capability bit
     }
 
+#if defined(SOFT_INTRINSICS_AVX2) && defined(SOFT_INTRINSICS_AVX_VNNI)
+    if ((function_id == 7) && (subfunction_id == 0) && (cpuInfo[CPUID_EAX] < 1))
+    {
+        cpuInfo[CPUID_EAX] = 1;             // max sub-leaf, so that sub-leaf 1 gets queried
+    }
+
+    if ((function_id == 7) && (subfunction_id == 1))
+    {
+        cpuInfo[CPUID_EAX] |= (1 << 4);     // AVX-VNNI capability bit (only when compiled in)
+    }
+#endif
+
+#if defined(SOFT_INTRINSICS_BMI)
+    if ((function_id == 7) && (subfunction_id == 0))
+    {
+        cpuInfo[CPUID_EBX] |= (1 << 3);     // BMI1 capability bit
+        cpuInfo[CPUID_EBX] |= (1 << 8);     // BMI2 capability bit
+    }
+
+    if ((unsigned)function_id == 0x80000001)
+    {
+        cpuInfo[CPUID_ECX] |= (1 << 5);     // LZCNT (ABM) capability bit
+    }
+#endif
+
+#if defined(SOFT_INTRINSICS_POPCNT)
+    if (function_id == 1)
+    {
+        cpuInfo[CPUID_ECX] |= (1 << 23);    // POPCNT capability bit
+    }
+#endif
+
+#if defined(SOFT_INTRINSICS_CRC32)
+    if (function_id == 1)
+    {
+        cpuInfo[CPUID_ECX] |= (1 << 20);    // SSE4.2 capability bit (CRC32, PCMPxSTRx)
+    }
+#endif
+
+#if defined(SOFT_INTRINSICS_AES)
+    if (function_id == 1)
+    {
+        cpuInfo[CPUID_ECX] |= (1 << 25);    // AES-NI capability bit
+    }
+
+    if ((function_id == 7) && (subfunction_id == 0))
+    {
+        cpuInfo[CPUID_ECX] |= (1 << 9);     // VAES capability bit
+    }
+#endif
+
+#if defined(SOFT_INTRINSICS_PCLMULQDQ)
+    if (function_id == 1)
+    {
+        cpuInfo[CPUID_ECX] |= (1 << 1);     // PCLMULQDQ capability bit
+    }
+
+    if ((function_id == 7) && (subfunction_id == 0))
+    {
+        cpuInfo[CPUID_ECX] |= (1 << 10);    // VPCLMULQDQ capability bit
+    }
+#endif
+
+#if defined(SOFT_INTRINSICS_SHA)
+    if ((function_id == 7) && (subfunction_id == 0))
+    {
+        cpuInfo[CPUID_EBX] |= (1 << 29);    // SHA capability bit
+    }
+#endif
+
+#if defined(SOFT_INTRINSICS_F16C)
+    if (function_id == 1)
+    {
+        cpuInfo[CPUID_ECX] |= (1 << 29);    // F16C capability bit
+    }
+#endif
+
+#if defined(SOFT_INTRINSICS_CACHE_CONTROL)
+    if ((function_id == 7) && (subfunction_id == 0))
+    {
+        cpuInfo[CPUID_EBX] |= (1 << 23);    // CLFLUSHOPT capability bit
+        cpuInfo[CPUID_EBX] |= (1 << 24);    // CLWB capability bit
+    }
+#endif
+
     // TODO: overlay other capability bits as intrinsics are implemented
     // e.g. RDRAND
 
@@ -629,6 +629,89 @@ DEFINE_N128_OP_N128_N128(__m128i, mul_epu32,    sw_mulq_u32,    __m128i, a, __m1
 DEFINE_N128_OP_N128_N128(__m128i, mullo_epi16,  vmulq_s16,      __m128i, a, __m128i, b, 0)
 DEFINE_N128_OP_N128_N128(__m128i, mullo_epi32,  vmulq_s32,      __m128i, a, __m128i, b, 0)
 
+// PMADDWD PMADDUBSW
+//
+// PMADDWD is SMULL + SMULL2 of the 16-bit lanes followed by ADDP of adjacent
+// 32-bit products, which wraps the one overflowing case (-32768 * -32768 * 2)
+// to 0x80000000 exactly as x86 does.
+//
+// PMADDUBSW multiplies unsigned bytes of a by signed bytes of b.  Each product
+// fits in 16 bits, so the bytes are widened with UXTL/SXTL and multiplied with
+// MUL, then SADDLP sums adjacent pairs to 32 bits and SQXTN saturates back to 16.
+
+#undef _mm_madd_epi16
+#undef _mm_maddubs_epi16
+
+__forceinline
+__n128 sw_madd_epi16(__n128 a, __n128 b)
+{
+    __n128 lo = vmull_s16(vget_low_s16(a), vget_low_s16(b));
+    __n128 hi = vmull_high_s16(a, b);
+
+    return vpaddq_s32(lo, hi);
+}
+
+__forceinline
+__n128 sw_maddubs_epi16(__n128 a, __n128 b)
+{
+    __n128 lo = vmulq_s16(vmovl_u8(vget_low_u8(a)), vmovl_s8(vget_low_s8(b)));
+    __n128 hi = vmulq_s16(vmovl_high_u8(a), vmovl_high_s8(b));
+
+    return vqmovn_high_s32(vqmovn_s32(vpaddlq_s16(lo)), vpaddlq_s16(hi));
+}
+
+DEFINE_N128_OP_N128_N128(__m128i, madd_epi16,   sw_madd_epi16,  __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, maddubs_epi16,sw_maddubs_epi16,__m128i,a, __m128i, b, 0)
+
+// PSADBW MPSADBW
+//
+// PSADBW is UABD followed by three pairwise accumulating adds (UADDLP) which
+// leave each 8-byte sum in the low 16 bits of a zero-extended qword.
+//
+// MPSADBW compares a 4-byte block of b selected by imm8[1:0] against the eight
+// 4-byte windows of a starting at byte 4 * imm8[2].  The windows are built with
+// EXT, and each of the 4 block bytes is broadcast and accumulated with UABAL.
+
+#undef _mm_sad_epu8
+#undef _mm_mpsadbw_epu8
+
+__forceinline
+__n128 sw_sad_epu8(__n128 a, __n128 b)
+{
+    return vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(vabdq_u8(a, b))));
+}
+
+DEFINE_N128_OP_N128_N128(__m128i, sad_epu8,     sw_sad_epu8,    __m128i, a, __m128i, b, 0)
+
+__forceinline
+__n128 _nn_mpsadbw_epu8(__n128 a, __n128 b, const int imm8)
+{
+    __n128 A = (imm8 & 4) ? vextq_u8(a, a, 4) : a;
+    __n128 B;
+    __n128 T;
+
+    switch (imm8 & 3)
+    {
+        case 0:  B = vdupq_laneq_u32(b, 0); break;
+        case 1:  B = vdupq_laneq_u32(b, 1); break;
+        case 2:  B = vdupq_laneq_u32(b, 2); break;
+        default: B = vdupq_laneq_u32(b, 3); break;
+    }
+
+    T = vabdl_u8(     vget_low_u8(A),                vdup_laneq_u8(B, 0));
+    T = vabal_u8(T,   vget_low_u8(vextq_u8(A, A, 1)), vdup_laneq_u8(B, 1));
+    T = vabal_u8(T,   vget_low_u8(vextq_u8(A, A, 2)), vdup_laneq_u8(B, 2));
+    T = vabal_u8(T,   vget_low_u8(vextq_u8(A, A, 3)), vdup_laneq_u8(B, 3));
+
+    return T;
+}
+
+__forceinline
+__m128i _mm_mpsadbw_epu8(__m128i a, __m128i b, const int imm8)
+{
+    return _nn128_castn128_si128( _nn_mpsadbw_epu8(_nn128_castsi128_n128(a), _nn128_castsi128_n128(b), imm8) );
+}
+
 // PADDS PADDUS
 
 #undef _mm_adds_epi8
@@ -979,6 +1062,242 @@ __m128 _mm_sqrt_ss(__m128 a)
     return _nn128_castn128_ps( _nn_sqrt_ss(_nn128_castps_n128(a)) );
 }
 
+// ROUNDPD ROUNDPS ROUNDSD ROUNDSS
+
+#ifndef _MM_FROUND_TO_NEAREST_INT
+#define _MM_FROUND_TO_NEAREST_INT    0x00
+#define _MM_FROUND_TO_NEG_INF        0x01
+#define _MM_FROUND_TO_POS_INF        0x02
+#define _MM_FROUND_TO_ZERO           0x03
+#define _MM_FROUND_CUR_DIRECTION     0x04
+#define _MM_FROUND_NO_EXC            0x08
+#define _MM_FROUND_FLOOR             (_MM_FROUND_TO_NEG_INF)
+#define _MM_FROUND_CEIL              (_MM_FROUND_TO_POS_INF)
+#endif
+
+#undef _mm_round_pd
+#undef _mm_round_ps
+#undef _mm_round_sd
+#undef _mm_round_ss
+#undef _mm_floor_pd
+#undef _mm_floor_ps
+#undef _mm_floor_sd
+#undef _mm_floor_ss
+#undef _mm_ceil_pd
+#undef _mm_ceil_ps
+#undef _mm_ceil_sd
+#undef _mm_ceil_ss
+
+// imm8[2] selects the current rounding mode, which on ARM64 is FPCR.RMode,
+// the register backing the emulated MXCSR.RC. Otherwise imm8[1:0] selects
+// the mode directly. imm8[3] (suppress precision exception) has no effect.
+// FRINT* preserves signed zero and quiets signalling NaNs just like ROUNDPS.
+
+__forceinline
+__n128 sw_round_pd(__n128 a, const int imm8)
+{
+    if (imm8 & _MM_FROUND_CUR_DIRECTION)
+        return vrndiq_f64(a);
+
+    switch (imm8 & 3)
+    {
+    case _MM_FROUND_TO_NEAREST_INT: return vrndnq_f64(a);
+    case _MM_FROUND_TO_NEG_INF:     return vrndmq_f64(a);
+    case _MM_FROUND_TO_POS_INF:     return vrndpq_f64(a);
+    default:                        return vrndq_f64(a);
+    }
+}
+
+__forceinline
+__n128 sw_round_ps(__n128 a, const int imm8)
+{
+    if (imm8 & _MM_FROUND_CUR_DIRECTION)
+        return vrndiq_f32(a);
+
+    switch (imm8 & 3)
+    {
+    case _MM_FROUND_TO_NEAREST_INT: return vrndnq_f32(a);
+    case _MM_FROUND_TO_NEG_INF:     return vrndmq_f32(a);
+    case _MM_FROUND_TO_POS_INF:     return vrndpq_f32(a);
+    default:                        return vrndq_f32(a);
+    }
+}
+
+__forceinline
+__n128 _nn_round_pd(__n128 a, const int imm8)
+{
+    return sw_round_pd(a, imm8);
+}
+
+__forceinline
+__n128 _nn_round_ps(__n128 a, const int imm8)
+{
+    return sw_round_ps(a, imm8);
+}
+
+__forceinline
+__n128 _nn_round_sd(__n128 a, __n128 b, const int imm8)
+{
+    // ROUND(b) gets merged in to lower lane of a
+
+    __n128 T = sw_round_pd(b, imm8);
+    T = _nn_postprocess(T, a, b, _IF_SCALAR_INSERT_F64);
+
+    return T;
+}
+
+__forceinline
+__n128 _nn_round_ss(__n128 a, __n128 b, const int imm8)
+{
+    // ROUND(b) gets merged in to lower lane of a
+
+    __n128 T = sw_round_ps(b, imm8);
+    T = _nn_postprocess(T, a, b, _IF_SCALAR_INSERT_F32);
+
+    return T;
+}
+
+__forceinline
+__m128d _mm_round_pd(__m128d a, const int imm8)
+{
+    return _nn128_castn128_pd( _nn_round_pd(_nn128_castpd_n128(a), imm8) );
+}
+
+__forceinline
+__m128 _mm_round_ps(__m128 a, const int imm8)
+{
+    return _nn128_castn128_ps( _nn_round_ps(_nn128_castps_n128(a), imm8) );
+}
+
+__forceinline
+__m128d _mm_round_sd(__m128d a, __m128d b, const int imm8)
+{
+    return _nn128_castn128_pd( _nn_round_sd(_nn128_castpd_n128(a), _nn128_castpd_n128(b), imm8) );
+}
+
+__forceinline
+__m128 _mm_round_ss(__m128 a, __m128 b, const int imm8)
+{
+    return _nn128_castn128_ps( _nn_round_ss(_nn128_castps_n128(a), _nn128_castps_n128(b), imm8) );
+}
+
+#define _nn_floor_pd(a)         _nn_round_pd((a), _MM_FROUND_FLOOR)
+#define _nn_floor_ps(a)         _nn_round_ps((a), _MM_FROUND_FLOOR)
+#define _nn_floor_sd(a, b)      _nn_round_sd((a), (b), _MM_FROUND_FLOOR)
+#define _nn_floor_ss(a, b)      _nn_round_ss((a), (b), _MM_FROUND_FLOOR)
+#define _nn_ceil_pd(a)          _nn_round_pd((a), _MM_FROUND_CEIL)
+#define _nn_ceil_ps(a)          _nn_round_ps((a), _MM_FROUND_CEIL)
+#define _nn_ceil_sd(a, b)       _nn_round_sd((a), (b), _MM_FROUND_CEIL)
+#define _nn_ceil_ss(a, b)       _nn_round_ss((a), (b), _MM_FROUND_CEIL)
+
+#define _mm_floor_pd(a)         _mm_round_pd((a), _MM_FROUND_FLOOR)
+#define _mm_floor_ps(a)         _mm_round_ps((a), _MM_FROUND_FLOOR)
+#define _mm_floor_sd(a, b)      _mm_round_sd((a), (b), _MM_FROUND_FLOOR)
+#define _mm_floor_ss(a, b)      _mm_round_ss((a), (b), _MM_FROUND_FLOOR)
+#define _mm_ceil_pd(a)          _mm_round_pd((a), _MM_FROUND_CEIL)
+#define _mm_ceil_ps(a)          _mm_round_ps((a), _MM_FROUND_CEIL)
+#define _mm_ceil_sd(a, b)       _mm_round_sd((a), (b), _MM_FROUND_CEIL)
+#define _mm_ceil_ss(a, b)       _mm_round_ss((a), (b), _MM_FROUND_CEIL)
+
+// VFMADD VFMSUB VFNMADD VFNMSUB (FMA3)
+//
+// Fused multiply-add with a single rounding step, which NEON FMLA/FMLS provide natively.
+// Note that NEON accumulates into the first operand, i.e. vfmaq_f32(c, a, b) = c + a * b
+
+#undef _mm_fmadd_pd
+#undef _mm_fmadd_ps
+#undef _mm_fmadd_sd
+#undef _mm_fmadd_ss
+#undef _mm_fmsub_pd
+#undef _mm_fmsub_ps
+#undef _mm_fmsub_sd
+#undef _mm_fmsub_ss
+#undef _mm_fnmadd_pd
+#undef _mm_fnmadd_ps
+#undef _mm_fnmadd_sd
+#undef _mm_fnmadd_ss
+#undef _mm_fnmsub_pd
+#undef _mm_fnmsub_ps
+#undef _mm_fnmsub_sd
+#undef _mm_fnmsub_ss
+#undef _mm_fmaddsub_pd
+#undef _mm_fmaddsub_ps
+#undef _mm_fmsubadd_pd
+#undef _mm_fmsubadd_ps
+
+__forceinline __n128d sw_fmadd_pd (__n128d a, __n128d b, __n128d c) { return vfmaq_f64(c, a, b); }                  //  (a * b) + c
+__forceinline __n128  sw_fmadd_ps (__n128  a, __n128  b, __n128  c) { return vfmaq_f32(c, a, b); }
+__forceinline __n128d sw_fmsub_pd (__n128d a, __n128d b, __n128d c) { return vfmaq_f64(vnegq_f64(c), a, b); }       //  (a * b) - c
+__forceinline __n128  sw_fmsub_ps (__n128  a, __n128  b, __n128  c) { return vfmaq_f32(vnegq_f32(c), a, b); }
+__forceinline __n128d sw_fnmadd_pd(__n128d a, __n128d b, __n128d c) { return vfmsq_f64(c, a, b); }                  // -(a * b) + c
+__forceinline __n128  sw_fnmadd_ps(__n128  a, __n128  b, __n128  c) { return vfmsq_f32(c, a, b); }
+__forceinline __n128d sw_fnmsub_pd(__n128d a, __n128d b, __n128d c) { return vfmsq_f64(vnegq_f64(c), a, b); }       // -(a * b) - c
+__forceinline __n128  sw_fnmsub_ps(__n128  a, __n128  b, __n128  c) { return vfmsq_f32(vnegq_f32(c), a, b); }
+
+DEFINE_N128_OP_N128_N128_N128(__m128d, fmadd_pd,  sw_fmadd_pd,    __m128d, a, __m128d, b, __m128d, c,    0)
+DEFINE_N128_OP_N128_N128_N128(__m128,  fmadd_ps,  sw_fmadd_ps,    __m128,  a, __m128,  b, __m128,  c,    0)
+DEFINE_N128_OP_N128_N128_N128(__m128d, fmadd_sd,  sw_fmadd_pd,    __m128d, a, __m128d, b, __m128d, c,    _IF_SCALAR_INSERT_F64)
+DEFINE_N128_OP_N128_N128_N128(__m128,  fmadd_ss,  sw_fmadd_ps,    __m128,  a, __m128,  b, __m128,  c,    _IF_SCALAR_INSERT_F32)
+
+DEFINE_N128_OP_N128_N128_N128(__m128d, fmsub_pd,  sw_fmsub_pd,    __m128d, a, __m128d, b, __m128d, c,    0)
+DEFINE_N128_OP_N128_N128_N128(__m128,  fmsub_ps,  sw_fmsub_ps,    __m128,  a, __m128,  b, __m128,  c,    0)
+DEFINE_N128_OP_N128_N128_N128(__m128d, fmsub_sd,  sw_fmsub_pd,    __m128d, a, __m128d, b, __m128d, c,    _IF_SCALAR_INSERT_F64)
+DEFINE_N128_OP_N128_N128_N128(__m128,  fmsub_ss,  sw_fmsub_ps,    __m128,  a, __m128,  b, __m128,  c,    _IF_SCALAR_INSERT_F32)
+
+DEFINE_N128_OP_N128_N128_N128(__m128d, fnmadd_pd, sw_fnmadd_pd,   __m128d, a, __m128d, b, __m128d, c,    0)
+DEFINE_N128_OP_N128_N128_N128(__m128,  fnmadd_ps, sw_fnmadd_ps,   __m128,  a, __m128,  b, __m128,  c,    0)
+DEFINE_N128_OP_N128_N128_N128(__m128d, fnmadd_sd, sw_fnmadd_pd,   __m128d, a, __m128d, b, __m128d, c,    _IF_SCALAR_INSERT_F64)
+DEFINE_N128_OP_N128_N128_N128(__m128,  fnmadd_ss, sw_fnmadd_ps,   __m128,  a, __m128,  b, __m128,  c,    _IF_SCALAR_INSERT_F32)
+
+DEFINE_N128_OP_N128_N128_N128(__m128d, fnmsub_pd, sw_fnmsub_pd,   __m128d, a, __m128d, b, __m128d, c,    0)
+DEFINE_N128_OP_N128_N128_N128(__m128,  fnmsub_ps, sw_fnmsub_ps,   __m128,  a, __m128,  b, __m128,  c,    0)
+DEFINE_N128_OP_N128_N128_N128(__m128d, fnmsub_sd, sw_fnmsub_pd,   __m128d, a, __m128d, b, __m128d, c,    _IF_SCALAR_INSERT_F64)
+DEFINE_N128_OP_N128_N128_N128(__m128,  fnmsub_ss, sw_fnmsub_ps,   __m128,  a, __m128,  b, __m128,  c,    _IF_SCALAR_INSERT_F32)
+
+// VFMADDSUB VFMSUBADD
+//
+// Even lanes subtract and odd lanes add (or vice versa), done by flipping the sign
+// of the alternate lanes of c so that it is still a single FMLA with one rounding.
+
+__forceinline
+__n128d sw_fmaddsub_pd(__n128d a, __n128d b, __n128d c)
+{
+    __n128d NegC = neon_insqe64q(c, 0, vnegq_f64(c), 0);   // -c0  +c1
+
+    return vfmaq_f64(NegC, a, b);
+}
+
+__forceinline
+__n128 sw_fmaddsub_ps(__n128 a, __n128 b, __n128 c)
+{
+    const __n128 SignMask = neon_dupqr64(0x0000000080000000ull);  // -c0  +c1  -c2  +c3
+    __n128 NegC = neon_eorq(c, SignMask);
+
+    return vfmaq_f32(NegC, a, b);
+}
+
+__forceinline
+__n128d sw_fmsubadd_pd(__n128d a, __n128d b, __n128d c)
+{
+    __n128d NegC = neon_insqe64q(c, 1, vnegq_f64(c), 1);   // +c0  -c1
+
+    return vfmaq_f64(NegC, a, b);
+}
+
+__forceinline
+__n128 sw_fmsubadd_ps(__n128 a, __n128 b, __n128 c)
+{
+    const __n128 SignMask = neon_dupqr64(0x8000000000000000ull);  // +c0  -c1  +c2  -c3
+    __n128 NegC = neon_eorq(c, SignMask);
+
+    return vfmaq_f32(NegC, a, b);
+}
+
+DEFINE_N128_OP_N128_N128_N128(__m128d, fmaddsub_pd, sw_fmaddsub_pd, __m128d, a, __m128d, b, __m128d, c,  0)
+DEFINE_N128_OP_N128_N128_N128(__m128,  fmaddsub_ps, sw_fmaddsub_ps, __m128,  a, __m128,  b, __m128,  c,  0)
+DEFINE_N128_OP_N128_N128_N128(__m128d, fmsubadd_pd, sw_fmsubadd_pd, __m128d, a, __m128d, b, __m128d, c,  0)
+DEFINE_N128_OP_N128_N128_N128(__m128,  fmsubadd_ps, sw_fmsubadd_ps, __m128,  a, __m128,  b, __m128,  c,  0)
+
 // PSLLV PSRLV PSRARV
 
 #undef _mm_sllv_epi32
@@ -1062,6 +1381,274 @@ DEFINE_N128_OP_N128_N128(__m128i, srav_epi32,   sw_srav_epi32,  __m128i, a, __m1
 DEFINE_N128_OP_N128_N128(__m128i, srlv_epi32,   sw_srlv_epi32,  __m128i, a, __m128i, b, 0)
 DEFINE_N128_OP_N128_N128(__m128i, srlv_epi64,   sw_srlv_epi64,  __m128i, a, __m128i, b, 0)
 
+// PACKSSWB PACKSSDW PACKUSWB PACKUSDW
+//
+// The first source narrows into the low half and the second source into the high half,
+// which is exactly SQXTN/SQXTUN followed by SQXTN2/SQXTUN2.
+
+#undef _mm_packs_epi16
+#undef _mm_packs_epi32
+#undef _mm_packus_epi16
+#undef _mm_packus_epi32
+
+__forceinline
+__n128 sw_packs_epi16(__n128 a, __n128 b)
+{
+    return vqmovn_high_s16(vqmovn_s16(a), b);
+}
+
+__forceinline
+__n128 sw_packs_epi32(__n128 a, __n128 b)
+{
+    return vqmovn_high_s32(vqmovn_s32(a), b);
+}
+
+__forceinline
+__n128 sw_packus_epi16(__n128 a, __n128 b)
+{
+    return vqmovun_high_s16(vqmovun_s16(a), b);
+}
+
+__forceinline
+__n128 sw_packus_epi32(__n128 a, __n128 b)
+{
+    return vqmovun_high_s32(vqmovun_s32(a), b);
+}
+
+DEFINE_N128_OP_N128_N128(__m128i, packs_epi16,  sw_packs_epi16, __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, packs_epi32,  sw_packs_epi32, __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, packus_epi16, sw_packus_epi16,__m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, packus_epi32, sw_packus_epi32,__m128i, a, __m128i, b, 0)
+
+// PUNPCKL PUNPCKH UNPCKLPS UNPCKHPS UNPCKLPD UNPCKHPD
+
+#undef _mm_unpacklo_epi8
+#undef _mm_unpacklo_epi16
+#undef _mm_unpacklo_epi32
+#undef _mm_unpacklo_epi64
+#undef _mm_unpackhi_epi8
+#undef _mm_unpackhi_epi16
+#undef _mm_unpackhi_epi32
+#undef _mm_unpackhi_epi64
+#undef _mm_unpacklo_ps
+#undef _mm_unpackhi_ps
+#undef _mm_unpacklo_pd
+#undef _mm_unpackhi_pd
+
+DEFINE_N128_OP_N128_N128(__m128i, unpacklo_epi8,  vzip1q_u8,  __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, unpacklo_epi16, vzip1q_u16, __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, unpacklo_epi32, vzip1q_u32, __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, unpacklo_epi64, vzip1q_u64, __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, unpackhi_epi8,  vzip2q_u8,  __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, unpackhi_epi16, vzip2q_u16, __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, unpackhi_epi32, vzip2q_u32, __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, unpackhi_epi64, vzip2q_u64, __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128,  unpacklo_ps,    vzip1q_u32, __m128,  a, __m128,  b, 0)
+DEFINE_N128_OP_N128_N128(__m128,  unpackhi_ps,    vzip2q_u32, __m128,  a, __m128,  b, 0)
+DEFINE_N128_OP_N128_N128(__m128d, unpacklo_pd,    vzip1q_u64, __m128d, a, __m128d, b, 0)
+DEFINE_N128_OP_N128_N128(__m128d, unpackhi_pd,    vzip2q_u64, __m128d, a, __m128d, b, 0)
+
+// PMOVSX PMOVZX
+//
+// Each widening step is one SXTL/UXTL of the low 64 bits, chained for 4x and 8x widening.
+
+#undef _mm_cvtepi8_epi16
+#undef _mm_cvtepi8_epi32
+#undef _mm_cvtepi8_epi64
+#undef _mm_cvtepi16_epi32
+#undef _mm_cvtepi16_epi64
+#undef _mm_cvtepi32_epi64
+#undef _mm_cvtepu8_epi16
+#undef _mm_cvtepu8_epi32
+#undef _mm_cvtepu8_epi64
+#undef _mm_cvtepu16_epi32
+#undef _mm_cvtepu16_epi64
+#undef _mm_cvtepu32_epi64
+
+__forceinline __n128 sw_sxtl8 (__n128 const a)  { return vmovl_s8 (vget_low_s8 (a)); }
+__forceinline __n128 sw_sxtl16(__n128 const a)  { return vmovl_s16(vget_low_s16(a)); }
+__forceinline __n128 sw_sxtl32(__n128 const a)  { return vmovl_s32(vget_low_s32(a)); }
+__forceinline __n128 sw_uxtl8 (__n128 const a)  { return vmovl_u8 (vget_low_u8 (a)); }
+__forceinline __n128 sw_uxtl16(__n128 const a)  { return vmovl_u16(vget_low_u16(a)); }
+__forceinline __n128 sw_uxtl32(__n128 const a)  { return vmovl_u32(vget_low_u32(a)); }
+
+__forceinline __n128 sw_cvtepi8_epi16 (__n128 const a) { return sw_sxtl8(a); }
+__forceinline __n128 sw_cvtepi8_epi32 (__n128 const a) { return sw_sxtl16(sw_sxtl8(a)); }
+__forceinline __n128 sw_cvtepi8_epi64 (__n128 const a) { return sw_sxtl32(sw_sxtl16(sw_sxtl8(a))); }
+__forceinline __n128 sw_cvtepi16_epi32(__n128 const a) { return sw_sxtl16(a); }
+__forceinline __n128 sw_cvtepi16_epi64(__n128 const a) { return sw_sxtl32(sw_sxtl16(a)); }
+__forceinline __n128 sw_cvtepi32_epi64(__n128 const a) { return sw_sxtl32(a); }
+__forceinline __n128 sw_cvtepu8_epi16 (__n128 const a) { return sw_uxtl8(a); }
+__forceinline __n128 sw_cvtepu8_epi32 (__n128 const a) { return sw_uxtl16(sw_uxtl8(a)); }
+__forceinline __n128 sw_cvtepu8_epi64 (__n128 const a) { return sw_uxtl32(sw_uxtl16(sw_uxtl8(a))); }
+__forceinline __n128 sw_cvtepu16_epi32(__n128 const a) { return sw_uxtl16(a); }
+__forceinline __n128 sw_cvtepu16_epi64(__n128 const a) { return sw_uxtl32(sw_uxtl16(a)); }
+__forceinline __n128 sw_cvtepu32_epi64(__n128 const a) { return sw_uxtl32(a); }
+
+DEFINE_N128_OP_N128(__m128i, cvtepi8_epi16,  sw_cvtepi8_epi16,  __m128i, a, 0)
+DEFINE_N128_OP_N128(__m128i, cvtepi8_epi32,  sw_cvtepi8_epi32,  __m128i, a, 0)
+DEFINE_N128_OP_N128(__m128i, cvtepi8_epi64,  sw_cvtepi8_epi64,  __m128i, a, 0)
+DEFINE_N128_OP_N128(__m128i, cvtepi16_epi32, sw_cvtepi16_epi32, __m128i, a, 0)
+DEFINE_N128_OP_N128(__m128i, cvtepi16_epi64, sw_cvtepi16_epi64, __m128i, a, 0)
+DEFINE_N128_OP_N128(__m128i, cvtepi32_epi64, sw_cvtepi32_epi64, __m128i, a, 0)
+DEFINE_N128_OP_N128(__m128i, cvtepu8_epi16,  sw_cvtepu8_epi16,  __m128i, a, 0)
+DEFINE_N128_OP_N128(__m128i, cvtepu8_epi32,  sw_cvtepu8_epi32,  __m128i, a, 0)
+DEFINE_N128_OP_N128(__m128i, cvtepu8_epi64,  sw_cvtepu8_epi64,  __m128i, a, 0)
+DEFINE_N128_OP_N128(__m128i, cvtepu16_epi32, sw_cvtepu16_epi32, __m128i, a, 0)
+DEFINE_N128_OP_N128(__m128i, cvtepu16_epi64, sw_cvtepu16_epi64, __m128i, a, 0)
+DEFINE_N128_OP_N128(__m128i, cvtepu32_epi64, sw_cvtepu32_epi64, __m128i, a, 0)
+
+// Load-fused forms, equivalent to PMOVSX/PMOVZX with a memory operand, which read
+// only the bytes that are consumed (2, 4, or 8) rather than a full 16 bytes.
+
+__forceinline __n128 sw_load_lo16(void const * p) { return vld1q_lane_u16((unsigned __int16 const *)p, neon_moviqw(0), 0); }
+__forceinline __n128 sw_load_lo32(void const * p) { return vld1q_lane_u32((unsigned __int32 const *)p, neon_moviqw(0), 0); }
+__forceinline __n128 sw_load_lo64(void const * p) { return vld1q_lane_u64((unsigned __int64 const *)p, neon_moviqw(0), 0); }
+
+__forceinline __n128i _nn_cvtepi8_epi16_mem (void const * p) { return sw_cvtepi8_epi16 (sw_load_lo64(p)); }
+__forceinline __n128i _nn_cvtepi8_epi32_mem (void const * p) { return sw_cvtepi8_epi32 (sw_load_lo32(p)); }
+__forceinline __n128i _nn_cvtepi8_epi64_mem (void const * p) { return sw_cvtepi8_epi64 (sw_load_lo16(p)); }
+__forceinline __n128i _nn_cvtepi16_epi32_mem(void const * p) { return sw_cvtepi16_epi32(sw_load_lo64(p)); }
+__forceinline __n128i _nn_cvtepi16_epi64_mem(void const * p) { return sw_cvtepi16_epi64(sw_load_lo32(p)); }
+__forceinline __n128i _nn_cvtepi32_epi64_mem(void const * p) { return sw_cvtepi32_epi64(sw_load_lo64(p)); }
+__forceinline __n128i _nn_cvtepu8_epi16_mem (void const * p) { return sw_cvtepu8_epi16 (sw_load_lo64(p)); }
+__forceinline __n128i _nn_cvtepu8_epi32_mem (void const * p) { return sw_cvtepu8_epi32 (sw_load_lo32(p)); }
+__forceinline __n128i _nn_cvtepu8_epi64_mem (void const * p) { return sw_cvtepu8_epi64 (sw_load_lo16(p)); }
+__forceinline __n128i _nn_cvtepu16_epi32_mem(void const * p) { return sw_cvtepu16_epi32(sw_load_lo64(p)); }
+__forceinline __n128i _nn_cvtepu16_epi64_mem(void const * p) { return sw_cvtepu16_epi64(sw_load_lo32(p)); }
+__forceinline __n128i _nn_cvtepu32_epi64_mem(void const * p) { return sw_cvtepu32_epi64(sw_load_lo64(p)); }
+
+// PALIGNR
+//
+// The 32-byte concatenation a:b shifted right by imm8 bytes is a single EXT for
+// any constant imm8 below 16.  Shifts of 16 to 31 bytes shift a into zeroes, and
+// shifts of 32 or more produce zero, exactly as the x86 instruction does.
+
+#undef _mm_alignr_epi8
+
+__forceinline
+__n128 _nn_alignr_epi8(__n128 a, __n128 b, const int imm8)
+{
+    const __n128 Zero = neon_moviqw(0);
+
+    switch (imm8 & 0xFF)
+    {
+        case  0: return vextq_u8(b, a,  0);
+        case  1: return vextq_u8(b, a,  1);
+        case  2: return vextq_u8(b, a,  2);
+        case  3: return vextq_u8(b, a,  3);
+        case  4: return vextq_u8(b, a,  4);
+        case  5: return vextq_u8(b, a,  5);
+        case  6: return vextq_u8(b, a,  6);
+        case  7: return vextq_u8(b, a,  7);
+        case  8: return vextq_u8(b, a,  8);
+        case  9: return vextq_u8(b, a,  9);
+        case 10: return vextq_u8(b, a, 10);
+        case 11: return vextq_u8(b, a, 11);
+        case 12: return vextq_u8(b, a, 12);
+        case 13: return vextq_u8(b, a, 13);
+        case 14: return vextq_u8(b, a, 14);
+        case 15: return vextq_u8(b, a, 15);
+        case 16: return vextq_u8(a, Zero,  0);
+        case 17: return vextq_u8(a, Zero,  1);
+        case 18: return vextq_u8(a, Zero,  2);
+        case 19: return vextq_u8(a, Zero,  3);
+        case 20: return vextq_u8(a, Zero,  4);
+        case 21: return vextq_u8(a, Zero,  5);
+        case 22: return vextq_u8(a, Zero,  6);
+        case 23: return vextq_u8(a, Zero,  7);
+        case 24: return vextq_u8(a, Zero,  8);
+        case 25: return vextq_u8(a, Zero,  9);
+        case 26: return vextq_u8(a, Zero, 10);
+        case 27: return vextq_u8(a, Zero, 11);
+        case 28: return vextq_u8(a, Zero, 12);
+        case 29: return vextq_u8(a, Zero, 13);
+        case 30: return vextq_u8(a, Zero, 14);
+        case 31: return vextq_u8(a, Zero, 15);
+        default: return Zero;
+    }
+}
+
+__forceinline
+__m128i _mm_alignr_epi8(__m128i a, __m128i b, const int imm8)
+{
+    return _nn128_castn128_si128( _nn_alignr_epi8(_nn128_castsi128_n128(a), _nn128_castsi128_n128(b), imm8) );
+}
+
+// PEXTRB PEXTRW PEXTRD PEXTRQ PINSRB PINSRW PINSRD PINSRQ
+//
+// These are macros so that the lane number reaches UMOV/INS as a literal.
+
+#undef _mm_extract_epi8
+#undef _mm_extract_epi16
+#undef _mm_extract_epi32
+#undef _mm_extract_epi64
+#undef _mm_insert_epi8
+#undef _mm_insert_epi16
+#undef _mm_insert_epi32
+#undef _mm_insert_epi64
+
+#define _nn_extract_epi8(a, imm8)       ((int)vgetq_lane_u8 ((a), (imm8) & 15))
+#define _nn_extract_epi16(a, imm8)      ((int)vgetq_lane_u16((a), (imm8) & 7))
+#define _nn_extract_epi32(a, imm8)      ((int)vgetq_lane_u32((a), (imm8) & 3))
+#define _nn_extract_epi64(a, imm8)      ((__int64)vgetq_lane_u64((a), (imm8) & 1))
+
+#define _nn_insert_epi8(a, i, imm8)     vsetq_lane_u8 ((unsigned __int8)(i),  (a), (imm8) & 15)
+#define _nn_insert_epi16(a, i, imm8)    vsetq_lane_u16((unsigned __int16)(i), (a), (imm8) & 7)
+#define _nn_insert_epi32(a, i, imm8)    vsetq_lane_u32((unsigned __int32)(i), (a), (imm8) & 3)
+#define _nn_insert_epi64(a, i, imm8)    vsetq_lane_u64((unsigned __int64)(i), (a), (imm8) & 1)
+
+#define _mm_extract_epi8(a, imm8)       _nn_extract_epi8 (__n128_from___m128i(a), imm8)
+#define _mm_extract_epi16(a, imm8)      _nn_extract_epi16(__n128_from___m128i(a), imm8)
+#define _mm_extract_epi32(a, imm8)      _nn_extract_epi32(__n128_from___m128i(a), imm8)
+#define _mm_extract_epi64(a, imm8)      _nn_extract_epi64(__n128_from___m128i(a), imm8)
+
+#define _mm_insert_epi8(a, i, imm8)     __m128i_from___n128(_nn_insert_epi8 (__n128_from___m128i(a), i, imm8))
+#define _mm_insert_epi16(a, i, imm8)    __m128i_from___n128(_nn_insert_epi16(__n128_from___m128i(a), i, imm8))
+#define _mm_insert_epi32(a, i, imm8)    __m128i_from___n128(_nn_insert_epi32(__n128_from___m128i(a), i, imm8))
+#define _mm_insert_epi64(a, i, imm8)    __m128i_from___n128(_nn_insert_epi64(__n128_from___m128i(a), i, imm8))
+
+// PSHUFB
+
+#undef _mm_shuffle_epi8
+
+// TBL returns zero for any index past the 16-byte table, so keeping only bit 7
+// and the low nibble of each index gives the PSHUFB zeroing with a single AND
+
+__forceinline
+__n128 sw_shuffle_epi8(__n128 a, __n128 b)
+{
+    __n128 T = vqtbl1q_u8(a, neon_andq(b, vdupq_n_u8(0x8F)));
+
+    return T;
+}
+
+DEFINE_N128_OP_N128_N128(__m128i, shuffle_epi8, sw_shuffle_epi8, __m128i, a, __m128i, b, 0)
+
+// VPOPCNTB VPOPCNTQ (native twins only, there are no AVX2 forms)
+//
+// The usual AVX2 byte popcount is a nibble lookup with PSHUFB followed by PSADBW
+// for 64-bit sums, which NEON does with CNT and a chain of pairwise widening adds
+
+__forceinline
+__n128 sw_popcount_epi8(__n128 a)
+{
+    __n128 T = vcntq_u8(a);
+
+    return T;
+}
+
+__forceinline
+__n128 sw_popcount_epi64(__n128 a)
+{
+    __n128 T = vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(vcntq_u8(a))));
+
+    return T;
+}
+
+__forceinline __n128 _nn_popcount_epi8(__n128 a)  { return sw_popcount_epi8(a); }
+__forceinline __n128 _nn_popcount_epi64(__n128 a) { return sw_popcount_epi64(a); }
+
 // PSHUFD
 
 #undef _mm_shuffle_epi32
@@ -1130,68 +1717,101 @@ __m128 _mm_shuffle_ps(__m128 a, __m128 b, const unsigned int imm8)
     return T;
 }
 
-// CMPPS
+// CMPPS CMPPD CMPSS CMPSD
 
 #undef _mm_cmp_ps
+#undef _mm_cmp_pd
+#undef _mm_cmp_ss
+#undef _mm_cmp_sd
 
-__forceinline
-__n128 _nn128_cmpord_ps(__n128 a, __n128 b)
-{
-    __n128 T1 = neon_fcmeqq32(a, a);
-    __n128 T2 = neon_fcmeqq32(b, b);
-    __n128 T3 = neon_andq(T1, T2);
+//
+// The predicates differ from the NEON compares only in NaN handling:
+// the ordered (O) forms are false and the unordered (U) forms are true
+// when either input is NaN.  FCMEQ/FCMGE/FCMGT are all false for NaN, so
+// the ordered forms map to them directly (NEQ_O is LT or GT) and the
+// unordered forms are their ordered complement, or OR in the UNORD mask.
+// Signalling (S) and quiet (Q) forms only differ in the exceptions raised.
+//
 
-    return T3;
+#define DEFINE_CMP_FP(suffix, bits) \
+\
+__forceinline \
+__n128 _nn128_cmpord_ ## suffix (__n128 a, __n128 b) \
+{ \
+    __n128 T1 = neon_fcmeqq ## bits (a, a); \
+    __n128 T2 = neon_fcmeqq ## bits (b, b); \
+    __n128 T3 = neon_andq(T1, T2); \
+\
+    return T3; \
+} \
+\
+__forceinline \
+__n128 _nn128_cmp_ ## suffix (__n128 a, __n128 b, const int imm8) \
+{ \
+    __n128 T; \
+\
+    switch (imm8 & 0x1F) \
+    { \
+        case _CMP_EQ_OQ: \
+        case _CMP_EQ_OS:     T = neon_fcmeqq ## bits (a, b); break; \
+        case _CMP_LT_OS: \
+        case _CMP_LT_OQ:     T = neon_fcmgtq ## bits (b, a); break;  /* LT is GT swapped */ \
+        case _CMP_LE_OS: \
+        case _CMP_LE_OQ:     T = neon_fcmgeq ## bits (b, a); break;  /* LE is GE swapped */ \
+        case _CMP_GE_OS: \
+        case _CMP_GE_OQ:     T = neon_fcmgeq ## bits (a, b); break; \
+        case _CMP_GT_OS: \
+        case _CMP_GT_OQ:     T = neon_fcmgtq ## bits (a, b); break; \
+        case _CMP_NEQ_OQ: \
+        case _CMP_NEQ_OS:    T = neon_orrq(neon_fcmgtq ## bits (a, b), neon_fcmgtq ## bits (b, a)); break; \
+        case _CMP_ORD_Q: \
+        case _CMP_ORD_S:     T = _nn128_cmpord_ ## suffix (a, b); break; \
+\
+        case _CMP_EQ_UQ: \
+        case _CMP_EQ_US:     T = neon_orrq(neon_fcmeqq ## bits (a, b), neon_notq(_nn128_cmpord_ ## suffix (a, b))); break; \
+        case _CMP_NLT_US: \
+        case _CMP_NLT_UQ:    T = neon_notq(neon_fcmgtq ## bits (b, a)); break; \
+        case _CMP_NLE_US: \
+        case _CMP_NLE_UQ:    T = neon_notq(neon_fcmgeq ## bits (b, a)); break; \
+        case _CMP_NGE_US: \
+        case _CMP_NGE_UQ:    T = neon_notq(neon_fcmgeq ## bits (a, b)); break; \
+        case _CMP_NGT_US: \
+        case _CMP_NGT_UQ:    T = neon_notq(neon_fcmgtq ## bits (a, b)); break; \
+        case _CMP_NEQ_UQ: \
+        case _CMP_NEQ_US:    T = neon_notq(neon_fcmeqq ## bits (a, b)); break; \
+        case _CMP_UNORD_Q: \
+        case _CMP_UNORD_S:   T = neon_notq(_nn128_cmpord_ ## suffix (a, b)); break; \
+\
+        case _CMP_FALSE_OQ: \
+        case _CMP_FALSE_OS:  T = neon_moviqw(0); break; \
+        case _CMP_TRUE_UQ: \
+        case _CMP_TRUE_US:   T = neon_mvniqw(0); break; \
+\
+        default: \
+            __assume(0); \
+            break; \
+    } \
+\
+    return T; \
 }
 
+DEFINE_CMP_FP(ps, 32)
+DEFINE_CMP_FP(pd, 64)
+
 __forceinline
-__n128 _nn128_cmp_ps(__n128 a, __n128 b, const int imm8)
+__n128 _nn128_cmp_ss(__n128 a, __n128 b, const int imm8)
 {
-    __n128 T;
+    __n128 T = _nn128_cmp_ps(a, b, imm8);
+    T = _nn_postprocess(T, a, b, _IF_SCALAR_INSERT_F32);
 
-    switch (imm8 & 0x1F)
-    {
-        case _CMP_EQ_OQ:     T = neon_fcmeqq32(a, b); break;
-        case _CMP_LT_OS:     T = neon_fcmgtq32(b, a); break;  // LT is GT swapped
-        case _CMP_LE_OS:     T = neon_fcmgeq32(b, a); break;  // LE is GE swapped
-        case _CMP_UNORD_Q:   T = neon_notq(_nn128_cmpord_ps(a, b)); break;
-        case _CMP_NEQ_UQ:    T = neon_notq(neon_fcmeqq32(a, b)); break;
-        case _CMP_NLT_US:    T = neon_notq(neon_fcmgtq32(b, a)); break;
-        case _CMP_NLE_US:    T = neon_notq(neon_fcmgeq32(b, a)); break;
-        case _CMP_ORD_Q:     T = _nn128_cmpord_ps(a, b); break;
-
-        case _CMP_EQ_UQ:     T = neon_fcmeqq32(a, b); break;
-        case _CMP_NGE_US:    T = neon_notq(neon_fcmgeq32(a, b)); break;
-        case _CMP_NGT_US:    T = neon_notq(neon_fcmgtq32(a, b)); break;
-        case _CMP_FALSE_OQ:  T = neon_moviqw(0); break;
-        case _CMP_NEQ_OQ:    T = neon_notq(neon_fcmeqq32(b, a)); break;
-        case _CMP_GE_OS:     T = neon_fcmgeq32(a, b); break;
-        case _CMP_GT_OS:     T = neon_fcmgtq32(a, b); break;
-        case _CMP_TRUE_UQ:   T = neon_mvniqw(0); break;
-
-        case _CMP_EQ_OS:     T = neon_fcmeqq32(a, b); break;
-        case _CMP_LT_OQ:     T = neon_fcmgtq32(b, a); break;
-        case _CMP_LE_OQ:     T = neon_fcmgeq32(b, a); break;
-        case _CMP_UNORD_S:   T = neon_notq(_nn128_cmpord_ps(a, b)); break;
-        case _CMP_NEQ_US:    T = neon_notq(neon_fcmeqq32(a, b)); break;
-        case _CMP_NLT_UQ:    T = neon_notq(neon_fcmgtq32(b, a)); break;
-        case _CMP_NLE_UQ:    T = neon_notq(neon_fcmgeq32(b, a)); break;
-        case _CMP_ORD_S:     T = _nn128_cmpord_ps(a, b); break;
-
-        case _CMP_EQ_US:     T = neon_fcmeqq32(a, b); break;
-        case _CMP_NGE_UQ:    T = neon_notq(neon_fcmgeq32(a, b)); break;
-        case _CMP_NGT_UQ:    T = neon_notq(neon_fcmgtq32(a, b)); break;
-        case _CMP_FALSE_OS:  T = neon_moviqw(0); break;
-        case _CMP_NEQ_OS:    T = neon_notq(neon_fcmeqq32(b, a)); break;
-        case _CMP_GE_OQ:     T = neon_fcmgeq32(a, b); break;
-        case _CMP_GT_OQ:     T = neon_fcmgtq32(a, b); break;
-        case _CMP_TRUE_US:   T = neon_mvniqw(0); break;
-            break;
+    return T;
+}
 
-        default:
-            __assume(0);
-            break;
-    }
+__forceinline
+__n128 _nn128_cmp_sd(__n128 a, __n128 b, const int imm8)
+{
+    __n128 T = _nn128_cmp_pd(a, b, imm8);
+    T = _nn_postprocess(T, a, b, _IF_SCALAR_INSERT_F64);
 
     return T;
 }
@@ -1204,6 +1824,151 @@ __m128 _mm_cmp_ps(__m128 a, __m128 b, const int imm8)
     return T;
 }
 
+__forceinline
+__m128d _mm_cmp_pd(__m128d a, __m128d b, const int imm8)
+{
+    __m128d T = _nn128_castn128_pd( _nn128_cmp_pd(_nn128_castpd_n128(a), _nn128_castpd_n128(b), imm8 & 0x1F) );
+
+    return T;
+}
+
+__forceinline
+__m128 _mm_cmp_ss(__m128 a, __m128 b, const int imm8)
+{
+    __m128 T = _nn128_castn128_ps( _nn128_cmp_ss(_nn128_castps_n128(a), _nn128_castps_n128(b), imm8 & 0x1F) );
+
+    return T;
+}
+
+__forceinline
+__m128d _mm_cmp_sd(__m128d a, __m128d b, const int imm8)
+{
+    __m128d T = _nn128_castn128_pd( _nn128_cmp_sd(_nn128_castpd_n128(a), _nn128_castpd_n128(b), imm8 & 0x1F) );
+
+    return T;
+}
+
+// legacy SSE/SSE2 compares, which are fixed predicates of the above
+// (note CMPGT and CMPGE are the LT and LE encodings with swapped operands)
+
+#undef _mm_cmpeq_ps
+#undef _mm_cmplt_ps
+#undef _mm_cmple_ps
+#undef _mm_cmpgt_ps
+#undef _mm_cmpge_ps
+#undef _mm_cmpneq_ps
+#undef _mm_cmpnlt_ps
+#undef _mm_cmpnle_ps
+#undef _mm_cmpngt_ps
+#undef _mm_cmpnge_ps
+#undef _mm_cmpord_ps
+#undef _mm_cmpunord_ps
+#undef _mm_cmpeq_ss
+#undef _mm_cmplt_ss
+#undef _mm_cmple_ss
+#undef _mm_cmpgt_ss
+#undef _mm_cmpge_ss
+#undef _mm_cmpneq_ss
+#undef _mm_cmpnlt_ss
+#undef _mm_cmpnle_ss
+#undef _mm_cmpngt_ss
+#undef _mm_cmpnge_ss
+#undef _mm_cmpord_ss
+#undef _mm_cmpunord_ss
+#undef _mm_cmpeq_pd
+#undef _mm_cmplt_pd
+#undef _mm_cmple_pd
+#undef _mm_cmpgt_pd
+#undef _mm_cmpge_pd
+#undef _mm_cmpneq_pd
+#undef _mm_cmpnlt_pd
+#undef _mm_cmpnle_pd
+#undef _mm_cmpngt_pd
+#undef _mm_cmpnge_pd
+#undef _mm_cmpord_pd
+#undef _mm_cmpunord_pd
+#undef _mm_cmpeq_sd
+#undef _mm_cmplt_sd
+#undef _mm_cmple_sd
+#undef _mm_cmpgt_sd
+#undef _mm_cmpge_sd
+#undef _mm_cmpneq_sd
+#undef _mm_cmpnlt_sd
+#undef _mm_cmpnle_sd
+#undef _mm_cmpngt_sd
+#undef _mm_cmpnge_sd
+#undef _mm_cmpord_sd
+#undef _mm_cmpunord_sd
+
+#define DEFINE_SW_CMP(name, pred) \
+__forceinline __n128 sw_ ## name ## _ps(__n128 a, __n128 b) { __n128 T = _nn128_cmp_ps(a, b, pred); return T; } \
+__forceinline __n128 sw_ ## name ## _pd(__n128 a, __n128 b) { __n128 T = _nn128_cmp_pd(a, b, pred); return T; }
+
+DEFINE_SW_CMP(cmpeq,    _CMP_EQ_OQ)
+DEFINE_SW_CMP(cmplt,    _CMP_LT_OS)
+DEFINE_SW_CMP(cmple,    _CMP_LE_OS)
+DEFINE_SW_CMP(cmpgt,    _CMP_GT_OS)
+DEFINE_SW_CMP(cmpge,    _CMP_GE_OS)
+DEFINE_SW_CMP(cmpneq,   _CMP_NEQ_UQ)
+DEFINE_SW_CMP(cmpnlt,   _CMP_NLT_US)
+DEFINE_SW_CMP(cmpnle,   _CMP_NLE_US)
+DEFINE_SW_CMP(cmpngt,   _CMP_NGT_US)
+DEFINE_SW_CMP(cmpnge,   _CMP_NGE_US)
+DEFINE_SW_CMP(cmpord,   _CMP_ORD_Q)
+DEFINE_SW_CMP(cmpunord, _CMP_UNORD_Q)
+
+DEFINE_N128_OP_N128_N128(__m128,  cmpeq_ps,     sw_cmpeq_ps,    __m128,  a, __m128,  b, 0)
+DEFINE_N128_OP_N128_N128(__m128,  cmplt_ps,     sw_cmplt_ps,    __m128,  a, __m128,  b, 0)
+DEFINE_N128_OP_N128_N128(__m128,  cmple_ps,     sw_cmple_ps,    __m128,  a, __m128,  b, 0)
+DEFINE_N128_OP_N128_N128(__m128,  cmpgt_ps,     sw_cmpgt_ps,    __m128,  a, __m128,  b, 0)
+DEFINE_N128_OP_N128_N128(__m128,  cmpge_ps,     sw_cmpge_ps,    __m128,  a, __m128,  b, 0)
+DEFINE_N128_OP_N128_N128(__m128,  cmpneq_ps,    sw_cmpneq_ps,   __m128,  a, __m128,  b, 0)
+DEFINE_N128_OP_N128_N128(__m128,  cmpnlt_ps,    sw_cmpnlt_ps,   __m128,  a, __m128,  b, 0)
+DEFINE_N128_OP_N128_N128(__m128,  cmpnle_ps,    sw_cmpnle_ps,   __m128,  a, __m128,  b, 0)
+DEFINE_N128_OP_N128_N128(__m128,  cmpngt_ps,    sw_cmpngt_ps,   __m128,  a, __m128,  b, 0)
+DEFINE_N128_OP_N128_N128(__m128,  cmpnge_ps,    sw_cmpnge_ps,   __m128,  a, __m128,  b, 0)
+DEFINE_N128_OP_N128_N128(__m128,  cmpord_ps,    sw_cmpord_ps,   __m128,  a, __m128,  b, 0)
+DEFINE_N128_OP_N128_N128(__m128,  cmpunord_ps,  sw_cmpunord_ps, __m128,  a, __m128,  b, 0)
+
+DEFINE_N128_OP_N128_N128(__m128,  cmpeq_ss,     sw_cmpeq_ps,    __m128,  a, __m128,  b, _IF_SCALAR_INSERT_F32)
+DEFINE_N128_OP_N128_N128(__m128,  cmplt_ss,     sw_cmplt_ps,    __m128,  a, __m128,  b, _IF_SCALAR_INSERT_F32)
+DEFINE_N128_OP_N128_N128(__m128,  cmple_ss,     sw_cmple_ps,    __m128,  a, __m128,  b, _IF_SCALAR_INSERT_F32)
+DEFINE_N128_OP_N128_N128(__m128,  cmpgt_ss,     sw_cmpgt_ps,    __m128,  a, __m128,  b, _IF_SCALAR_INSERT_F32)
+DEFINE_N128_OP_N128_N128(__m128,  cmpge_ss,     sw_cmpge_ps,    __m128,  a, __m128,  b, _IF_SCALAR_INSERT_F32)
+DEFINE_N128_OP_N128_N128(__m128,  cmpneq_ss,    sw_cmpneq_ps,   __m128,  a, __m128,  b, _IF_SCALAR_INSERT_F32)
+DEFINE_N128_OP_N128_N128(__m128,  cmpnlt_ss,    sw_cmpnlt_ps,   __m128,  a, __m128,  b, _IF_SCALAR_INSERT_F32)
+DEFINE_N128_OP_N128_N128(__m128,  cmpnle_ss,    sw_cmpnle_ps,   __m128,  a, __m128,  b, _IF_SCALAR_INSERT_F32)
+DEFINE_N128_OP_N128_N128(__m128,  cmpngt_ss,    sw_cmpngt_ps,   __m128,  a, __m128,  b, _IF_SCALAR_INSERT_F32)
+DEFINE_N128_OP_N128_N128(__m128,  cmpnge_ss,    sw_cmpnge_ps,   __m128,  a, __m128,  b, _IF_SCALAR_INSERT_F32)
+DEFINE_N128_OP_N128_N128(__m128,  cmpord_ss,    sw_cmpord_ps,   __m128,  a, __m128,  b, _IF_SCALAR_INSERT_F32)
+DEFINE_N128_OP_N128_N128(__m128,  cmpunord_ss,  sw_cmpunord_ps, __m128,  a, __m128,  b, _IF_SCALAR_INSERT_F32)
+
+DEFINE_N128_OP_N128_N128(__m128d, cmpeq_pd,     sw_cmpeq_pd,    __m128d, a, __m128d, b, 0)
+DEFINE_N128_OP_N128_N128(__m128d, cmplt_pd,     sw_cmplt_pd,    __m128d, a, __m128d, b, 0)
+DEFINE_N128_OP_N128_N128(__m128d, cmple_pd,     sw_cmple_pd,    __m128d, a, __m128d, b, 0)
+DEFINE_N128_OP_N128_N128(__m128d, cmpgt_pd,     sw_cmpgt_pd,    __m128d, a, __m128d, b, 0)
+DEFINE_N128_OP_N128_N128(__m128d, cmpge_pd,     sw_cmpge_pd,    __m128d, a, __m128d, b, 0)
+DEFINE_N128_OP_N128_N128(__m128d, cmpneq_pd,    sw_cmpneq_pd,   __m128d, a, __m128d, b, 0)
+DEFINE_N128_OP_N128_N128(__m128d, cmpnlt_pd,    sw_cmpnlt_pd,   __m128d, a, __m128d, b, 0)
+DEFINE_N128_OP_N128_N128(__m128d, cmpnle_pd,    sw_cmpnle_pd,   __m128d, a, __m128d, b, 0)
+DEFINE_N128_OP_N128_N128(__m128d, cmpngt_pd,    sw_cmpngt_pd,   __m128d, a, __m128d, b, 0)
+DEFINE_N128_OP_N128_N128(__m128d, cmpnge_pd,    sw_cmpnge_pd,   __m128d, a, __m128d, b, 0)
+DEFINE_N128_OP_N128_N128(__m128d, cmpord_pd,    sw_cmpord_pd,   __m128d, a, __m128d, b, 0)
+DEFINE_N128_OP_N128_N128(__m128d, cmpunord_pd,  sw_cmpunord_pd, __m128d, a, __m128d, b, 0)
+
+DEFINE_N128_OP_N128_N128(__m128d, cmpeq_sd,     sw_cmpeq_pd,    __m128d, a, __m128d, b, _IF_SCALAR_INSERT_F64)
+DEFINE_N128_OP_N128_N128(__m128d, cmplt_sd,     sw_cmplt_pd,    __m128d, a, __m128d, b, _IF_SCALAR_INSERT_F64)
+DEFINE_N128_OP_N128_N128(__m128d, cmple_sd,     sw_cmple_pd,    __m128d, a, __m128d, b, _IF_SCALAR_INSERT_F64)
+DEFINE_N128_OP_N128_N128(__m128d, cmpgt_sd,     sw_cmpgt_pd,    __m128d, a, __m128d, b, _IF_SCALAR_INSERT_F64)
+DEFINE_N128_OP_N128_N128(__m128d, cmpge_sd,     sw_cmpge_pd,    __m128d, a, __m128d, b, _IF_SCALAR_INSERT_F64)
+DEFINE_N128_OP_N128_N128(__m128d, cmpneq_sd,    sw_cmpneq_pd,   __m128d, a, __m128d, b, _IF_SCALAR_INSERT_F64)
+DEFINE_N128_OP_N128_N128(__m128d, cmpnlt_sd,    sw_cmpnlt_pd,   __m128d, a, __m128d, b, _IF_SCALAR_INSERT_F64)
+DEFINE_N128_OP_N128_N128(__m128d, cmpnle_sd,    sw_cmpnle_pd,   __m128d, a, __m128d, b, _IF_SCALAR_INSERT_F64)
+DEFINE_N128_OP_N128_N128(__m128d, cmpngt_sd,    sw_cmpngt_pd,   __m128d, a, __m128d, b, _IF_SCALAR_INSERT_F64)
+DEFINE_N128_OP_N128_N128(__m128d, cmpnge_sd,    sw_cmpnge_pd,   __m128d, a, __m128d, b, _IF_SCALAR_INSERT_F64)
+DEFINE_N128_OP_N128_N128(__m128d, cmpord_sd,    sw_cmpord_pd,   __m128d, a, __m128d, b, _IF_SCALAR_INSERT_F64)
+DEFINE_N128_OP_N128_N128(__m128d, cmpunord_sd,  sw_cmpunord_pd, __m128d, a, __m128d, b, _IF_SCALAR_INSERT_F64)
+
 // PBLENDVB
 
 #undef _mm_blendv_epi8
@@ -1241,59 +2006,480 @@ __n128 sw_blendv_ps(__n128 a, __n128 b, __n128 mask)
 
 DEFINE_N128_OP_N128_N128_N128(__m128,  blendv_ps,    sw_blendv_ps,   __m128,  a, __m128,  b, __m128,  c,    0)
 
+// PCMPEQ PCMPGT
+
+#undef _mm_cmpeq_epi8
+#undef _mm_cmpeq_epi16
+#undef _mm_cmpeq_epi32
+#undef _mm_cmpeq_epi64
+#undef _mm_cmpgt_epi8
+#undef _mm_cmpgt_epi16
+#undef _mm_cmpgt_epi32
+#undef _mm_cmpgt_epi64
+#undef _mm_cmplt_epi8
+#undef _mm_cmplt_epi16
+#undef _mm_cmplt_epi32
+
+DEFINE_N128_OP_N128_N128(__m128i, cmpeq_epi8,   vceqq_u8,       __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, cmpeq_epi16,  vceqq_u16,      __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, cmpeq_epi32,  vceqq_u32,      __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, cmpeq_epi64,  vceqq_u64,      __m128i, a, __m128i, b, 0)
+
+DEFINE_N128_OP_N128_N128(__m128i, cmpgt_epi8,   vcgtq_s8,       __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, cmpgt_epi16,  vcgtq_s16,      __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, cmpgt_epi32,  vcgtq_s32,      __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, cmpgt_epi64,  vcgtq_s64,      __m128i, a, __m128i, b, 0)
+
+DEFINE_N128_OP_N128_N128(__m128i, cmplt_epi8,   vcltq_s8,       __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, cmplt_epi16,  vcltq_s16,      __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, cmplt_epi32,  vcltq_s32,      __m128i, a, __m128i, b, 0)
+
 // MOVEMSK
+//
+// Gather sign bits without a scalar loop: arithmetic shift each element to all
+// zeroes or all ones, AND with its bit weight, then sum the weights with ADDP/ADDV.
 
 #undef _mm_movemask_epi8
 #undef _mm_movemask_pd
 #undef _mm_movemask_ps
 
 __forceinline
-int _mm_movemask_epi8(const __m128i a)
+__n128 sw_movemask_weights_epi8(__n128 a)
 {
-    int mask = 0;
-
-    for (unsigned i = 0; i < 16; i++)
-        mask |= (a.m128i_u8[i] >> 7) << i;
+    const __n128 Weights = neon_dupqr64(0x8040201008040201ull);
 
-    return mask;
+    return neon_andq(neon_sshriq8(a, 7), Weights);
 }
 
-
 __forceinline
-int _mm_movemask_pd(const __m128d a)
+int _nn_movemask_epi8(__n128i a)
 {
-    __m128i T = _mm_castpd_si128(a);
-
-    int mask = 0;
+    __n128 T = sw_movemask_weights_epi8(a);
 
-    mask |= (T.m128i_u64[1] >> 63) << 1;
-    mask |= (T.m128i_u64[0] >> 63) << 0;
+    T = vpaddq_u8(T, T);     // 16 weighted bytes -> 8 -> 4 -> 2 mask bytes
+    T = vpaddq_u8(T, T);
+    T = vpaddq_u8(T, T);
 
-    return mask;
+    return vgetq_lane_u16(T, 0);
 }
 
+__forceinline
+int _nn_movemask_pd(__n128d a)
+{
+    const __n128 Weights = vcombine_u64(vcreate_u64(1), vcreate_u64(2));
+
+    return (int)vaddvq_u64(neon_andq(neon_sshriq64(a, 63), Weights));
+}
 
 __forceinline
-int _mm_movemask_ps(const __m128 a)
+int _nn_movemask_ps(__n128 a)
 {
-    __m128i T = _mm_castps_si128(a);
+    const __n128 Weights = vcombine_u32(vcreate_u32(0x0000000200000001ull), vcreate_u32(0x0000000800000004ull));
+
+    return (int)vaddvq_u32(neon_andq(neon_sshriq32(a, 31), Weights));
+}
 
-    int mask = 0;
+__forceinline
+int _mm_movemask_epi8(const __m128i a)
+{
+    return _nn_movemask_epi8(_nn128_castsi128_n128(a));
+}
 
-    mask |= (T.m128i_u32[3] >> 31) << 3;
-    mask |= (T.m128i_u32[2] >> 31) << 2;
-    mask |= (T.m128i_u32[1] >> 31) << 1;
-    mask |= (T.m128i_u32[0] >> 31) << 0;
+__forceinline
+int _mm_movemask_pd(const __m128d a)
+{
+    return _nn_movemask_pd(_nn128_castpd_n128(a));
+}
 
-    return mask;
+__forceinline
+int _mm_movemask_ps(const __m128 a)
+{
+    return _nn_movemask_ps(_nn128_castps_n128(a));
 }
 
 
+// PTEST
+//
+// The ZF and CF results are reduced to a scalar entirely in vector registers
+// with UMAXV, so that the result can feed a branch directly.
+
+#undef _mm_testz_si128
+#undef _mm_testc_si128
+#undef _mm_testnzc_si128
+#undef _mm_test_all_zeros
+#undef _mm_test_all_ones
+#undef _mm_test_mix_ones_zeros
+
+__forceinline
+int sw_test_zero_n128(__n128 a)
+{
+    return vmaxvq_u32(a) == 0;
+}
+
+__forceinline
+int _nn_testz_si128(__n128i a, __n128i b)
+{
+    return sw_test_zero_n128(neon_andq(a, b));          // ZF = (a & b) == 0
+}
+
+__forceinline
+int _nn_testc_si128(__n128i a, __n128i b)
+{
+    return sw_test_zero_n128(neon_bicq(b, a));          // CF = (~a & b) == 0
+}
+
+__forceinline
+int _nn_testnzc_si128(__n128i a, __n128i b)
+{
+    return !_nn_testz_si128(a, b) && !_nn_testc_si128(a, b);
+}
+
+__forceinline
+int _mm_testz_si128(__m128i a, __m128i b)
+{
+    return _nn_testz_si128(_nn128_castsi128_n128(a), _nn128_castsi128_n128(b));
+}
+
+__forceinline
+int _mm_testc_si128(__m128i a, __m128i b)
+{
+    return _nn_testc_si128(_nn128_castsi128_n128(a), _nn128_castsi128_n128(b));
+}
+
+__forceinline
+int _mm_testnzc_si128(__m128i a, __m128i b)
+{
+    return _nn_testnzc_si128(_nn128_castsi128_n128(a), _nn128_castsi128_n128(b));
+}
+
+#define _mm_test_all_zeros(mask, a)     _mm_testz_si128((mask), (a))
+#define _mm_test_all_ones(a)            _mm_testc_si128((a), _mm_cmpeq_epi32((a), (a)))
+#define _mm_test_mix_ones_zeros(mask, a) _mm_testnzc_si128((mask), (a))
+
+// PCMPISTRI PCMPISTRM PCMPESTRI PCMPESTRM (SSE4.2)
+//
+// The comparison engine is picked by a switch on imm8, which is a constant at
+// every call site, so only one aggregation mode and one element size is inlined:
+//
+//   EQUAL_ANY       OR of CMEQ of b against each valid element of a (broadcast with TBL)
+//   RANGES          OR of b >= a[2k] AND b <= a[2k+1] (CMHS or CMGE) over each valid pair
+//   EQUAL_EACH      CMEQ of a and b, with lanes past both lengths true
+//   EQUAL_ORDERED   AND of CMEQ of a[i] against b shifted down i elements with TBL
+//
+// The loops run only over the valid elements of a, so a short set of characters
+// or a short substring costs only a few instructions per element.  String lengths
+// come from the first zero element found with CMEQ and SHRN, which leaves 4 bits
+// per byte (8 bits per word) in a scalar, the same step that yields the index.
+//
+
+#undef _mm_cmpistri
+#undef _mm_cmpistrm
+#undef _mm_cmpistra
+#undef _mm_cmpistrc
+#undef _mm_cmpistro
+#undef _mm_cmpistrs
+#undef _mm_cmpistrz
+#undef _mm_cmpestri
+#undef _mm_cmpestrm
+#undef _mm_cmpestra
+#undef _mm_cmpestrc
+#undef _mm_cmpestro
+#undef _mm_cmpestrs
+#undef _mm_cmpestrz
+
+#if !defined(_SIDD_UBYTE_OPS)
+#define _SIDD_UBYTE_OPS                 0x00
+#define _SIDD_UWORD_OPS                 0x01
+#define _SIDD_SBYTE_OPS                 0x02
+#define _SIDD_SWORD_OPS                 0x03
+#define _SIDD_CMP_EQUAL_ANY             0x00
+#define _SIDD_CMP_RANGES                0x04
+#define _SIDD_CMP_EQUAL_EACH            0x08
+#define _SIDD_CMP_EQUAL_ORDERED         0x0C
+#define _SIDD_POSITIVE_POLARITY         0x00
+#define _SIDD_NEGATIVE_POLARITY         0x10
+#define _SIDD_MASKED_POSITIVE_POLARITY  0x20
+#define _SIDD_MASKED_NEGATIVE_POLARITY  0x30
+#define _SIDD_LEAST_SIGNIFICANT         0x00
+#define _SIDD_MOST_SIGNIFICANT          0x40
+#define _SIDD_BIT_MASK                  0x00
+#define _SIDD_UNIT_MASK                 0x40
+#endif
+
+#define SW_PCMPSTR_ELEMENTS(imm8)   (((imm8) & 1) ? 8 : 16)
+#define SW_PCMPSTR_SHIFT(imm8)      (((imm8) & 1) ? 3 : 2)
+
+// mask of the elements below len, len may be negative
+
+__forceinline
+__n128 sw_pcmpstr_valid(int len, const int imm8)
+{
+    const __n128 Iota8  = vcombine_u64(vcreate_u64(0x0706050403020100ull), vcreate_u64(0x0F0E0D0C0B0A0908ull));
+    const __n128 Iota16 = vcombine_u64(vcreate_u64(0x0003000200010000ull), vcreate_u64(0x0007000600050004ull));
+
+    if (imm8 & 1)
+    {
+        return vcgtq_s16(vdupq_n_s16((__int16)len), Iota16);
+    }
+
+    return vcgtq_s8(vdupq_n_s8((__int8)len), Iota8);
+}
+
+// SHRN by 4 packs a byte (word) lane mask into 4 (8) bits per element
+
+__forceinline
+unsigned __int64 sw_pcmpstr_nibbles(__n128 a)
+{
+    return vget_lane_u64(vshrn_n_u16(a, 4), 0);
+}
+
+__forceinline
+int sw_pcmpstr_implicit_length(__n128 a, const int imm8)
+{
+    __n128 Z = (imm8 & 1) ? vceqq_u16(a, vdupq_n_u16(0)) : vceqq_u8(a, vdupq_n_u8(0));
+
+    return (int)(_CountTrailingZeros64(sw_pcmpstr_nibbles(Z)) >> SW_PCMPSTR_SHIFT(imm8));
+}
+
+__forceinline
+int sw_pcmpstr_explicit_length(int len, const int imm8)
+{
+    const unsigned n = SW_PCMPSTR_ELEMENTS(imm8);
+    const unsigned u = (len < 0) ? (0u - (unsigned)len) : (unsigned)len;
+
+    return (int)((u < n) ? u : n);
+}
+
+__forceinline
+__n128 sw_pcmpstr_broadcast(__n128 a, int i, const int imm8)
+{
+    if (imm8 & 1)
+    {
+        return vqtbl1q_u8(a, vdupq_n_u16((unsigned __int16)(0x0100 + 0x0202 * i)));
+    }
+
+    return vqtbl1q_u8(a, vdupq_n_u8((unsigned __int8)i));
+}
+
+__forceinline
+__n128 sw_pcmpstr_cmpeq(__n128 a, __n128 b, const int imm8)
+{
+    return (imm8 & 1) ? vceqq_u16(a, b) : vceqq_u8(a, b);
+}
+
+__forceinline
+__n128 sw_pcmpstr_in_range(__n128 b, __n128 lo, __n128 hi, const int imm8)
+{
+    switch (imm8 & 3)
+    {
+    case _SIDD_UBYTE_OPS: return neon_andq(vcgeq_u8 (b, lo), vcleq_u8 (b, hi));
+    case _SIDD_UWORD_OPS: return neon_andq(vcgeq_u16(b, lo), vcleq_u16(b, hi));
+    case _SIDD_SBYTE_OPS: return neon_andq(vcgeq_s8 (b, lo), vcleq_s8 (b, hi));
+    default:              return neon_andq(vcgeq_s16(b, lo), vcleq_s16(b, hi));
+    }
+}
+
+__forceinline
+__n128 sw_pcmpstr_equal_any(__n128 a, int la, __n128 b, int lb, const int imm8)
+{
+    __n128 R = neon_moviqw(0);
+
+    for (int i = 0; i < la; i++)
+    {
+        R = neon_orrq(R, sw_pcmpstr_cmpeq(b, sw_pcmpstr_broadcast(a, i, imm8), imm8));
+    }
+
+    return neon_andq(R, sw_pcmpstr_valid(lb, imm8));
+}
+
+__forceinline
+__n128 sw_pcmpstr_ranges(__n128 a, int la, __n128 b, int lb, const int imm8)
+{
+    __n128 R = neon_moviqw(0);
+
+    // an odd last element of a has no upper bound and matches nothing
+
+    for (int i = 0; i + 1 < la; i += 2)
+    {
+        R = neon_orrq(R, sw_pcmpstr_in_range(b, sw_pcmpstr_broadcast(a, i, imm8), sw_pcmpstr_broadcast(a, i + 1, imm8), imm8));
+    }
+
+    return neon_andq(R, sw_pcmpstr_valid(lb, imm8));
+}
+
+__forceinline
+__n128 sw_pcmpstr_equal_each(__n128 a, int la, __n128 b, int lb, const int imm8)
+{
+    const __n128 ValidA = sw_pcmpstr_valid(la, imm8);
+    const __n128 ValidB = sw_pcmpstr_valid(lb, imm8);
+
+    // equal where both are valid, true where both are past the end, false otherwise
+
+    __n128 R = neon_andq(sw_pcmpstr_cmpeq(a, b, imm8), neon_andq(ValidA, ValidB));
+
+    return neon_orrq(R, neon_notq(neon_orrq(ValidA, ValidB)));
+}
+
+__forceinline
+__n128 sw_pcmpstr_equal_ordered(__n128 a, int la, __n128 b, int lb, const int imm8)
+{
+    const __n128 Iota8 = vcombine_u64(vcreate_u64(0x0706050403020100ull), vcreate_u64(0x0F0E0D0C0B0A0908ull));
+    const int n = SW_PCMPSTR_ELEMENTS(imm8);
+
+    __n128 R = neon_mvniqw(0);
+
+    for (int i = 0; i < la; i++)
+    {
+        // lane j compares a[i] with b[j + i], which is false past the end of b, except
+        // that lanes j >= n - i have no b[j + i] at all and are left true
+
+        __n128 Index = vaddq_u8(Iota8, vdupq_n_u8((unsigned __int8)(i << (imm8 & 1))));
+        __n128 T = sw_pcmpstr_cmpeq(vqtbl1q_u8(b, Index), sw_pcmpstr_broadcast(a, i, imm8), imm8);
+
+        T = neon_andq(T, sw_pcmpstr_valid(lb - i, imm8));
+        T = neon_orrq(T, neon_notq(sw_pcmpstr_valid(n - i, imm8)));
+
+        R = neon_andq(R, T);
+    }
+
+    return R;
+}
+
+// IntRes2 as a lane mask
+
+__forceinline
+__n128 sw_pcmpstr(__n128 a, int la, __n128 b, int lb, const int imm8)
+{
+    __n128 R;
+
+    switch (imm8 & 0x0C)
+    {
+    case _SIDD_CMP_EQUAL_ANY:   R = sw_pcmpstr_equal_any(a, la, b, lb, imm8); break;
+    case _SIDD_CMP_RANGES:      R = sw_pcmpstr_ranges(a, la, b, lb, imm8); break;
+    case _SIDD_CMP_EQUAL_EACH:  R = sw_pcmpstr_equal_each(a, la, b, lb, imm8); break;
+    default:                    R = sw_pcmpstr_equal_ordered(a, la, b, lb, imm8); break;
+    }
+
+    switch (imm8 & 0x30)
+    {
+    case _SIDD_NEGATIVE_POLARITY:        R = neon_notq(R); break;
+    case _SIDD_MASKED_NEGATIVE_POLARITY: R = neon_eorq(R, sw_pcmpstr_valid(lb, imm8)); break;
+    default:                             break;
+    }
+
+    return R;
+}
+
+__forceinline
+int sw_pcmpstr_index(__n128 R, const int imm8)
+{
+    const unsigned __int64 m = sw_pcmpstr_nibbles(R);
+
+    if (imm8 & _SIDD_MOST_SIGNIFICANT)
+    {
+        return (m == 0) ? SW_PCMPSTR_ELEMENTS(imm8) : (int)((63 - _CountLeadingZeros64(m)) >> SW_PCMPSTR_SHIFT(imm8));
+    }
+
+    return (int)(_CountTrailingZeros64(m) >> SW_PCMPSTR_SHIFT(imm8));
+}
+
+__forceinline
+__n128 sw_pcmpstr_mask(__n128 R, const int imm8)
+{
+    if (imm8 & _SIDD_UNIT_MASK)
+    {
+        return R;
+    }
+
+    if (imm8 & 1)
+    {
+        R = vcombine_u8(vmovn_u16(R), vcreate_u8(0));
+    }
+
+    return vcombine_u64(vcreate_u64((unsigned)_nn_movemask_epi8(R)), vcreate_u64(0));
+}
+
+// Template for the implicit length (PCMPISTRx) forms, la and lb are only computed if used
+
+#define DEFINE_PCMPISTR(rettype, name, result) \
+__forceinline rettype _nn_cmpistr ## name(__n128 a, __n128 b, const int imm8) { \
+    const int n  = SW_PCMPSTR_ELEMENTS(imm8); \
+    const int la = sw_pcmpstr_implicit_length(a, imm8); \
+    const int lb = sw_pcmpstr_implicit_length(b, imm8); \
+    (void)n; (void)la; (void)lb; \
+    return (result); }
+
+// Template for the explicit length (PCMPESTRx) forms
+
+#define DEFINE_PCMPESTR(rettype, name, result) \
+__forceinline rettype _nn_cmpestr ## name(__n128 a, int la, __n128 b, int lb, const int imm8) { \
+    const int n = SW_PCMPSTR_ELEMENTS(imm8); \
+    la = sw_pcmpstr_explicit_length(la, imm8); \
+    lb = sw_pcmpstr_explicit_length(lb, imm8); \
+    (void)n; \
+    return (result); }
+
+#define SW_PCMPSTR_RESULT   sw_pcmpstr(a, la, b, lb, imm8)
+
+DEFINE_PCMPISTR(int,    i, sw_pcmpstr_index(SW_PCMPSTR_RESULT, imm8))
+DEFINE_PCMPISTR(__n128, m, sw_pcmpstr_mask(SW_PCMPSTR_RESULT, imm8))
+DEFINE_PCMPISTR(int,    a, (sw_pcmpstr_nibbles(SW_PCMPSTR_RESULT) == 0) && (lb >= n))
+DEFINE_PCMPISTR(int,    c, sw_pcmpstr_nibbles(SW_PCMPSTR_RESULT) != 0)
+DEFINE_PCMPISTR(int,    o, vgetq_lane_u8(SW_PCMPSTR_RESULT, 0) & 1)
+DEFINE_PCMPISTR(int,    s, la < n)
+DEFINE_PCMPISTR(int,    z, lb < n)
+
+DEFINE_PCMPESTR(int,    i, sw_pcmpstr_index(SW_PCMPSTR_RESULT, imm8))
+DEFINE_PCMPESTR(__n128, m, sw_pcmpstr_mask(SW_PCMPSTR_RESULT, imm8))
+DEFINE_PCMPESTR(int,    a, (sw_pcmpstr_nibbles(SW_PCMPSTR_RESULT) == 0) && (lb >= n))
+DEFINE_PCMPESTR(int,    c, sw_pcmpstr_nibbles(SW_PCMPSTR_RESULT) != 0)
+DEFINE_PCMPESTR(int,    o, vgetq_lane_u8(SW_PCMPSTR_RESULT, 0) & 1)
+DEFINE_PCMPESTR(int,    s, la < n)
+DEFINE_PCMPESTR(int,    z, lb < n)
+
+__forceinline
+int _mm_cmpistri(__m128i a, __m128i b, const int imm8)
+{
+    return _nn_cmpistri(_nn128_castsi128_n128(a), _nn128_castsi128_n128(b), imm8);
+}
+
+__forceinline
+__m128i _mm_cmpistrm(__m128i a, __m128i b, const int imm8)
+{
+    return _nn128_castn128_si128( _nn_cmpistrm(_nn128_castsi128_n128(a), _nn128_castsi128_n128(b), imm8) );
+}
+
+__forceinline
+int _mm_cmpestri(__m128i a, int la, __m128i b, int lb, const int imm8)
+{
+    return _nn_cmpestri(_nn128_castsi128_n128(a), la, _nn128_castsi128_n128(b), lb, imm8);
+}
+
+__forceinline
+__m128i _mm_cmpestrm(__m128i a, int la, __m128i b, int lb, const int imm8)
+{
+    return _nn128_castn128_si128( _nn_cmpestrm(_nn128_castsi128_n128(a), la, _nn128_castsi128_n128(b), lb, imm8) );
+}
+
+// Template for the flag forms
+
+#define DEFINE_PCMPSTR_FLAG(flag) \
+__forceinline int _mm_cmpistr ## flag(__m128i a, __m128i b, const int imm8) { \
+    return _nn_cmpistr ## flag(_nn128_castsi128_n128(a), _nn128_castsi128_n128(b), imm8); } \
+__forceinline int _mm_cmpestr ## flag(__m128i a, int la, __m128i b, int lb, const int imm8) { \
+    return _nn_cmpestr ## flag(_nn128_castsi128_n128(a), la, _nn128_castsi128_n128(b), lb, imm8); }
+
+DEFINE_PCMPSTR_FLAG(a)
+DEFINE_PCMPSTR_FLAG(c)
+DEFINE_PCMPSTR_FLAG(o)
+DEFINE_PCMPSTR_FLAG(s)
+DEFINE_PCMPSTR_FLAG(z)
+
+//
+// New 256-bit AVX2 soft intrinsics (not provided in softintrin.h)
+//
+// naming conventions as documented at https://www.intel.com/content/www/us/en/docs/intrinsics-guide/index.html
 //
-// New 256-bit AVX2 soft intrinsics (not provided in softintrin.h)
-//
-// naming conventions as documented at https://www.intel.com/content/www/us/en/docs/intrinsics-guide/index.html
-//
 
 typedef __n128x2 __n256;  // twin of __m256
 typedef __n128x2 __n256d; // twin of __m256d
@@ -1522,748 +2708,3258 @@ void _mm256_store_ps(float * pa, __m256 a)
     _mm256_storeu_ps(pa, a);
 }
 
+// MOVNTPS MOVNTPD MOVNTDQ MOVNTI MOVNTDQA SFENCE
+// VMOVNTPS VMOVNTPD VMOVNTDQ VMOVNTDQA
 //
-// Template for 128-bit to 256-bit dest,source1 unary vector widening instructions
+// The Visual C++ ARM64 toolset has no STNP/LDNP intrinsic and no inline assembly,
+// so a streaming store writes both 128-bit halves back to back, which the compiler
+// pairs into one STP.  ARM cores detect runs of full cache line writes and switch
+// to write streaming (no allocate) on their own, which is what MOVNT* is used for.
+// MOVNTDQA is only non-temporal on write combining memory and is an ordinary load
+// on write back memory, same as here.
+//
+// SFENCE makes the weakly ordered streaming stores visible before later stores,
+// which DMB ISHST guarantees for all earlier stores.
 //
 
-#define DEFINE_N256_OP_N128(rettype, name, intrin, arg1type, arg1, flags ) \
-\
-__forceinline __n128x2 _nn256_ ## name (const __n128 a) \
-{ \
-    __n128x2 T; \
-    T.val[0] = intrin (a); \
-    T.val[0] = _nn_postprocess(T.val[0], a, a, flags); \
-    T.val[1] = intrin (a); \
-    T.val[1] = _nn_postprocess(T.val[1], T.val[0], a, flags); \
-    return T; \
-} \
-\
-__forceinline rettype _mm256_ ## name (arg1type arg1) \
-{ \
-    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128_from_ ## arg1type (a) ) ); \
+#undef _mm_stream_ps
+#undef _mm_stream_pd
+#undef _mm_stream_si128
+#undef _mm_stream_si32
+#undef _mm_stream_si64
+#undef _mm_stream_si64x
+#undef _mm_stream_load_si128
+#undef _mm_sfence
+#undef _mm256_stream_ps
+#undef _mm256_stream_pd
+#undef _mm256_stream_si256
+#undef _mm256_stream_load_si256
+
+__forceinline
+void _nn_stream_si128(void * pa, __n128 a)
+{
+    vst1q_u8((unsigned __int8 *)pa, a);
 }
 
-//
-// Template for common 256-bit dest,source1 unary vector instructions
-//
+__forceinline
+void _nn256_stream_si256(void * pa, __n128x2 a)
+{
+    vst1q_u8((unsigned __int8 *)pa,      a.val[0]);
+    vst1q_u8((unsigned __int8 *)pa + 16, a.val[1]);
+}
 
-#define DEFINE_N256_OP_N256(rettype, name, intrin, arg1type, arg1, flags ) \
-\
-__forceinline __n128x2 _nn256_ ## name (const __n128x2 a) \
-{ \
-    __n128x2 T; \
-    T.val[0] = intrin (a.val[0]); \
-    T.val[0] = _nn_postprocess(T.val[0], a.val[0], a.val[0], flags); \
-    T.val[1] = intrin (a.val[1]); \
-    T.val[1] = _nn_postprocess(T.val[1], a.val[1], a.val[1], flags); \
-    return T; \
-} \
-\
-__forceinline rettype _mm256_ ## name (arg1type arg1) \
-{ \
-    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128x2_from_ ## arg1type (a) ) ); \
+__forceinline
+__n128 _nn_stream_load_si128(const void * pa)
+{
+    return vld1q_u8((const unsigned __int8 *)pa);
 }
 
-//
-// Template for common 256-bit dest,source1,source2 vector instructions
-//
+__forceinline
+__n128x2 _nn256_stream_load_si256(const void * pa)
+{
+    __n128x2 T;
 
-#define DEFINE_N256_OP_N256_N256(rettype, name, intrin, arg1type, arg1, arg2type, arg2, flags ) \
-\
-__forceinline __n128x2 _nn256_ ## name (__n128x2 a, const __n128x2 b) \
-{ \
-    __n128x2 T; \
-    T.val[0] = intrin (a.val[0], b.val[0]); \
-    T.val[0] = _nn_postprocess(T.val[0], a.val[0], b.val[0], flags); \
-    T.val[1] = intrin (a.val[1], b.val[1]); \
-    T.val[1] = _nn_postprocess(T.val[1], a.val[1], b.val[1], flags); \
-    return T; \
-} \
-\
-__forceinline rettype _mm256_ ## name (arg1type arg1, arg2type arg2) \
-{ \
-    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128x2_from_ ## arg1type (a), __n128x2_from_ ## arg2type (b) ) ); \
+    T.val[0] = vld1q_u8((const unsigned __int8 *)pa);
+    T.val[1] = vld1q_u8((const unsigned __int8 *)pa + 16);
+
+    return T;
 }
 
-//
-// Template for spicy 256-bit dest,source1,source2,source vector instructions
-//
+__forceinline
+void _mm_stream_ps(float * pa, __m128 a)
+{
+    _nn_stream_si128(pa, _nn128_castps_n128(a));
+}
 
-#define DEFINE_N256_OP_N256_N256_N256(rettype, name, intrin, arg1type, arg1, arg2type, arg2, arg3type, arg3, flags ) \
-\
-__forceinline __n128x2 _nn256_ ## name (__n128x2 a, const __n128x2 b, const __n128x2 c) \
-{ \
-    __n128x2 T; \
-    T.val[0] = intrin (a.val[0], b.val[0], c.val[0]); \
-    T.val[0] = _nn_postprocess(T.val[0], a.val[0], b.val[0], flags); \
-    T.val[1] = intrin (a.val[1], b.val[1], c.val[1]); \
-    T.val[1] = _nn_postprocess(T.val[1], a.val[1], b.val[1], flags); \
-    return T; \
-} \
-\
-__forceinline rettype _mm256_ ## name (arg1type arg1, arg2type arg2, arg3type arg3) \
-{ \
-    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128x2_from_ ## arg1type (a), __n128x2_from_ ## arg2type (b), __n128x2_from_ ## arg3type (c) ) ); \
+__forceinline
+void _mm_stream_pd(double * pa, __m128d a)
+{
+    _nn_stream_si128(pa, _nn128_castpd_n128(a));
 }
 
-// VPABS
-
-DEFINE_N256_OP_N256(     __m256i, abs_epi8,     vabsq_s8,       __m256i, a,             0)
-DEFINE_N256_OP_N256(     __m256i, abs_epi16,    vabsq_s16,      __m256i, a,             0)
-DEFINE_N256_OP_N256(     __m256i, abs_epi32,    vabsq_s32,      __m256i, a,             0)
-
-// VPAVG
-
-#undef _mm_avg_epu8
-#undef _mm_avg_epu16
-
-DEFINE_N256_OP_N256_N256(__m256i, avg_epu8,     vrhaddq_u8,     __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, avg_epu16,    vrhaddq_u16,    __m256i, a, __m256i, b, 0)
-
-// VPADD VPSUB
+__forceinline
+void _mm_stream_si128(__m128i * pa, __m128i a)
+{
+    _nn_stream_si128(pa, _nn128_castsi128_n128(a));
+}
 
-DEFINE_N256_OP_N256_N256(__m256i, add_epi8,     neon_addq8,     __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, add_epi16,    neon_addq16,    __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, add_epi32,    neon_addq32,    __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, add_epi64,    neon_addq64,    __m256i, a, __m256i, b, 0)
+__forceinline
+void _mm_stream_si32(int * pa, int a)
+{
+    *pa = a;
+}
 
-DEFINE_N256_OP_N256_N256(__m256i, sub_epi8,     neon_subq8,     __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, sub_epi16,    neon_subq16,    __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, sub_epi32,    neon_subq32,    __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, sub_epi64,    neon_subq64,    __m256i, a, __m256i, b, 0)
+__forceinline
+void _mm_stream_si64x(__int64 * pa, __int64 a)
+{
+    *pa = a;
+}
 
-// VPMULDQ VMULUDQ
+#define _mm_stream_si64 _mm_stream_si64x
 
-DEFINE_N256_OP_N256_N256(__m256i, mul_epi32,    sw_mulq_s32,    __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, mul_epu32,    sw_mulq_u32,    __m256i, a, __m256i, b, 0)
+__forceinline
+__m128i _mm_stream_load_si128(const __m128i * pa)
+{
+    return _nn128_castn128_si128( _nn_stream_load_si128(pa) );
+}
 
-// VPMULLO
+__forceinline
+void _mm_sfence(void)
+{
+    __dmb(_ARM64_BARRIER_ISHST);
+}
 
-DEFINE_N256_OP_N256_N256(__m256i, mullo_epi16,  vmulq_s16,      __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, mullo_epi32,  vmulq_s32,      __m256i, a, __m256i, b, 0)
+__forceinline
+void _mm256_stream_ps(float * pa, __m256 a)
+{
+    _nn256_stream_si256(pa, _nn256_castps_n256(a));
+}
 
-// VPADDS VPADDUS
+__forceinline
+void _mm256_stream_pd(double * pa, __m256d a)
+{
+    _nn256_stream_si256(pa, _nn256_castpd_n256(a));
+}
 
-DEFINE_N256_OP_N256_N256(__m256i, adds_epi8,    vqaddq_s8,      __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, adds_epi16,   vqaddq_s16,     __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, adds_epu8,    vqaddq_u8,      __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, adds_epu16,   vqaddq_u16,     __m256i, a, __m256i, b, 0)
+__forceinline
+void _mm256_stream_si256(__m256i * pa, __m256i a)
+{
+    _nn256_stream_si256(pa, _nn256_castsi256_n256(a));
+}
 
-// VPHADDW VPHADDD VPHADDSW
+__forceinline
+__m256i _mm256_stream_load_si256(const __m256i * pa)
+{
+    return _nn256_castn256_si256( _nn256_stream_load_si256(pa) );
+}
 
-DEFINE_N256_OP_N256_N256(__m256i, hadd_epi16,   vpaddq_u16,     __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, hadd_epi32,   vpaddq_u32,     __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, hadds_epi16,  sw_hadds_epi16, __m256i, a, __m256i, b, 0);
+// VPGATHERDD VPGATHERDQ VPGATHERQD VPGATHERQQ
+// VGATHERDPS VGATHERDPD VGATHERQPS VGATHERQPD
+//
+// Each element is loaded directly into its destination lane with LD1 {Vt.S}[lane]
+// so the gathered vector never round trips through memory.  Masked variants only
+// touch memory for lanes whose mask sign bit is set, exactly like the hardware,
+// so a masked-off lane with a bogus index can never fault.
+//
+// Index is sign extended to 64 bits before scaling, scale must be 1, 2, 4, or 8.
+
+#undef _mm_i32gather_epi32
+#undef _mm_i32gather_epi64
+#undef _mm_i32gather_pd
+#undef _mm_i32gather_ps
+#undef _mm_i64gather_epi32
+#undef _mm_i64gather_epi64
+#undef _mm_i64gather_pd
+#undef _mm_i64gather_ps
+
+#undef _mm_mask_i32gather_epi32
+#undef _mm_mask_i32gather_epi64
+#undef _mm_mask_i32gather_pd
+#undef _mm_mask_i32gather_ps
+#undef _mm_mask_i64gather_epi32
+#undef _mm_mask_i64gather_epi64
+#undef _mm_mask_i64gather_pd
+#undef _mm_mask_i64gather_ps
+
+#define SW_GATHER_PTR32(pb, index, scale) ((unsigned __int32 const *)((pb) + (__int64)(index) * (scale)))
+#define SW_GATHER_PTR64(pb, index, scale) ((unsigned __int64 const *)((pb) + (__int64)(index) * (scale)))
 
-// VPSUBS VPSUBUS
+__forceinline
+__n128 sw_gather_4x32(char const * pb, __int64 i0, __int64 i1, __int64 i2, __int64 i3, const int scale)
+{
+    __n128 T = vld1q_dup_u32(SW_GATHER_PTR32(pb, i0, scale));
 
-DEFINE_N256_OP_N256_N256(__m256i, subs_epi8,    vqsubq_s8,      __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, subs_epi16,   vqsubq_s16,     __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, subs_epu8,    vqsubq_u8,      __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, subs_epu16,   vqsubq_u16,     __m256i, a, __m256i, b, 0)
+    T = vld1q_lane_u32(SW_GATHER_PTR32(pb, i1, scale), T, 1);
+    T = vld1q_lane_u32(SW_GATHER_PTR32(pb, i2, scale), T, 2);
+    T = vld1q_lane_u32(SW_GATHER_PTR32(pb, i3, scale), T, 3);
 
-// VPHSUBW VPHSUBD VPHSUBSW
+    return T;
+}
 
-DEFINE_N256_OP_N256_N256(__m256i, hsub_epi16,   sw_psubq_u16,   __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, hsub_epi32,   sw_psubq_u32,   __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, hsubs_epi16,  sw_hsubs_epi16, __m256i, a, __m256i, b, 0)
+__forceinline
+__n128 sw_gather_2x32(char const * pb, __int64 i0, __int64 i1, const int scale)
+{
+    // the upper two lanes are zeroed
 
-// VPAND  VPANDN  VPOR  VPXOR
+    __n128 T = vdupq_n_u32(0);
 
-DEFINE_N256_OP_N256_N256(__m256i, and_si256,    neon_andq,      __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, andnot_si256, neon_bicq,      __m256i, b, __m256i, a, 0) // swap arg order
-DEFINE_N256_OP_N256_N256(__m256i, or_si256,     neon_orrq,      __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, xor_si256,    neon_eorq,      __m256i, a, __m256i, b, 0)
+    T = vld1q_lane_u32(SW_GATHER_PTR32(pb, i0, scale), T, 0);
+    T = vld1q_lane_u32(SW_GATHER_PTR32(pb, i1, scale), T, 1);
 
-// VANDPD VORPD VXORPD
+    return T;
+}
 
-DEFINE_N256_OP_N256_N256(__m256d, and_pd,       vandq_s64,      __m256d, a, __m256d, b, 0)
-DEFINE_N256_OP_N256_N256(__m256d, andnot_pd,    vbicq_s64,      __m256d, b, __m256d, a, 0) // swap arg order
-DEFINE_N256_OP_N256_N256(__m256d, or_pd,        vorrq_s64,      __m256d, a, __m256d, b, 0)
-DEFINE_N256_OP_N256_N256(__m256d, xor_pd,       veorq_s64,      __m256d, a, __m256d, b, 0)
+__forceinline
+__n128 sw_gather_2x64(char const * pb, __int64 i0, __int64 i1, const int scale)
+{
+    __n128 T = vld1q_dup_u64(SW_GATHER_PTR64(pb, i0, scale));
 
-// VANDPS VORPS VXORPS
+    T = vld1q_lane_u64(SW_GATHER_PTR64(pb, i1, scale), T, 1);
 
-DEFINE_N256_OP_N256_N256(__m256,  and_ps,       vandq_s32,      __m256,  a, __m256,  b, 0)
-DEFINE_N256_OP_N256_N256(__m256,  andnot_ps,    vbicq_s32,      __m256,  b, __m256,  a, 0) // swap arg order
-DEFINE_N256_OP_N256_N256(__m256,  or_ps,        vorrq_s32,      __m256,  a, __m256,  b, 0)
-DEFINE_N256_OP_N256_N256(__m256,  xor_ps,       veorq_s32,      __m256,  a, __m256,  b, 0)
+    return T;
+}
 
-// VADDPD VSUBPD VMULPD VDIVPD
+__forceinline
+__n128 sw_mask_gather_4x32(__n128 src, char const * pb, __int64 i0, __int64 i1, __int64 i2, __int64 i3, __n128 mask, const int scale)
+{
+    __n128 T = src;
 
-DEFINE_N256_OP_N256_N256(__m256d, add_pd,       neon_faddq64,   __m256d, a, __m256d, b, 0)
-DEFINE_N256_OP_N256_N256(__m256d, sub_pd,       neon_fsubq64,   __m256d, a, __m256d, b, 0)
-DEFINE_N256_OP_N256_N256(__m256d, mul_pd,       neon_fmulq64,   __m256d, a, __m256d, b, 0)
-DEFINE_N256_OP_N256_N256(__m256d, div_pd,       neon_fdivq64,   __m256d, a, __m256d, b, _IF_DIV_F64)
+    if (vgetq_lane_s32(mask, 0) < 0)
+        T = vld1q_lane_u32(SW_GATHER_PTR32(pb, i0, scale), T, 0);
 
-// VADDPD VSUBPD VMULPD VDIVPD
+    if (vgetq_lane_s32(mask, 1) < 0)
+        T = vld1q_lane_u32(SW_GATHER_PTR32(pb, i1, scale), T, 1);
 
-DEFINE_N256_OP_N256_N256(__m256,  add_ps,       neon_faddq32,   __m256,  a, __m256,  b, 0)
-DEFINE_N256_OP_N256_N256(__m256,  sub_ps,       neon_fsubq32,   __m256,  a, __m256,  b, 0)
-DEFINE_N256_OP_N256_N256(__m256,  mul_ps,       neon_fmulq32,   __m256,  a, __m256,  b, 0)
-DEFINE_N256_OP_N256_N256(__m256,  div_ps,       neon_fdivq32,   __m256,  a, __m256,  b, _IF_DIV_F32)
+    if (vgetq_lane_s32(mask, 2) < 0)
+        T = vld1q_lane_u32(SW_GATHER_PTR32(pb, i2, scale), T, 2);
 
-// VPMINS VPMAXS
+    if (vgetq_lane_s32(mask, 3) < 0)
+        T = vld1q_lane_u32(SW_GATHER_PTR32(pb, i3, scale), T, 3);
 
-DEFINE_N256_OP_N256_N256(__m256i, min_epi8,     vminq_s8,       __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, min_epi16,    vminq_s16,      __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, min_epi32,    vminq_s32,      __m256i, a, __m256i, b, 0)
+    return T;
+}
 
-DEFINE_N256_OP_N256_N256(__m256i, max_epi8,     vmaxq_s8,       __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, max_epi16,    vmaxq_s16,      __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, max_epi32,    vmaxq_s32,      __m256i, a, __m256i, b, 0)
+__forceinline
+__n128 sw_mask_gather_2x32(__n128 src, char const * pb, __int64 i0, __int64 i1, __n128 mask, const int scale)
+{
+    // the upper two lanes are zeroed regardless of mask
 
-// VPMINU VPMINU
+    __n128 T = vsetq_lane_u64(0, src, 1);
 
-DEFINE_N256_OP_N256_N256(__m256i, min_epu8,     vminq_u8,       __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, min_epu16,    vminq_u16,      __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, min_epu32,    vminq_u32,      __m256i, a, __m256i, b, 0)
+    if (vgetq_lane_s32(mask, 0) < 0)
+        T = vld1q_lane_u32(SW_GATHER_PTR32(pb, i0, scale), T, 0);
 
-DEFINE_N256_OP_N256_N256(__m256i, max_epu8,     vmaxq_u8,       __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, max_epu16,    vmaxq_u16,      __m256i, a, __m256i, b, 0)
-DEFINE_N256_OP_N256_N256(__m256i, max_epu32,    vmaxq_u32,      __m256i, a, __m256i, b, 0)
+    if (vgetq_lane_s32(mask, 1) < 0)
+        T = vld1q_lane_u32(SW_GATHER_PTR32(pb, i1, scale), T, 1);
 
-// VMIN VMAX
+    return T;
+}
 
-DEFINE_N256_OP_N256_N256(__m256d, min_pd,       vminq_f64,      __m256d, a, __m256d, b, _IF_MINMAX_F64)
-DEFINE_N256_OP_N256_N256(__m256d, max_pd,       vmaxq_f64,      __m256d, a, __m256d, b, _IF_MINMAX_F64)
+__forceinline
+__n128 sw_mask_gather_2x64(__n128 src, char const * pb, __int64 i0, __int64 i1, __n128 mask, const int scale)
+{
+    __n128 T = src;
 
-DEFINE_N256_OP_N256_N256(__m256,  min_ps,       vminq_f32,      __m256,  a, __m256,  b, _IF_MINMAX_F32)
-DEFINE_N256_OP_N256_N256(__m256,  max_ps,       vmaxq_f32,      __m256,  a, __m256,  b, _IF_MINMAX_F32)
+    if (vgetq_lane_s64(mask, 0) < 0)
+        T = vld1q_lane_u64(SW_GATHER_PTR64(pb, i0, scale), T, 0);
 
-// VHADDPD VHADDPS
+    if (vgetq_lane_s64(mask, 1) < 0)
+        T = vld1q_lane_u64(SW_GATHER_PTR64(pb, i1, scale), T, 1);
 
-DEFINE_N256_OP_N256_N256(__m256d, hadd_pd,      vpaddq_f64,     __m256d, a, __m256d, b, 0);
-DEFINE_N256_OP_N256_N256(__m256,  hadd_ps,      vpaddq_f32,     __m256,  a, __m256,  b, 0);
+    return T;
+}
 
-// VSQRTPD VSQRTPS
+// 32-bit indices
 
 __forceinline
-__n128x2 _nn256_sqrt_pd(__n128x2 a)
+__n128i _nn_i32gather_epi32(int const * base, __n128i vindex, const int scale)
 {
-    __n128x2 T;
-
-    T.val[0] = neon_fsqrtq64(a.val[0]);
-    T.val[1] = neon_fsqrtq64(a.val[1]);
+    return sw_gather_4x32((char const *)base, vgetq_lane_s32(vindex, 0), vgetq_lane_s32(vindex, 1),
+                                              vgetq_lane_s32(vindex, 2), vgetq_lane_s32(vindex, 3), scale);
+}
 
-    T.val[0] = _nn_postprocess(T.val[0], a.val[0], a.val[0], _IF_SQRT_F64);
-    T.val[1] = _nn_postprocess(T.val[1], a.val[1], a.val[1], _IF_SQRT_F64);
+__forceinline
+__n128i _nn_i32gather_epi64(__int64 const * base, __n128i vindex, const int scale)
+{
+    return sw_gather_2x64((char const *)base, vgetq_lane_s32(vindex, 0), vgetq_lane_s32(vindex, 1), scale);
+}
 
-    return T;
+__forceinline
+__n128i _nn_mask_i32gather_epi32(__n128i src, int const * base, __n128i vindex, __n128i mask, const int scale)
+{
+    return sw_mask_gather_4x32(src, (char const *)base, vgetq_lane_s32(vindex, 0), vgetq_lane_s32(vindex, 1),
+                                                        vgetq_lane_s32(vindex, 2), vgetq_lane_s32(vindex, 3), mask, scale);
 }
 
 __forceinline
-__n128x2 _nn256_sqrt_ps(__n128x2 a)
+__n128i _nn_mask_i32gather_epi64(__n128i src, __int64 const * base, __n128i vindex, __n128i mask, const int scale)
 {
-    __n128x2 T;
+    return sw_mask_gather_2x64(src, (char const *)base, vgetq_lane_s32(vindex, 0), vgetq_lane_s32(vindex, 1), mask, scale);
+}
 
-    T.val[0] = neon_fsqrtq32(a.val[0]);
-    T.val[1] = neon_fsqrtq32(a.val[1]);
+#define _nn_i32gather_ps(base, vindex, scale)                   _nn_i32gather_epi32((int const *)(base), vindex, scale)
+#define _nn_i32gather_pd(base, vindex, scale)                   _nn_i32gather_epi64((__int64 const *)(base), vindex, scale)
+#define _nn_mask_i32gather_ps(src, base, vindex, mask, scale)   _nn_mask_i32gather_epi32(src, (int const *)(base), vindex, mask, scale)
+#define _nn_mask_i32gather_pd(src, base, vindex, mask, scale)   _nn_mask_i32gather_epi64(src, (__int64 const *)(base), vindex, mask, scale)
 
-    T.val[0] = _nn_postprocess(T.val[0], a.val[0], a.val[0], _IF_SQRT_F32);
-    T.val[1] = _nn_postprocess(T.val[1], a.val[1], a.val[1], _IF_SQRT_F32);
+// 64-bit indices
 
-    return T;
+__forceinline
+__n128i _nn_i64gather_epi32(int const * base, __n128i vindex, const int scale)
+{
+    return sw_gather_2x32((char const *)base, vgetq_lane_s64(vindex, 0), vgetq_lane_s64(vindex, 1), scale);
 }
 
 __forceinline
-__m256d _mm256_sqrt_pd(__m256d a)
+__n128i _nn_i64gather_epi64(__int64 const * base, __n128i vindex, const int scale)
 {
-    return _nn256_castn256_pd( _nn256_sqrt_pd(_nn256_castpd_n256(a)) );
+    return sw_gather_2x64((char const *)base, vgetq_lane_s64(vindex, 0), vgetq_lane_s64(vindex, 1), scale);
 }
 
 __forceinline
-__m256 _mm256_sqrt_ps(__m256 a)
+__n128i _nn_mask_i64gather_epi32(__n128i src, int const * base, __n128i vindex, __n128i mask, const int scale)
 {
-    return _nn256_castn256_ps( _nn256_sqrt_ps(_nn256_castps_n256(a)) );
+    return sw_mask_gather_2x32(src, (char const *)base, vgetq_lane_s64(vindex, 0), vgetq_lane_s64(vindex, 1), mask, scale);
 }
 
-// VBLENDV
+__forceinline
+__n128i _nn_mask_i64gather_epi64(__n128i src, __int64 const * base, __n128i vindex, __n128i mask, const int scale)
+{
+    return sw_mask_gather_2x64(src, (char const *)base, vgetq_lane_s64(vindex, 0), vgetq_lane_s64(vindex, 1), mask, scale);
+}
 
-DEFINE_N256_OP_N256_N256_N256(__m256i, blendv_epi8,  sw_blendv_epi8, __m256i, a, __m256i, b, __m256i, c,    0)
-DEFINE_N256_OP_N256_N256_N256(__m256d, blendv_pd,    sw_blendv_pd,   __m256d, a, __m256d, b, __m256d, c,    0)
-DEFINE_N256_OP_N256_N256_N256(__m256,  blendv_ps,    sw_blendv_ps,   __m256,  a, __m256,  b, __m256,  c,    0)
+#define _nn_i64gather_ps(base, vindex, scale)                   _nn_i64gather_epi32((int const *)(base), vindex, scale)
+#define _nn_i64gather_pd(base, vindex, scale)                   _nn_i64gather_epi64((__int64 const *)(base), vindex, scale)
+#define _nn_mask_i64gather_ps(src, base, vindex, mask, scale)   _nn_mask_i64gather_epi32(src, (int const *)(base), vindex, mask, scale)
+#define _nn_mask_i64gather_pd(src, base, vindex, mask, scale)   _nn_mask_i64gather_epi64(src, (__int64 const *)(base), vindex, mask, scale)
 
-// BROADCAST variants
+// 256-bit forms fill both __n128x2 halves directly
 
-__forceinline __n128 sw_broadcastb_epi8(__n128 const a)      { __n128 T = vdupq_laneq_u8 (a, 0); return T; }
-__forceinline __n128 sw_broadcastw_epi16(__n128 const a)     { __n128 T = vdupq_laneq_u16(a, 0); return T; }
-__forceinline __n128 sw_broadcastd_epi32(__n128 const a)     { __n128 T = vdupq_laneq_u32(a, 0); return T; }
-__forceinline __n128 sw_broadcastq_epi64(__n128 const a)     { __n128 T = vdupq_laneq_u64(a, 0); return T; }
-__forceinline __n128 sw_broadcastsd_pd(__n128 const a)       { __n128 T = vdupq_laneq_s64(a, 0); return T; }
-__forceinline __n128 sw_broadcastss_ps(__n128 const a)       { __n128 T = vdupq_laneq_s32(a, 0); return T; }
-__forceinline __n128 sw_broadcastsi128_si256(__n128 const a) { __n128 T = a;                     return T; }
+__forceinline
+__n256i _nn256_i32gather_epi32(int const * base, __n256i vindex, const int scale)
+{
+    __n256i T;
 
-DEFINE_N256_OP_N128(__m256i, broadcastb_epi8,      sw_broadcastb_epi8,      __m128i, a, _IF_DUP_128)
-DEFINE_N256_OP_N128(__m256i, broadcastw_epi16,     sw_broadcastw_epi16,     __m128i, a, _IF_DUP_128)
-DEFINE_N256_OP_N128(__m256i, broadcastd_epi32,     sw_broadcastd_epi32,     __m128i, a, _IF_DUP_128)
-DEFINE_N256_OP_N128(__m256i, broadcastq_epi64,     sw_broadcastq_epi64,     __m128i, a, _IF_DUP_128)
-DEFINE_N256_OP_N128(__m256d, broadcastsd_pd,       sw_broadcastsd_pd,       __m128d, a, _IF_DUP_128)
-DEFINE_N256_OP_N128(__m256,  broadcastss_ps,       sw_broadcastss_ps,       __m128,  a, _IF_DUP_128)
-DEFINE_N256_OP_N128(__m256i, broadcastsi128_si256, sw_broadcastsi128_si256, __m128i, a, _IF_DUP_128)
+    T.val[0] = _nn_i32gather_epi32(base, vindex.val[0], scale);
+    T.val[1] = _nn_i32gather_epi32(base, vindex.val[1], scale);
 
-// VEXTRACTF128
+    return T;
+}
 
 __forceinline
-__m128d _mm256_extractf128_pd(__m256d a, const int imm8)
+__n256i _nn256_i32gather_epi64(__int64 const * base, __n128i vindex, const int scale)
 {
-    __m128d T = *(__m128d *)&a.m256d_f64[(imm8 & 1) << 1];
+    __n256i T;
+
+    T.val[0] = sw_gather_2x64((char const *)base, vgetq_lane_s32(vindex, 0), vgetq_lane_s32(vindex, 1), scale);
+    T.val[1] = sw_gather_2x64((char const *)base, vgetq_lane_s32(vindex, 2), vgetq_lane_s32(vindex, 3), scale);
+
     return T;
 }
 
 __forceinline
-__m128 _mm256_extractf128_ps(__m256 a, const int imm8)
+__n128i _nn256_i64gather_epi32(int const * base, __n256i vindex, const int scale)
 {
-    __m128 T = *(__m128 *)&a.m256_f32[(imm8 & 1) << 2];
-    return T;
+    return sw_gather_4x32((char const *)base, vgetq_lane_s64(vindex.val[0], 0), vgetq_lane_s64(vindex.val[0], 1),
+                                              vgetq_lane_s64(vindex.val[1], 0), vgetq_lane_s64(vindex.val[1], 1), scale);
 }
 
-// VPERF2F128
-
 __forceinline
-__n256i _nn256_permute2f128_si256 (__n256i a, __n256i b, const int imm8)
+__n256i _nn256_i64gather_epi64(__int64 const * base, __n256i vindex, const int scale)
 {
     __n256i T;
 
-    T.val[0] = (imm8 & 0x08) ? _nn_set1_ps(0.0f) : ((imm8 & 0x02) ? b.val[(imm8 & 0x01) >> 0] : a.val[(imm8 & 0x01) >> 0]);
-    T.val[1] = (imm8 & 0x80) ? _nn_set1_ps(0.0f) : ((imm8 & 0x20) ? b.val[(imm8 & 0x10) >> 4] : a.val[(imm8 & 0x10) >> 4]);
+    T.val[0] = _nn_i64gather_epi64(base, vindex.val[0], scale);
+    T.val[1] = _nn_i64gather_epi64(base, vindex.val[1], scale);
 
     return T;
 }
 
 __forceinline
-__m256i _mm256_permute2f128_si256 (__m256i a, __m256i b, const int imm8)
+__n256i _nn256_mask_i32gather_epi32(__n256i src, int const * base, __n256i vindex, __n256i mask, const int scale)
 {
-    return _nn256_castn256_si256( _nn256_permute2f128_si256(_nn256_castsi256_n256(a), _nn256_castsi256_n256(b), imm8) );
+    __n256i T;
+
+    T.val[0] = _nn_mask_i32gather_epi32(src.val[0], base, vindex.val[0], mask.val[0], scale);
+    T.val[1] = _nn_mask_i32gather_epi32(src.val[1], base, vindex.val[1], mask.val[1], scale);
+
+    return T;
 }
 
 __forceinline
-__m256d _mm256_permute2f128_pd (__m256d a, __m256d b, const int imm8)
+__n256i _nn256_mask_i32gather_epi64(__n256i src, __int64 const * base, __n128i vindex, __n256i mask, const int scale)
 {
-    return _nn256_castn256_pd( _nn256_permute2f128_si256(_nn256_castpd_n256(a), _nn256_castpd_n256(b), imm8) );
+    __n256i T;
+
+    T.val[0] = sw_mask_gather_2x64(src.val[0], (char const *)base, vgetq_lane_s32(vindex, 0), vgetq_lane_s32(vindex, 1), mask.val[0], scale);
+    T.val[1] = sw_mask_gather_2x64(src.val[1], (char const *)base, vgetq_lane_s32(vindex, 2), vgetq_lane_s32(vindex, 3), mask.val[1], scale);
+
+    return T;
 }
 
 __forceinline
-__m256 _mm256_permute2f128_ps (__m256 a, __m256 b, const int imm8)
+__n128i _nn256_mask_i64gather_epi32(__n128i src, int const * base, __n256i vindex, __n128i mask, const int scale)
 {
-    return _nn256_castn256_ps( _nn256_permute2f128_si256(_nn256_castps_n256(a), _nn256_castps_n256(b), imm8) );
+    return sw_mask_gather_4x32(src, (char const *)base, vgetq_lane_s64(vindex.val[0], 0), vgetq_lane_s64(vindex.val[0], 1),
+                                                        vgetq_lane_s64(vindex.val[1], 0), vgetq_lane_s64(vindex.val[1], 1), mask, scale);
 }
 
-// VPERMILPD VPERMILPS
-
 __forceinline
-__m256d _mm256_permute_pd(__m256d a, const int imm8)
+__n256i _nn256_mask_i64gather_epi64(__n256i src, __int64 const * base, __n256i vindex, __n256i mask, const int scale)
 {
-    __m256d T =
-    {
-        a.m256d_f64[0 + ((imm8 >> 0) & 1)],
-        a.m256d_f64[0 + ((imm8 >> 1) & 1)],
-        a.m256d_f64[2 + ((imm8 >> 2) & 1)],
-        a.m256d_f64[2 + ((imm8 >> 3) & 1)],
-    };
+    __n256i T;
+
+    T.val[0] = _nn_mask_i64gather_epi64(src.val[0], base, vindex.val[0], mask.val[0], scale);
+    T.val[1] = _nn_mask_i64gather_epi64(src.val[1], base, vindex.val[1], mask.val[1], scale);
 
     return T;
 }
 
-__forceinline
-__m256 _mm256_permute_ps(__m256 a, const int imm8)
-{
-    __m256 T =
-    {
-        a.m256_f32[0 + ((imm8 >> 0) & 3)],
-        a.m256_f32[0 + ((imm8 >> 2) & 3)],
-        a.m256_f32[0 + ((imm8 >> 4) & 3)],
-        a.m256_f32[0 + ((imm8 >> 6) & 3)],
-        a.m256_f32[4 + ((imm8 >> 0) & 3)],
-        a.m256_f32[4 + ((imm8 >> 2) & 3)],
-        a.m256_f32[4 + ((imm8 >> 4) & 3)],
-        a.m256_f32[4 + ((imm8 >> 6) & 3)],
-    };
+#define _nn256_i32gather_ps(base, vindex, scale)                   _nn256_i32gather_epi32((int const *)(base), vindex, scale)
+#define _nn256_i32gather_pd(base, vindex, scale)                   _nn256_i32gather_epi64((__int64 const *)(base), vindex, scale)
+#define _nn256_i64gather_ps(base, vindex, scale)                   _nn256_i64gather_epi32((int const *)(base), vindex, scale)
+#define _nn256_i64gather_pd(base, vindex, scale)                   _nn256_i64gather_epi64((__int64 const *)(base), vindex, scale)
+#define _nn256_mask_i32gather_ps(src, base, vindex, mask, scale)   _nn256_mask_i32gather_epi32(src, (int const *)(base), vindex, mask, scale)
+#define _nn256_mask_i32gather_pd(src, base, vindex, mask, scale)   _nn256_mask_i32gather_epi64(src, (__int64 const *)(base), vindex, mask, scale)
+#define _nn256_mask_i64gather_ps(src, base, vindex, mask, scale)   _nn256_mask_i64gather_epi32(src, (int const *)(base), vindex, mask, scale)
+#define _nn256_mask_i64gather_pd(src, base, vindex, mask, scale)   _nn256_mask_i64gather_epi64(src, (__int64 const *)(base), vindex, mask, scale)
 
-    return T;
+//
+// Template for the SSE/AVX gather wrappers around the native twins
+//
+
+#define DEFINE_GATHER(rettype, width, name, nnname, basetype, idxtype, idxnnname) \
+\
+__forceinline rettype _mm ## width ## _ ## name (basetype const * base, idxtype vindex, const int scale) \
+{ \
+    return rettype ## _from___ ## nnname ( _nn ## width ## _ ## name (base, __ ## idxnnname ## _from_ ## idxtype (vindex), scale) ); \
 }
 
-// VMOVSHDUP VMOVSLDUP
+#define DEFINE_MASK_GATHER(rettype, width, name, nnname, basetype, idxtype, idxnnname) \
+\
+__forceinline rettype _mm ## width ## _ ## name (rettype src, basetype const * base, idxtype vindex, rettype mask, const int scale) \
+{ \
+    return rettype ## _from___ ## nnname ( _nn ## width ## _ ## name (__ ## nnname ## _from_ ## rettype (src), base, \
+        __ ## idxnnname ## _from_ ## idxtype (vindex), __ ## nnname ## _from_ ## rettype (mask), scale) ); \
+}
+
+//             rettype  width  name                 nnname    basetype  idxtype   idxnnname
+
+DEFINE_GATHER(__m128i,       , i32gather_epi32,     n128,     int,      __m128i,  n128)
+DEFINE_GATHER(__m128i,       , i32gather_epi64,     n128,     __int64,  __m128i,  n128)
+DEFINE_GATHER(__m128d,       , i32gather_pd,        n128,     double,   __m128i,  n128)
+DEFINE_GATHER(__m128,        , i32gather_ps,        n128,     float,    __m128i,  n128)
+DEFINE_GATHER(__m128i,       , i64gather_epi32,     n128,     int,      __m128i,  n128)
+DEFINE_GATHER(__m128i,       , i64gather_epi64,     n128,     __int64,  __m128i,  n128)
+DEFINE_GATHER(__m128d,       , i64gather_pd,        n128,     double,   __m128i,  n128)
+DEFINE_GATHER(__m128,        , i64gather_ps,        n128,     float,    __m128i,  n128)
+
+DEFINE_GATHER(__m256i,    256, i32gather_epi32,     n128x2,   int,      __m256i,  n128x2)
+DEFINE_GATHER(__m256i,    256, i32gather_epi64,     n128x2,   __int64,  __m128i,  n128)
+DEFINE_GATHER(__m256d,    256, i32gather_pd,        n128x2,   double,   __m128i,  n128)
+DEFINE_GATHER(__m256,     256, i32gather_ps,        n128x2,   float,    __m256i,  n128x2)
+DEFINE_GATHER(__m128i,    256, i64gather_epi32,     n128,     int,      __m256i,  n128x2)
+DEFINE_GATHER(__m256i,    256, i64gather_epi64,     n128x2,   __int64,  __m256i,  n128x2)
+DEFINE_GATHER(__m256d,    256, i64gather_pd,        n128x2,   double,   __m256i,  n128x2)
+DEFINE_GATHER(__m128,     256, i64gather_ps,        n128,     float,    __m256i,  n128x2)
+
+//                  rettype  width  name                 nnname    basetype  idxtype   idxnnname
+
+DEFINE_MASK_GATHER(__m128i,       , mask_i32gather_epi32,n128,     int,      __m128i,  n128)
+DEFINE_MASK_GATHER(__m128i,       , mask_i32gather_epi64,n128,     __int64,  __m128i,  n128)
+DEFINE_MASK_GATHER(__m128d,       , mask_i32gather_pd,   n128,     double,   __m128i,  n128)
+DEFINE_MASK_GATHER(__m128,        , mask_i32gather_ps,   n128,     float,    __m128i,  n128)
+DEFINE_MASK_GATHER(__m128i,       , mask_i64gather_epi32,n128,     int,      __m128i,  n128)
+DEFINE_MASK_GATHER(__m128i,       , mask_i64gather_epi64,n128,     __int64,  __m128i,  n128)
+DEFINE_MASK_GATHER(__m128d,       , mask_i64gather_pd,   n128,     double,   __m128i,  n128)
+DEFINE_MASK_GATHER(__m128,        , mask_i64gather_ps,   n128,     float,    __m128i,  n128)
+
+DEFINE_MASK_GATHER(__m256i,    256, mask_i32gather_epi32,n128x2,   int,      __m256i,  n128x2)
+DEFINE_MASK_GATHER(__m256i,    256, mask_i32gather_epi64,n128x2,   __int64,  __m128i,  n128)
+DEFINE_MASK_GATHER(__m256d,    256, mask_i32gather_pd,   n128x2,   double,   __m128i,  n128)
+DEFINE_MASK_GATHER(__m256,     256, mask_i32gather_ps,   n128x2,   float,    __m256i,  n128x2)
+DEFINE_MASK_GATHER(__m128i,    256, mask_i64gather_epi32,n128,     int,      __m256i,  n128x2)
+DEFINE_MASK_GATHER(__m256i,    256, mask_i64gather_epi64,n128x2,   __int64,  __m256i,  n128x2)
+DEFINE_MASK_GATHER(__m256d,    256, mask_i64gather_pd,   n128x2,   double,   __m256i,  n128x2)
+DEFINE_MASK_GATHER(__m128,     256, mask_i64gather_ps,   n128,     float,    __m256i,  n128x2)
+
+// VMASKMOVPS VMASKMOVPD VPMASKMOVD VPMASKMOVQ
+//
+// x86 masked loads never fault on masked-off elements and masked stores never
+// touch them.  A load uses a single full-width LDR + AND whenever the 16 bytes
+// lie within one page and at least one lane is active, as that page must then
+// be mapped.  A load whose 16 bytes straddle a page boundary falls back to
+// per-lane loads.  Stores are always per-lane unless every lane is active, as
+// writing back the masked-off lanes would race with other threads.
+
+#define SW_MASKMOV_PAGE_SIZE 0x1000
 
 __forceinline
-__m256 _mm256_moveldup_ps(__m256 a)
+int sw_maskmov_crosses_page(void const * p)
 {
-    return _mm256_permute_ps(a, 0xA0); // A0 = 10'10'00'00
+    return ((unsigned __int64)p & (SW_MASKMOV_PAGE_SIZE - 1)) > (SW_MASKMOV_PAGE_SIZE - 16);
 }
 
 __forceinline
-__m256 _mm256_movehdup_ps(__m256 a)
+__n128 sw_maskload_4x32(void const * p, __n128 mask)
 {
-    return _mm256_permute_ps(a, 0xF5); // F5 = 11'11'01'01
-}
+    const __n128 Select = neon_sshriq32(mask, 31);
+    __n128 T;
 
-// VCVT variants
+    if (vmaxvq_u32(Select) == 0)
+        return neon_moviqw(0);
 
-// VCVTDQ2PD
+    if (!sw_maskmov_crosses_page(p))
+        return neon_andq(vld1q_u32((unsigned __int32 const *)p), Select);
 
-__forceinline
-__n128x2 _nn256_sw_cvtepi32_pd(__n128i a)
-{
-    __n128x2 T;
+    T = neon_moviqw(0);
 
-    T.val[0].n128_f64[0] = (int)a.n128_u32[0];
-    T.val[0].n128_f64[1] = (int)a.n128_u32[1];
-    T.val[1].n128_f64[0] = (int)a.n128_u32[2];
-    T.val[1].n128_f64[1] = (int)a.n128_u32[3];
+    if (vgetq_lane_u32(Select, 0)) T = vld1q_lane_u32((unsigned __int32 const *)p + 0, T, 0);
+    if (vgetq_lane_u32(Select, 1)) T = vld1q_lane_u32((unsigned __int32 const *)p + 1, T, 1);
+    if (vgetq_lane_u32(Select, 2)) T = vld1q_lane_u32((unsigned __int32 const *)p + 2, T, 2);
+    if (vgetq_lane_u32(Select, 3)) T = vld1q_lane_u32((unsigned __int32 const *)p + 3, T, 3);
 
     return T;
 }
 
-#if 0
 __forceinline
-__n128x2 _nn256_cvtepi32_pd(__n128i a)
+__n128 sw_maskload_2x64(void const * p, __n128 mask)
 {
-    __n128x2 T;
-
-    T.val[0] = vcvt_f64_s32(a.DUMMYNEONSTRUCT.low64);
-    T.val[1] = vcvt_high_f64_s32(a);
-
-    return T;
-}
-#endif
+    const __n128 Select = neon_sshriq64(mask, 63);
+    __n128 T;
 
-// VCVTDQ2PS
+    if (vmaxvq_u32(Select) == 0)
+        return neon_moviqw(0);
 
-__forceinline
-__m256d _mm256_cvtepi32_pd(__m128i a)
-{
-    return _nn256_castn256_pd( _nn256_sw_cvtepi32_pd(_nn128_castsi128_n128(a)) );
-}
+    if (!sw_maskmov_crosses_page(p))
+        return neon_andq(vld1q_u64((unsigned __int64 const *)p), Select);
 
-__forceinline
-__n256 _nn256_sw_cvtepi32_ps(__n256i a)
-{
-    __n256 T;
+    T = neon_moviqw(0);
 
-    T.val[0].n128_f32[0] = (float)(__int32)a.val[0].n128_u32[0];
-    T.val[0].n128_f32[1] = (float)(__int32)a.val[0].n128_u32[1];
-    T.val[0].n128_f32[2] = (float)(__int32)a.val[0].n128_u32[2];
-    T.val[0].n128_f32[3] = (float)(__int32)a.val[0].n128_u32[3];
-    T.val[1].n128_f32[0] = (float)(__int32)a.val[1].n128_u32[0];
-    T.val[1].n128_f32[1] = (float)(__int32)a.val[1].n128_u32[1];
-    T.val[1].n128_f32[2] = (float)(__int32)a.val[1].n128_u32[2];
-    T.val[1].n128_f32[3] = (float)(__int32)a.val[1].n128_u32[3];
+    if (vgetq_lane_u64(Select, 0)) T = vld1q_lane_u64((unsigned __int64 const *)p + 0, T, 0);
+    if (vgetq_lane_u64(Select, 1)) T = vld1q_lane_u64((unsigned __int64 const *)p + 1, T, 1);
 
     return T;
 }
 
 __forceinline
-__m256 _mm256_cvtepi32_ps(__m256i a)
-{
-    return _nn256_castn256_ps( _nn256_sw_cvtepi32_ps(_nn256_castsi256_n256(a)) );
-}
-
-// VCVTPS2PD
-
-__forceinline
-__n128x2 _nn256_sw_cvtps_pd(__n128 a)
+void sw_maskstore_4x32(void * p, __n128 mask, __n128 a)
 {
-    __n128x2 T;
+    const __n128 Select = neon_sshriq32(mask, 31);
 
-    T.val[0].n128_f64[0] = a.n128_f32[0];
-    T.val[0].n128_f64[1] = a.n128_f32[1];
-    T.val[1].n128_f64[0] = a.n128_f32[2];
-    T.val[1].n128_f64[1] = a.n128_f32[3];
+    if (vminvq_u32(Select) != 0)
+    {
+        vst1q_u32((unsigned __int32 *)p, a);
+        return;
+    }
 
-    return T;
+    if (vgetq_lane_u32(Select, 0)) vst1q_lane_u32((unsigned __int32 *)p + 0, a, 0);
+    if (vgetq_lane_u32(Select, 1)) vst1q_lane_u32((unsigned __int32 *)p + 1, a, 1);
+    if (vgetq_lane_u32(Select, 2)) vst1q_lane_u32((unsigned __int32 *)p + 2, a, 2);
+    if (vgetq_lane_u32(Select, 3)) vst1q_lane_u32((unsigned __int32 *)p + 3, a, 3);
 }
 
 __forceinline
-__n128x2 _nn256_cvtps_pd(__n128 a)
+void sw_maskstore_2x64(void * p, __n128 mask, __n128 a)
 {
-    __n128x2 T;
-
-    T.val[0] = vcvt_f64_f32(a.DUMMYNEONSTRUCT.low64);
-    T.val[1] = vcvt_high_f64_f32(a);
+    const __n128 Select = neon_sshriq64(mask, 63);
 
-    return T;
-}
+    if (vminvq_u32(Select) != 0)
+    {
+        vst1q_u64((unsigned __int64 *)p, a);
+        return;
+    }
 
-__forceinline
-__m256d _mm256_cvtps_pd(__m128 a)
-{
-    return _nn256_castn256_pd( _nn256_cvtps_pd(_nn128_castps_n128(a)) );
+    if (vgetq_lane_u64(Select, 0)) vst1q_lane_u64((unsigned __int64 *)p + 0, a, 0);
+    if (vgetq_lane_u64(Select, 1)) vst1q_lane_u64((unsigned __int64 *)p + 1, a, 1);
 }
 
-// VCVTPD2DQ
-
 __forceinline
-__n128i _nn256_sw_cvtpd_epi32(__n256d a)
+__n128i _nn_maskload_epi32(int const * mem_addr, __n128i mask)
 {
-    __n128 T;
-
-    T.n128_u32[0] = (__int32)a.val[0].n128_f64[0];
-    T.n128_u32[1] = (__int32)a.val[0].n128_f64[1];
-    T.n128_u32[2] = (__int32)a.val[1].n128_f64[0];
-    T.n128_u32[3] = (__int32)a.val[1].n128_f64[1];
-
-    return T;
+    return sw_maskload_4x32(mem_addr, mask);
 }
 
 __forceinline
-__m128i _mm256_cvtpd_epi32(__m256d a)
+__n128i _nn_maskload_epi64(__int64 const * mem_addr, __n128i mask)
 {
-    return _nn128_castn128_si128( _nn256_sw_cvtpd_epi32(_nn256_castpd_n256(a)) );
+    return sw_maskload_2x64(mem_addr, mask);
 }
 
-// VCVTTPD2DQ
-
 __forceinline
-__n128i _nn256_sw_cvttpd_epi32(__n256d a)
+void _nn_maskstore_epi32(int * mem_addr, __n128i mask, __n128i a)
 {
-    __n128 T;
-
-    T.n128_u32[0] = (__int32)a.val[0].n128_f64[0];
-    T.n128_u32[1] = (__int32)a.val[0].n128_f64[1];
-    T.n128_u32[2] = (__int32)a.val[1].n128_f64[0];
-    T.n128_u32[3] = (__int32)a.val[1].n128_f64[1];
-
-    return T;
+    sw_maskstore_4x32(mem_addr, mask, a);
 }
 
 __forceinline
-__m128i _mm256_cvttpd_epi32(__m256d a)
+void _nn_maskstore_epi64(__int64 * mem_addr, __n128i mask, __n128i a)
 {
-    return _nn128_castn128_si128( _nn256_sw_cvttpd_epi32(_nn256_castpd_n256(a)) );
+    sw_maskstore_2x64(mem_addr, mask, a);
 }
 
-// VCVTPD2PS
+// each 128-bit half is checked for a page crossing independently
 
 __forceinline
-__n128 _nn256_sw_cvtpd_ps(__n128x2 a)
+__n256i _nn256_maskload_epi32(int const * mem_addr, __n256i mask)
 {
-    __n128 T;
+    __n256i T;
 
-    T.n128_f32[0] = (float)a.val[0].n128_f64[0];
-    T.n128_f32[1] = (float)a.val[0].n128_f64[1];
-    T.n128_f32[2] = (float)a.val[1].n128_f64[0];
-    T.n128_f32[3] = (float)a.val[1].n128_f64[1];
+    T.val[0] = sw_maskload_4x32(mem_addr + 0, mask.val[0]);
+    T.val[1] = sw_maskload_4x32(mem_addr + 4, mask.val[1]);
 
     return T;
 }
 
 __forceinline
-__n128 _nn256_cvtpd_ps(__n256 a)
+__n256i _nn256_maskload_epi64(__int64 const * mem_addr, __n256i mask)
 {
-    __n128 T = vcvt_high_f32_f64(vcvt_f32_f64(a.val[0]), a.val[1]);
+    __n256i T;
+
+    T.val[0] = sw_maskload_2x64(mem_addr + 0, mask.val[0]);
+    T.val[1] = sw_maskload_2x64(mem_addr + 2, mask.val[1]);
 
     return T;
 }
 
 __forceinline
-__m128 _mm256_cvtpd_ps(__m256d a)
+void _nn256_maskstore_epi32(int * mem_addr, __n256i mask, __n256i a)
 {
-    return _nn128_castn128_ps( _nn256_cvtpd_ps(_nn256_castpd_n256(a)) );
+    sw_maskstore_4x32(mem_addr + 0, mask.val[0], a.val[0]);
+    sw_maskstore_4x32(mem_addr + 4, mask.val[1], a.val[1]);
 }
 
-// VPSLL VPSRL VPSRA
-
 __forceinline
-__n256i _nn256_sw_sli_si256(__n256i a, const int imm8)
+void _nn256_maskstore_epi64(__int64 * mem_addr, __n256i mask, __n256i a)
 {
-    __n256 T;
+    sw_maskstore_2x64(mem_addr + 0, mask.val[0], a.val[0]);
+    sw_maskstore_2x64(mem_addr + 2, mask.val[1], a.val[1]);
+}
 
-    for (unsigned i = 0; i < 16; i++)
-    {
-        unsigned FromLane = (i + imm8);
+#define _nn_maskload_ps(mem_addr, mask)         _nn_maskload_epi32((int const *)(mem_addr), mask)
+#define _nn_maskload_pd(mem_addr, mask)         _nn_maskload_epi64((__int64 const *)(mem_addr), mask)
+#define _nn_maskstore_ps(mem_addr, mask, a)     _nn_maskstore_epi32((int *)(mem_addr), mask, a)
+#define _nn_maskstore_pd(mem_addr, mask, a)     _nn_maskstore_epi64((__int64 *)(mem_addr), mask, a)
+#define _nn256_maskload_ps(mem_addr, mask)      _nn256_maskload_epi32((int const *)(mem_addr), mask)
+#define _nn256_maskload_pd(mem_addr, mask)      _nn256_maskload_epi64((__int64 const *)(mem_addr), mask)
+#define _nn256_maskstore_ps(mem_addr, mask, a)  _nn256_maskstore_epi32((int *)(mem_addr), mask, a)
+#define _nn256_maskstore_pd(mem_addr, mask, a)  _nn256_maskstore_epi64((__int64 *)(mem_addr), mask, a)
 
-        T.val[0].n128_i8[i] = (FromLane >= 16) ? 0 : a.val[0].n128_i8[FromLane];
-        T.val[1].n128_i8[i] = (FromLane >= 16) ? 0 : a.val[1].n128_i8[FromLane];
-    }
+//
+// Template for the SSE/AVX masked load and store wrappers around the native twins
+//
 
-    return T;
+#define DEFINE_MASKLOAD(rettype, width, name, nnname, basetype, masktype) \
+\
+__forceinline rettype _mm ## width ## _ ## name (basetype const * mem_addr, masktype mask) \
+{ \
+    return rettype ## _from___ ## nnname ( _nn ## width ## _ ## name (mem_addr, __ ## nnname ## _from_ ## masktype (mask)) ); \
 }
 
-__forceinline
-__n256i _nn256_slli_si256(__n256i a, const int imm8)
-{
-    return _nn256_sw_sli_si256(a, -imm8);
+#define DEFINE_MASKSTORE(valtype, width, name, nnname, basetype, masktype) \
+\
+__forceinline void _mm ## width ## _ ## name (basetype * mem_addr, masktype mask, valtype a) \
+{ \
+    _nn ## width ## _ ## name (mem_addr, __ ## nnname ## _from_ ## masktype (mask), __ ## nnname ## _from_ ## valtype (a)); \
 }
 
-__forceinline
-__n256i _nn256_srli_si256(__n256i a, const int imm8)
-{
-    return _nn256_sw_sli_si256(a, +imm8);
-}
+//              rettype  width  name             nnname    basetype  masktype
 
-__forceinline
-__m256i _mm256_slli_si256(__m256i a, const int imm8)
-{
-    return _nn256_castn256_si256( _nn256_slli_si256(_nn256_castsi256_n256(a), imm8 ) );
-}
+DEFINE_MASKLOAD(__m128i,       , maskload_epi32, n128,     int,      __m128i)
+DEFINE_MASKLOAD(__m128i,       , maskload_epi64, n128,     __int64,  __m128i)
+DEFINE_MASKLOAD(__m128,        , maskload_ps,    n128,     float,    __m128i)
+DEFINE_MASKLOAD(__m128d,       , maskload_pd,    n128,     double,   __m128i)
+DEFINE_MASKLOAD(__m256i,    256, maskload_epi32, n128x2,   int,      __m256i)
+DEFINE_MASKLOAD(__m256i,    256, maskload_epi64, n128x2,   __int64,  __m256i)
+DEFINE_MASKLOAD(__m256,     256, maskload_ps,    n128x2,   float,    __m256i)
+DEFINE_MASKLOAD(__m256d,    256, maskload_pd,    n128x2,   double,   __m256i)
 
-__forceinline
-__m256i _mm256_srli_si256(__m256i a, const int imm8)
-{
-    return _nn256_castn256_si256( _nn256_srli_si256(_nn256_castsi256_n256(a), imm8 ) );
-}
+//               valtype  width  name              nnname    basetype  masktype
 
-//
-// Double-wide AVX operations derived by doubling existing SSE operations
-//
+DEFINE_MASKSTORE(__m128i,       , maskstore_epi32, n128,     int,      __m128i)
+DEFINE_MASKSTORE(__m128i,       , maskstore_epi64, n128,     __int64,  __m128i)
+DEFINE_MASKSTORE(__m128,        , maskstore_ps,    n128,     float,    __m128i)
+DEFINE_MASKSTORE(__m128d,       , maskstore_pd,    n128,     double,   __m128i)
+DEFINE_MASKSTORE(__m256i,    256, maskstore_epi32, n128x2,   int,      __m256i)
+DEFINE_MASKSTORE(__m256i,    256, maskstore_epi64, n128x2,   __int64,  __m256i)
+DEFINE_MASKSTORE(__m256,     256, maskstore_ps,    n128x2,   float,    __m256i)
+DEFINE_MASKSTORE(__m256d,    256, maskstore_pd,    n128x2,   double,   __m256i)
 
 //
-// Template for double-wide 256-bit dest,source1 vector instructions
+// Template for 128-bit to 256-bit dest,source1 unary vector widening instructions
 //
 
-#define DEFINE_M256_OP_M256(rettype, rettype128, name, arg1type, arg1type128) \
+#define DEFINE_N256_OP_N128(rettype, name, intrin, arg1type, arg1, flags ) \
 \
-__forceinline __n128x2 _nn256_ ## name (__n128x2 a) \
+__forceinline __n128x2 _nn256_ ## name (const __n128 a) \
 { \
     __n128x2 T; \
-    T.val[0] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[0]) ) ); \
-    T.val[1] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[1]) ) ); \
+    T.val[0] = intrin (a); \
+    T.val[0] = _nn_postprocess(T.val[0], a, a, flags); \
+    T.val[1] = intrin (a); \
+    T.val[1] = _nn_postprocess(T.val[1], T.val[0], a, flags); \
     return T; \
 } \
 \
 __forceinline rettype _mm256_ ## name (arg1type arg1) \
 { \
-    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128x2_from_ ## arg1type (arg1) ) ); \
+    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128_from_ ## arg1type (a) ) ); \
 }
 
-// VCVTPS2DQ
-// VCVTTPS2DQ
-
-DEFINE_M256_OP_M256(__m256i, __m128i, cvtps_epi32,   __m256 , __m128 )
-DEFINE_M256_OP_M256(__m256i, __m128i, cvttps_epi32,  __m256 , __m128 )
-
-// VRCPPS
-// VRSQRTPS
-
-DEFINE_M256_OP_M256(__m256 , __m128 , rcp_ps,        __m256 , __m128 )
-DEFINE_M256_OP_M256(__m256 , __m128 , rsqrt_ps,      __m256 , __m128 )
-
 //
-// Template for double-wide 256-bit dest,source1,imm8 vector instructions
+// Template for common 256-bit dest,source1 unary vector instructions
 //
 
-#define DEFINE_M256_OP_M256_IMM8(rettype, rettype128, name, arg1type, arg1type128) \
+#define DEFINE_N256_OP_N256(rettype, name, intrin, arg1type, arg1, flags ) \
 \
-__forceinline __n128x2 _nn256_ ## name (__n128x2 a, const int imm8) \
+__forceinline __n128x2 _nn256_ ## name (const __n128x2 a) \
 { \
     __n128x2 T; \
-    T.val[0] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[0]), imm8 ) ); \
-    T.val[1] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[1]), imm8 ) ); \
+    T.val[0] = intrin (a.val[0]); \
+    T.val[0] = _nn_postprocess(T.val[0], a.val[0], a.val[0], flags); \
+    T.val[1] = intrin (a.val[1]); \
+    T.val[1] = _nn_postprocess(T.val[1], a.val[1], a.val[1], flags); \
     return T; \
 } \
 \
-__forceinline rettype _mm256_ ## name (arg1type arg1, const int imm8) \
+__forceinline rettype _mm256_ ## name (arg1type arg1) \
 { \
-    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128x2_from_ ## arg1type (arg1), imm8 ) ); \
+    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128x2_from_ ## arg1type (a) ) ); \
 }
 
-DEFINE_M256_OP_M256_IMM8(__m256i, __m128i, shuffle_epi32, __m256i, __m128i)
-
-DEFINE_M256_OP_M256_IMM8(__m256i, __m128i, slli_epi16,    __m256i, __m128i)
-DEFINE_M256_OP_M256_IMM8(__m256i, __m128i, slli_epi32,    __m256i, __m128i)
-DEFINE_M256_OP_M256_IMM8(__m256i, __m128i, slli_epi64,    __m256i, __m128i)
-
-DEFINE_M256_OP_M256_IMM8(__m256i, __m128i, srai_epi16,    __m256i, __m128i)
-DEFINE_M256_OP_M256_IMM8(__m256i, __m128i, srai_epi32,    __m256i, __m128i)
-
-DEFINE_M256_OP_M256_IMM8(__m256i, __m128i, srli_epi16,    __m256i, __m128i)
-DEFINE_M256_OP_M256_IMM8(__m256i, __m128i, srli_epi32,    __m256i, __m128i)
-DEFINE_M256_OP_M256_IMM8(__m256i, __m128i, srli_epi64,    __m256i, __m128i)
-
 //
-// Template for double-wide 256-bit dest,source1,source2 vector instructions
-// Variants for source2 is 128-bit and 256-bit
+// Template for common 256-bit dest,source1,source2 vector instructions
 //
 
-#define DEFINE_M256_OP_M256_M128(rettype, rettype128, name, arg1type, arg1type128, arg2type, arg2type128) \
+#define DEFINE_N256_OP_N256_N256(rettype, name, intrin, arg1type, arg1, arg2type, arg2, flags ) \
 \
-__forceinline __n128x2 _nn256_ ## name (__n128x2 a, const __n128 b) \
+__forceinline __n128x2 _nn256_ ## name (__n128x2 a, const __n128x2 b) \
 { \
     __n128x2 T; \
-    T.val[0] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[0]), arg2type128 ## _from___n128(b) ) ); \
-    T.val[1] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[1]), arg2type128 ## _from___n128(b) ) ); \
+    T.val[0] = intrin (a.val[0], b.val[0]); \
+    T.val[0] = _nn_postprocess(T.val[0], a.val[0], b.val[0], flags); \
+    T.val[1] = intrin (a.val[1], b.val[1]); \
+    T.val[1] = _nn_postprocess(T.val[1], a.val[1], b.val[1], flags); \
     return T; \
 } \
 \
 __forceinline rettype _mm256_ ## name (arg1type arg1, arg2type arg2) \
 { \
-    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128x2_from_ ## arg1type (arg1), __n128_from_ ## arg2type (arg2) ) ); \
+    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128x2_from_ ## arg1type (a), __n128x2_from_ ## arg2type (b) ) ); \
 }
 
-DEFINE_M256_OP_M256_M128(__m256i, __m128i, sll_epi16,     __m256i, __m128i, __m128i, __m128i)
-DEFINE_M256_OP_M256_M128(__m256i, __m128i, sll_epi32,     __m256i, __m128i, __m128i, __m128i)
-DEFINE_M256_OP_M256_M128(__m256i, __m128i, sll_epi64,     __m256i, __m128i, __m128i, __m128i)
-
-DEFINE_M256_OP_M256_M128(__m256i, __m128i, sra_epi16,     __m256i, __m128i, __m128i, __m128i)
-DEFINE_M256_OP_M256_M128(__m256i, __m128i, sra_epi32,     __m256i, __m128i, __m128i, __m128i)
-
-DEFINE_M256_OP_M256_M128(__m256i, __m128i, srl_epi16,     __m256i, __m128i, __m128i, __m128i)
-DEFINE_M256_OP_M256_M128(__m256i, __m128i, srl_epi32,     __m256i, __m128i, __m128i, __m128i)
-DEFINE_M256_OP_M256_M128(__m256i, __m128i, srl_epi64,     __m256i, __m128i, __m128i, __m128i)
+//
+// Template for spicy 256-bit dest,source1,source2,source vector instructions
+//
 
-#define DEFINE_M256_OP_M256_M256(rettype, rettype128, name, arg1type, arg1type128, arg2type, arg2type128) \
+#define DEFINE_N256_OP_N256_N256_N256(rettype, name, intrin, arg1type, arg1, arg2type, arg2, arg3type, arg3, flags ) \
 \
-__forceinline __n128x2 _nn256_ ## name (__n128x2 a, const __n128x2 b) \
+__forceinline __n128x2 _nn256_ ## name (__n128x2 a, const __n128x2 b, const __n128x2 c) \
 { \
     __n128x2 T; \
-    T.val[0] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[0]), arg2type128 ## _from___n128(b.val[0]) ) ); \
-    T.val[1] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[1]), arg2type128 ## _from___n128(b.val[1]) ) ); \
+    T.val[0] = intrin (a.val[0], b.val[0], c.val[0]); \
+    T.val[0] = _nn_postprocess(T.val[0], a.val[0], b.val[0], flags); \
+    T.val[1] = intrin (a.val[1], b.val[1], c.val[1]); \
+    T.val[1] = _nn_postprocess(T.val[1], a.val[1], b.val[1], flags); \
     return T; \
 } \
 \
-__forceinline rettype _mm256_ ## name (arg1type arg1, arg2type arg2) \
+__forceinline rettype _mm256_ ## name (arg1type arg1, arg2type arg2, arg3type arg3) \
 { \
-    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128x2_from_ ## arg1type (arg1), __n128x2_from_ ## arg2type (arg2) ) ); \
+    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128x2_from_ ## arg1type (a), __n128x2_from_ ## arg2type (b), __n128x2_from_ ## arg3type (c) ) ); \
 }
 
-DEFINE_M256_OP_M256_M256(__m256i, __m128i, mulhi_epi16,   __m256i, __m128i, __m256i, __m128i)
-DEFINE_M256_OP_M256_M256(__m256i, __m128i, mulhi_epu16,   __m256i, __m128i, __m256i, __m128i)
-DEFINE_M256_OP_M256_M256(__m256i, __m128i, mulhrs_epi16,  __m256i, __m128i, __m256i, __m128i)
+// VPABS
 
-DEFINE_M256_OP_M256_M256(__m256i, __m128i, sad_epu8,      __m256i, __m128i, __m256i, __m128i)
-DEFINE_M256_OP_M256_M256(__m256i, __m128i, shuffle_epi8,  __m256i, __m128i, __m256i, __m128i)
+DEFINE_N256_OP_N256(     __m256i, abs_epi8,     vabsq_s8,       __m256i, a,             0)
+DEFINE_N256_OP_N256(     __m256i, abs_epi16,    vabsq_s16,      __m256i, a,             0)
+DEFINE_N256_OP_N256(     __m256i, abs_epi32,    vabsq_s32,      __m256i, a,             0)
 
-DEFINE_M256_OP_M256_M256(__m256i, __m128i, sllv_epi32,    __m256i, __m128i, __m256i, __m128i)
-DEFINE_M256_OP_M256_M256(__m256i, __m128i, sllv_epi64,    __m256i, __m128i, __m256i, __m128i)
+// VPAVG
 
-DEFINE_M256_OP_M256_M256(__m256i, __m128i, srav_epi32,    __m256i, __m128i, __m256i, __m128i)
+#undef _mm_avg_epu8
+#undef _mm_avg_epu16
 
-DEFINE_M256_OP_M256_M256(__m256i, __m128i, srlv_epi32,    __m256i, __m128i, __m256i, __m128i)
-DEFINE_M256_OP_M256_M256(__m256i, __m128i, srlv_epi64,    __m256i, __m128i, __m256i, __m128i)
+DEFINE_N256_OP_N256_N256(__m256i, avg_epu8,     vrhaddq_u8,     __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, avg_epu16,    vrhaddq_u16,    __m256i, a, __m256i, b, 0)
 
-DEFINE_M256_OP_M256_M256(__m256d, __m128d, addsub_pd,     __m256d, __m128d, __m256d, __m128d)
-DEFINE_M256_OP_M256_M256(__m256 , __m128 , addsub_ps,     __m256 , __m128 , __m256 , __m128 )
-DEFINE_M256_OP_M256_M256(__m256d, __m128d, hsub_pd,       __m256d, __m128d, __m256d, __m128d)
-DEFINE_M256_OP_M256_M256(__m256 , __m128 , hsub_ps,       __m256 , __m128 , __m256 , __m128 )
+// VPADD VPSUB
+
+DEFINE_N256_OP_N256_N256(__m256i, add_epi8,     neon_addq8,     __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, add_epi16,    neon_addq16,    __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, add_epi32,    neon_addq32,    __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, add_epi64,    neon_addq64,    __m256i, a, __m256i, b, 0)
+
+DEFINE_N256_OP_N256_N256(__m256i, sub_epi8,     neon_subq8,     __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, sub_epi16,    neon_subq16,    __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, sub_epi32,    neon_subq32,    __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, sub_epi64,    neon_subq64,    __m256i, a, __m256i, b, 0)
+
+// VPMULDQ VMULUDQ
+
+DEFINE_N256_OP_N256_N256(__m256i, mul_epi32,    sw_mulq_s32,    __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, mul_epu32,    sw_mulq_u32,    __m256i, a, __m256i, b, 0)
+
+// VPMULLO
+
+DEFINE_N256_OP_N256_N256(__m256i, mullo_epi16,  vmulq_s16,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, mullo_epi32,  vmulq_s32,      __m256i, a, __m256i, b, 0)
+
+// VPMADDWD VPMADDUBSW
 
+DEFINE_N256_OP_N256_N256(__m256i, madd_epi16,   sw_madd_epi16,  __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, maddubs_epi16,sw_maddubs_epi16,__m256i,a, __m256i, b, 0)
+
+// VPDPBUSD VPDPBUSDS VPDPWSSD VPDPWSSDS (AVX-VNNI)
 //
-// Template for double-wide 256-bit dest,source1,source2,imm8 vector instructions
+// Opt in by defining SOFT_INTRINSICS_AVX_VNNI before including this header, which
+// also makes cpuid_avx2.h report AVX-VNNI.  The u8 x s8 byte dot product is USDOT
+// when compiled for i8mm.  With only dotprod it is SDOT of (a - 128) and b plus a
+// second SDOT adding back 128 * b.  Otherwise it falls back to widening multiplies
+// and pairwise adds.  The 32-bit sums of 4 byte products cannot overflow, so the
+// saturating forms simply SQADD the sum into src.  The word form needs 64 bits
+// before saturating, since the two products alone can sum to 2^31.
+
+#if defined(SOFT_INTRINSICS_AVX_VNNI)
+
+__forceinline
+__n128 sw_dpbusd_epi32(__n128 src, __n128 a, __n128 b)
+{
+#if defined(__ARM_FEATURE_MATMUL_INT8)
+    return vusdotq_s32(src, a, b);
+#elif defined(__ARM_FEATURE_DOTPROD)
+    __n128 T = vdotq_s32(src, veorq_u8(a, vdupq_n_u8(0x80)), b);
+
+    return vsubq_s32(T, vdotq_s32(vdupq_n_s32(0), vdupq_n_s8(-128), b));
+#else
+    __n128 lo = vmulq_s16(vmovl_u8(vget_low_u8(a)), vmovl_s8(vget_low_s8(b)));
+    __n128 hi = vmulq_s16(vmovl_high_u8(a), vmovl_high_s8(b));
+
+    return vaddq_s32(src, vpaddq_s32(vpaddlq_s16(lo), vpaddlq_s16(hi)));
+#endif
+}
+
+__forceinline
+__n128 sw_dpbusds_epi32(__n128 src, __n128 a, __n128 b)
+{
+    return vqaddq_s32(src, sw_dpbusd_epi32(vdupq_n_s32(0), a, b));
+}
+
+__forceinline
+__n128 sw_dpwssd_epi32(__n128 src, __n128 a, __n128 b)
+{
+    return vaddq_s32(src, sw_madd_epi16(a, b));
+}
+
+__forceinline
+__n128 sw_dpwssds_epi32(__n128 src, __n128 a, __n128 b)
+{
+    __n128 lo = vpaddlq_s32(vmull_s16(vget_low_s16(a), vget_low_s16(b)));
+    __n128 hi = vpaddlq_s32(vmull_high_s16(a, b));
+
+    lo = vaddw_s32(lo, vget_low_s32(src));
+    hi = vaddw_high_s32(hi, src);
+
+    return vqmovn_high_s64(vqmovn_s64(lo), hi);
+}
+
+DEFINE_N128_OP_N128_N128_N128(__m128i, dpbusd_avx_epi32,  sw_dpbusd_epi32,  __m128i, a,   __m128i, b, __m128i, c, 0)
+DEFINE_N128_OP_N128_N128_N128(__m128i, dpbusds_avx_epi32, sw_dpbusds_epi32, __m128i, a,   __m128i, b, __m128i, c, 0)
+DEFINE_N128_OP_N128_N128_N128(__m128i, dpwssd_avx_epi32,  sw_dpwssd_epi32,  __m128i, a,   __m128i, b, __m128i, c, 0)
+DEFINE_N128_OP_N128_N128_N128(__m128i, dpwssds_avx_epi32, sw_dpwssds_epi32, __m128i, a,   __m128i, b, __m128i, c, 0)
+
+DEFINE_N256_OP_N256_N256_N256(__m256i, dpbusd_avx_epi32,  sw_dpbusd_epi32,  __m256i, a,   __m256i, b, __m256i, c, 0)
+DEFINE_N256_OP_N256_N256_N256(__m256i, dpbusds_avx_epi32, sw_dpbusds_epi32, __m256i, a,   __m256i, b, __m256i, c, 0)
+DEFINE_N256_OP_N256_N256_N256(__m256i, dpwssd_avx_epi32,  sw_dpwssd_epi32,  __m256i, a,   __m256i, b, __m256i, c, 0)
+DEFINE_N256_OP_N256_N256_N256(__m256i, dpwssds_avx_epi32, sw_dpwssds_epi32, __m256i, a,   __m256i, b, __m256i, c, 0)
+
+// the unmasked AVX512-VNNI spellings compute the same result
+
+#define _mm_dpbusd_epi32        _mm_dpbusd_avx_epi32
+#define _mm_dpbusds_epi32       _mm_dpbusds_avx_epi32
+#define _mm_dpwssd_epi32        _mm_dpwssd_avx_epi32
+#define _mm_dpwssds_epi32       _mm_dpwssds_avx_epi32
+#define _mm256_dpbusd_epi32     _mm256_dpbusd_avx_epi32
+#define _mm256_dpbusds_epi32    _mm256_dpbusds_avx_epi32
+#define _mm256_dpwssd_epi32     _mm256_dpwssd_avx_epi32
+#define _mm256_dpwssds_epi32    _mm256_dpwssds_avx_epi32
+
+#endif // SOFT_INTRINSICS_AVX_VNNI
+
+// VPSADBW VMPSADBW
 //
+// The 256-bit MPSADBW takes the low lane offsets from imm8[2:0] and the high lane offsets from imm8[5:3]
 
-#define DEFINE_M256_OP_M256_M256_IMM8(rettype, rettype128, name, arg1type, arg1type128, arg2type, arg2type128, hish) \
-\
-__forceinline __n128x2 _nn256_ ## name (__n128x2 a, const __n128x2 b, const int imm8) \
-{ \
-    __n128x2 T; \
-    T.val[0] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[0]), arg2type128 ## _from___n128(b.val[0]), imm8 ) ); \
-    T.val[1] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[1]), arg2type128 ## _from___n128(b.val[1]), imm8 >> hish ) ); \
-    return T; \
-} \
-\
-__forceinline rettype _mm256_ ## name (arg1type arg1, arg2type arg2, const int imm8) \
-{ \
-    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128x2_from_ ## arg1type (arg1), __n128x2_from_ ## arg2type (arg2), imm8 ) ); \
+DEFINE_N256_OP_N256_N256(__m256i, sad_epu8,     sw_sad_epu8,    __m256i, a, __m256i, b, 0)
+
+__forceinline
+__n256i _nn256_mpsadbw_epu8(__n256i a, __n256i b, const int imm8)
+{
+    __n256i T;
+
+    T.val[0] = _nn_mpsadbw_epu8(a.val[0], b.val[0], imm8);
+    T.val[1] = _nn_mpsadbw_epu8(a.val[1], b.val[1], imm8 >> 3);
+
+    return T;
 }
 
-DEFINE_M256_OP_M256_M256_IMM8(__m256d, __m128d, blend_pd,      __m256d, __m128d, __m256d, __m128d, 2)
-DEFINE_M256_OP_M256_M256_IMM8(__m256 , __m128 , blend_ps,      __m256 , __m128 , __m256 , __m128 , 4)
-DEFINE_M256_OP_M256_M256_IMM8(__m256i, __m128i, blend_epi16,   __m256i, __m128i, __m256i, __m128i, 0)
-// DEFINE_M256_OP_M256_M256_IMM8(__m256i, __m128i, blend_epi32,   __m256i, __m128i, __m256i, __m128i, 4)
+__forceinline
+__m256i _mm256_mpsadbw_epu8(__m256i a, __m256i b, const int imm8)
+{
+    return _nn256_castn256_si256( _nn256_mpsadbw_epu8(_nn256_castsi256_n256(a), _nn256_castsi256_n256(b), imm8) );
+}
 
-DEFINE_M256_OP_M256_M256_IMM8(__m256 , __m128 , dp_ps,         __m256 , __m128 , __m256 , __m128 , 0)
+// VPADDS VPADDUS
 
-DEFINE_M256_OP_M256_M256_IMM8(__m256d, __m128d, shuffle_pd,    __m256d, __m128d, __m256d, __m128d, 2)
-DEFINE_M256_OP_M256_M256_IMM8(__m256 , __m128 , shuffle_ps,    __m256 , __m128 , __m256 , __m128 , 0)
+DEFINE_N256_OP_N256_N256(__m256i, adds_epi8,    vqaddq_s8,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, adds_epi16,   vqaddq_s16,     __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, adds_epu8,    vqaddq_u8,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, adds_epu16,   vqaddq_u16,     __m256i, a, __m256i, b, 0)
+
+// VPHADDW VPHADDD VPHADDSW
+
+DEFINE_N256_OP_N256_N256(__m256i, hadd_epi16,   vpaddq_u16,     __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, hadd_epi32,   vpaddq_u32,     __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, hadds_epi16,  sw_hadds_epi16, __m256i, a, __m256i, b, 0);
+
+// VPSUBS VPSUBUS
+
+DEFINE_N256_OP_N256_N256(__m256i, subs_epi8,    vqsubq_s8,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, subs_epi16,   vqsubq_s16,     __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, subs_epu8,    vqsubq_u8,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, subs_epu16,   vqsubq_u16,     __m256i, a, __m256i, b, 0)
+
+// VPHSUBW VPHSUBD VPHSUBSW
+
+DEFINE_N256_OP_N256_N256(__m256i, hsub_epi16,   sw_psubq_u16,   __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, hsub_epi32,   sw_psubq_u32,   __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, hsubs_epi16,  sw_hsubs_epi16, __m256i, a, __m256i, b, 0)
+
+// VPAND  VPANDN  VPOR  VPXOR
+
+DEFINE_N256_OP_N256_N256(__m256i, and_si256,    neon_andq,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, andnot_si256, neon_bicq,      __m256i, b, __m256i, a, 0) // swap arg order
+DEFINE_N256_OP_N256_N256(__m256i, or_si256,     neon_orrq,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, xor_si256,    neon_eorq,      __m256i, a, __m256i, b, 0)
+
+// VANDPD VORPD VXORPD
+
+DEFINE_N256_OP_N256_N256(__m256d, and_pd,       vandq_s64,      __m256d, a, __m256d, b, 0)
+DEFINE_N256_OP_N256_N256(__m256d, andnot_pd,    vbicq_s64,      __m256d, b, __m256d, a, 0) // swap arg order
+DEFINE_N256_OP_N256_N256(__m256d, or_pd,        vorrq_s64,      __m256d, a, __m256d, b, 0)
+DEFINE_N256_OP_N256_N256(__m256d, xor_pd,       veorq_s64,      __m256d, a, __m256d, b, 0)
+
+// VANDPS VORPS VXORPS
+
+DEFINE_N256_OP_N256_N256(__m256,  and_ps,       vandq_s32,      __m256,  a, __m256,  b, 0)
+DEFINE_N256_OP_N256_N256(__m256,  andnot_ps,    vbicq_s32,      __m256,  b, __m256,  a, 0) // swap arg order
+DEFINE_N256_OP_N256_N256(__m256,  or_ps,        vorrq_s32,      __m256,  a, __m256,  b, 0)
+DEFINE_N256_OP_N256_N256(__m256,  xor_ps,       veorq_s32,      __m256,  a, __m256,  b, 0)
+
+// VADDPD VSUBPD VMULPD VDIVPD
+
+DEFINE_N256_OP_N256_N256(__m256d, add_pd,       neon_faddq64,   __m256d, a, __m256d, b, 0)
+DEFINE_N256_OP_N256_N256(__m256d, sub_pd,       neon_fsubq64,   __m256d, a, __m256d, b, 0)
+DEFINE_N256_OP_N256_N256(__m256d, mul_pd,       neon_fmulq64,   __m256d, a, __m256d, b, 0)
+DEFINE_N256_OP_N256_N256(__m256d, div_pd,       neon_fdivq64,   __m256d, a, __m256d, b, _IF_DIV_F64)
+
+// VADDPD VSUBPD VMULPD VDIVPD
+
+DEFINE_N256_OP_N256_N256(__m256,  add_ps,       neon_faddq32,   __m256,  a, __m256,  b, 0)
+DEFINE_N256_OP_N256_N256(__m256,  sub_ps,       neon_fsubq32,   __m256,  a, __m256,  b, 0)
+DEFINE_N256_OP_N256_N256(__m256,  mul_ps,       neon_fmulq32,   __m256,  a, __m256,  b, 0)
+DEFINE_N256_OP_N256_N256(__m256,  div_ps,       neon_fdivq32,   __m256,  a, __m256,  b, _IF_DIV_F32)
+
+// VPMINS VPMAXS
+
+DEFINE_N256_OP_N256_N256(__m256i, min_epi8,     vminq_s8,       __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, min_epi16,    vminq_s16,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, min_epi32,    vminq_s32,      __m256i, a, __m256i, b, 0)
+
+DEFINE_N256_OP_N256_N256(__m256i, max_epi8,     vmaxq_s8,       __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, max_epi16,    vmaxq_s16,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, max_epi32,    vmaxq_s32,      __m256i, a, __m256i, b, 0)
+
+// VPMINU VPMINU
+
+DEFINE_N256_OP_N256_N256(__m256i, min_epu8,     vminq_u8,       __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, min_epu16,    vminq_u16,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, min_epu32,    vminq_u32,      __m256i, a, __m256i, b, 0)
+
+DEFINE_N256_OP_N256_N256(__m256i, max_epu8,     vmaxq_u8,       __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, max_epu16,    vmaxq_u16,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, max_epu32,    vmaxq_u32,      __m256i, a, __m256i, b, 0)
+
+// VMIN VMAX
+
+DEFINE_N256_OP_N256_N256(__m256d, min_pd,       vminq_f64,      __m256d, a, __m256d, b, _IF_MINMAX_F64)
+DEFINE_N256_OP_N256_N256(__m256d, max_pd,       vmaxq_f64,      __m256d, a, __m256d, b, _IF_MINMAX_F64)
+
+DEFINE_N256_OP_N256_N256(__m256,  min_ps,       vminq_f32,      __m256,  a, __m256,  b, _IF_MINMAX_F32)
+DEFINE_N256_OP_N256_N256(__m256,  max_ps,       vmaxq_f32,      __m256,  a, __m256,  b, _IF_MINMAX_F32)
+
+// VHADDPD VHADDPS
+
+DEFINE_N256_OP_N256_N256(__m256d, hadd_pd,      vpaddq_f64,     __m256d, a, __m256d, b, 0);
+DEFINE_N256_OP_N256_N256(__m256,  hadd_ps,      vpaddq_f32,     __m256,  a, __m256,  b, 0);
+
+// VPACKSSWB VPACKSSDW VPACKUSWB VPACKUSDW
+// VPUNPCKL VPUNPCKH VUNPCKLPS VUNPCKHPS VUNPCKLPD VUNPCKHPD
+//
+// These operate independently within each 128-bit lane, so the low half of the
+// result only ever sees the low halves of the sources.  Reorder across lanes
+// with _mm256_permute4x64_epi64(x, 0xD8) when a linear result is needed.
+
+DEFINE_N256_OP_N256_N256(__m256i, packs_epi16,    sw_packs_epi16,  __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, packs_epi32,    sw_packs_epi32,  __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, packus_epi16,   sw_packus_epi16, __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, packus_epi32,   sw_packus_epi32, __m256i, a, __m256i, b, 0)
+
+DEFINE_N256_OP_N256_N256(__m256i, unpacklo_epi8,  vzip1q_u8,       __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, unpacklo_epi16, vzip1q_u16,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, unpacklo_epi32, vzip1q_u32,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, unpacklo_epi64, vzip1q_u64,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, unpackhi_epi8,  vzip2q_u8,       __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, unpackhi_epi16, vzip2q_u16,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, unpackhi_epi32, vzip2q_u32,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, unpackhi_epi64, vzip2q_u64,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256,  unpacklo_ps,    vzip1q_u32,      __m256,  a, __m256,  b, 0)
+DEFINE_N256_OP_N256_N256(__m256,  unpackhi_ps,    vzip2q_u32,      __m256,  a, __m256,  b, 0)
+DEFINE_N256_OP_N256_N256(__m256d, unpacklo_pd,    vzip1q_u64,      __m256d, a, __m256d, b, 0)
+DEFINE_N256_OP_N256_N256(__m256d, unpackhi_pd,    vzip2q_u64,      __m256d, a, __m256d, b, 0)
+
+// VCMPPS VCMPPD
+
+#undef _mm256_cmp_ps
+#undef _mm256_cmp_pd
+
+__forceinline
+__n128x2 _nn256_cmp_ps(__n128x2 a, __n128x2 b, const int imm8)
+{
+    __n128x2 T;
+
+    T.val[0] = _nn128_cmp_ps(a.val[0], b.val[0], imm8);
+    T.val[1] = _nn128_cmp_ps(a.val[1], b.val[1], imm8);
+
+    return T;
+}
+
+__forceinline
+__n128x2 _nn256_cmp_pd(__n128x2 a, __n128x2 b, const int imm8)
+{
+    __n128x2 T;
+
+    T.val[0] = _nn128_cmp_pd(a.val[0], b.val[0], imm8);
+    T.val[1] = _nn128_cmp_pd(a.val[1], b.val[1], imm8);
+
+    return T;
+}
+
+__forceinline
+__m256 _mm256_cmp_ps(__m256 a, __m256 b, const int imm8)
+{
+    return _nn256_castn256_ps( _nn256_cmp_ps(_nn256_castps_n256(a), _nn256_castps_n256(b), imm8 & 0x1F) );
+}
+
+__forceinline
+__m256d _mm256_cmp_pd(__m256d a, __m256d b, const int imm8)
+{
+    return _nn256_castn256_pd( _nn256_cmp_pd(_nn256_castpd_n256(a), _nn256_castpd_n256(b), imm8 & 0x1F) );
+}
+
+// VPSHUFB
+
+DEFINE_N256_OP_N256_N256(__m256i, shuffle_epi8, sw_shuffle_epi8, __m256i, a, __m256i, b, 0)
+
+// VPOPCNTB VPOPCNTQ (native twins only)
+
+__forceinline
+__n128x2 _nn256_popcount_epi8(__n128x2 a)
+{
+    __n128x2 T;
+
+    T.val[0] = sw_popcount_epi8(a.val[0]);
+    T.val[1] = sw_popcount_epi8(a.val[1]);
+
+    return T;
+}
+
+__forceinline
+__n128x2 _nn256_popcount_epi64(__n128x2 a)
+{
+    __n128x2 T;
+
+    T.val[0] = sw_popcount_epi64(a.val[0]);
+    T.val[1] = sw_popcount_epi64(a.val[1]);
+
+    return T;
+}
+
+// VPCMPEQ VPCMPGT
+
+DEFINE_N256_OP_N256_N256(__m256i, cmpeq_epi8,   vceqq_u8,       __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, cmpeq_epi16,  vceqq_u16,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, cmpeq_epi32,  vceqq_u32,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, cmpeq_epi64,  vceqq_u64,      __m256i, a, __m256i, b, 0)
+
+DEFINE_N256_OP_N256_N256(__m256i, cmpgt_epi8,   vcgtq_s8,       __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, cmpgt_epi16,  vcgtq_s16,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, cmpgt_epi32,  vcgtq_s32,      __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, cmpgt_epi64,  vcgtq_s64,      __m256i, a, __m256i, b, 0)
+
+// VPMOVMSKB VMOVMSKPD VMOVMSKPS
+
+__forceinline
+int _nn256_movemask_epi8(__n256i a)
+{
+    // same as the 128-bit version except both halves are reduced together
+
+    __n128 T = vpaddq_u8(sw_movemask_weights_epi8(a.val[0]), sw_movemask_weights_epi8(a.val[1]));
+
+    T = vpaddq_u8(T, T);     // 16 partial sums -> 8 -> 4 mask bytes
+    T = vpaddq_u8(T, T);
+
+    return (int)vgetq_lane_u32(T, 0);
+}
+
+__forceinline
+int _nn256_movemask_pd(__n256d a)
+{
+    const __n128 Weights0 = vcombine_u64(vcreate_u64(1), vcreate_u64(2));
+    const __n128 Weights1 = vcombine_u64(vcreate_u64(4), vcreate_u64(8));
+
+    __n128 T0 = neon_andq(neon_sshriq64(a.val[0], 63), Weights0);
+    __n128 T1 = neon_andq(neon_sshriq64(a.val[1], 63), Weights1);
+
+    return (int)vaddvq_u64(neon_orrq(T0, T1));
+}
+
+__forceinline
+int _nn256_movemask_ps(__n256 a)
+{
+    const __n128 Weights0 = vcombine_u32(vcreate_u32(0x0000000200000001ull), vcreate_u32(0x0000000800000004ull));
+    const __n128 Weights1 = vcombine_u32(vcreate_u32(0x0000002000000010ull), vcreate_u32(0x0000008000000040ull));
+
+    __n128 T0 = neon_andq(neon_sshriq32(a.val[0], 31), Weights0);
+    __n128 T1 = neon_andq(neon_sshriq32(a.val[1], 31), Weights1);
+
+    return (int)vaddvq_u32(neon_orrq(T0, T1));
+}
+
+__forceinline
+int _mm256_movemask_epi8(__m256i a)
+{
+    return _nn256_movemask_epi8(_nn256_castsi256_n256(a));
+}
+
+__forceinline
+int _mm256_movemask_pd(__m256d a)
+{
+    return _nn256_movemask_pd(_nn256_castpd_n256(a));
+}
+
+__forceinline
+int _mm256_movemask_ps(__m256 a)
+{
+    return _nn256_movemask_ps(_nn256_castps_n256(a));
+}
+
+// VPTEST VTESTPS VTESTPD
+//
+// VTESTPS and VTESTPD only look at the sign bit of each element.  For floats the
+// UMAXV across dwords has bit 31 set if any lane does, so no extra masking needed.
+
+__forceinline
+int sw_test_sign32_zero_n128(__n128 a)
+{
+    return (vmaxvq_u32(a) >> 31) == 0;
+}
+
+__forceinline
+int sw_test_sign64_zero_n128(__n128 a)
+{
+    const __n128 SignMask = neon_dupqr64(0x8000000000000000ull);
+
+    return sw_test_zero_n128(neon_andq(a, SignMask));
+}
+
+__forceinline
+int _nn_testz_ps(__n128 a, __n128 b)    { return sw_test_sign32_zero_n128(neon_andq(a, b)); }
+
+__forceinline
+int _nn_testc_ps(__n128 a, __n128 b)    { return sw_test_sign32_zero_n128(neon_bicq(b, a)); }
+
+__forceinline
+int _nn_testnzc_ps(__n128 a, __n128 b)  { return !_nn_testz_ps(a, b) && !_nn_testc_ps(a, b); }
+
+__forceinline
+int _nn_testz_pd(__n128d a, __n128d b)  { return sw_test_sign64_zero_n128(neon_andq(a, b)); }
+
+__forceinline
+int _nn_testc_pd(__n128d a, __n128d b)  { return sw_test_sign64_zero_n128(neon_bicq(b, a)); }
+
+__forceinline
+int _nn_testnzc_pd(__n128d a, __n128d b){ return !_nn_testz_pd(a, b) && !_nn_testc_pd(a, b); }
+
+// the 256-bit forms OR the two halves together before the single reduction
+
+__forceinline
+int _nn256_testz_si256(__n256i a, __n256i b)
+{
+    return sw_test_zero_n128(neon_orrq(neon_andq(a.val[0], b.val[0]), neon_andq(a.val[1], b.val[1])));
+}
+
+__forceinline
+int _nn256_testc_si256(__n256i a, __n256i b)
+{
+    return sw_test_zero_n128(neon_orrq(neon_bicq(b.val[0], a.val[0]), neon_bicq(b.val[1], a.val[1])));
+}
+
+__forceinline
+int _nn256_testnzc_si256(__n256i a, __n256i b)
+{
+    return !_nn256_testz_si256(a, b) && !_nn256_testc_si256(a, b);
+}
+
+__forceinline
+int _nn256_testz_ps(__n256 a, __n256 b)
+{
+    return sw_test_sign32_zero_n128(neon_orrq(neon_andq(a.val[0], b.val[0]), neon_andq(a.val[1], b.val[1])));
+}
+
+__forceinline
+int _nn256_testc_ps(__n256 a, __n256 b)
+{
+    return sw_test_sign32_zero_n128(neon_orrq(neon_bicq(b.val[0], a.val[0]), neon_bicq(b.val[1], a.val[1])));
+}
+
+__forceinline
+int _nn256_testnzc_ps(__n256 a, __n256 b)
+{
+    return !_nn256_testz_ps(a, b) && !_nn256_testc_ps(a, b);
+}
+
+__forceinline
+int _nn256_testz_pd(__n256d a, __n256d b)
+{
+    return sw_test_sign64_zero_n128(neon_orrq(neon_andq(a.val[0], b.val[0]), neon_andq(a.val[1], b.val[1])));
+}
+
+__forceinline
+int _nn256_testc_pd(__n256d a, __n256d b)
+{
+    return sw_test_sign64_zero_n128(neon_orrq(neon_bicq(b.val[0], a.val[0]), neon_bicq(b.val[1], a.val[1])));
+}
+
+__forceinline
+int _nn256_testnzc_pd(__n256d a, __n256d b)
+{
+    return !_nn256_testz_pd(a, b) && !_nn256_testc_pd(a, b);
+}
+
+//
+// Template for the SSE/AVX test wrappers around the native twins
+//
+
+#define DEFINE_TEST_FLAGS(width, name, argtype, nnname) \
+\
+__forceinline int _mm ## width ## _ ## name (argtype a, argtype b) \
+{ \
+    return _nn ## width ## _ ## name ( __ ## nnname ## _from_ ## argtype (a), __ ## nnname ## _from_ ## argtype (b) ); \
+}
+
+DEFINE_TEST_FLAGS(   , testz_ps,      __m128,  n128)
+DEFINE_TEST_FLAGS(   , testc_ps,      __m128,  n128)
+DEFINE_TEST_FLAGS(   , testnzc_ps,    __m128,  n128)
+DEFINE_TEST_FLAGS(   , testz_pd,      __m128d, n128)
+DEFINE_TEST_FLAGS(   , testc_pd,      __m128d, n128)
+DEFINE_TEST_FLAGS(   , testnzc_pd,    __m128d, n128)
+
+DEFINE_TEST_FLAGS(256, testz_si256,   __m256i, n128x2)
+DEFINE_TEST_FLAGS(256, testc_si256,   __m256i, n128x2)
+DEFINE_TEST_FLAGS(256, testnzc_si256, __m256i, n128x2)
+DEFINE_TEST_FLAGS(256, testz_ps,      __m256,  n128x2)
+DEFINE_TEST_FLAGS(256, testc_ps,      __m256,  n128x2)
+DEFINE_TEST_FLAGS(256, testnzc_ps,    __m256,  n128x2)
+DEFINE_TEST_FLAGS(256, testz_pd,      __m256d, n128x2)
+DEFINE_TEST_FLAGS(256, testc_pd,      __m256d, n128x2)
+DEFINE_TEST_FLAGS(256, testnzc_pd,    __m256d, n128x2)
+
+// VSQRTPD VSQRTPS
+
+__forceinline
+__n128x2 _nn256_sqrt_pd(__n128x2 a)
+{
+    __n128x2 T;
+
+    T.val[0] = neon_fsqrtq64(a.val[0]);
+    T.val[1] = neon_fsqrtq64(a.val[1]);
+
+    T.val[0] = _nn_postprocess(T.val[0], a.val[0], a.val[0], _IF_SQRT_F64);
+    T.val[1] = _nn_postprocess(T.val[1], a.val[1], a.val[1], _IF_SQRT_F64);
+
+    return T;
+}
+
+__forceinline
+__n128x2 _nn256_sqrt_ps(__n128x2 a)
+{
+    __n128x2 T;
+
+    T.val[0] = neon_fsqrtq32(a.val[0]);
+    T.val[1] = neon_fsqrtq32(a.val[1]);
+
+    T.val[0] = _nn_postprocess(T.val[0], a.val[0], a.val[0], _IF_SQRT_F32);
+    T.val[1] = _nn_postprocess(T.val[1], a.val[1], a.val[1], _IF_SQRT_F32);
+
+    return T;
+}
+
+__forceinline
+__m256d _mm256_sqrt_pd(__m256d a)
+{
+    return _nn256_castn256_pd( _nn256_sqrt_pd(_nn256_castpd_n256(a)) );
+}
+
+__forceinline
+__m256 _mm256_sqrt_ps(__m256 a)
+{
+    return _nn256_castn256_ps( _nn256_sqrt_ps(_nn256_castps_n256(a)) );
+}
+
+// VROUNDPD VROUNDPS
+
+#undef _mm256_round_pd
+#undef _mm256_round_ps
+#undef _mm256_floor_pd
+#undef _mm256_floor_ps
+#undef _mm256_ceil_pd
+#undef _mm256_ceil_ps
+
+__forceinline
+__n128x2 _nn256_round_pd(__n128x2 a, const int imm8)
+{
+    __n128x2 T;
+
+    T.val[0] = sw_round_pd(a.val[0], imm8);
+    T.val[1] = sw_round_pd(a.val[1], imm8);
+
+    return T;
+}
+
+__forceinline
+__n128x2 _nn256_round_ps(__n128x2 a, const int imm8)
+{
+    __n128x2 T;
+
+    T.val[0] = sw_round_ps(a.val[0], imm8);
+    T.val[1] = sw_round_ps(a.val[1], imm8);
+
+    return T;
+}
+
+__forceinline
+__m256d _mm256_round_pd(__m256d a, const int imm8)
+{
+    return _nn256_castn256_pd( _nn256_round_pd(_nn256_castpd_n256(a), imm8) );
+}
+
+__forceinline
+__m256 _mm256_round_ps(__m256 a, const int imm8)
+{
+    return _nn256_castn256_ps( _nn256_round_ps(_nn256_castps_n256(a), imm8) );
+}
+
+#define _nn256_floor_pd(a)      _nn256_round_pd((a), _MM_FROUND_FLOOR)
+#define _nn256_floor_ps(a)      _nn256_round_ps((a), _MM_FROUND_FLOOR)
+#define _nn256_ceil_pd(a)       _nn256_round_pd((a), _MM_FROUND_CEIL)
+#define _nn256_ceil_ps(a)       _nn256_round_ps((a), _MM_FROUND_CEIL)
+
+#define _mm256_floor_pd(a)      _mm256_round_pd((a), _MM_FROUND_FLOOR)
+#define _mm256_floor_ps(a)      _mm256_round_ps((a), _MM_FROUND_FLOOR)
+#define _mm256_ceil_pd(a)       _mm256_round_pd((a), _MM_FROUND_CEIL)
+#define _mm256_ceil_ps(a)       _mm256_round_ps((a), _MM_FROUND_CEIL)
+
+// VFMADD VFMSUB VFNMADD VFNMSUB VFMADDSUB VFMSUBADD (FMA3)
+
+DEFINE_N256_OP_N256_N256_N256(__m256d, fmadd_pd,    sw_fmadd_pd,    __m256d, a, __m256d, b, __m256d, c,  0)
+DEFINE_N256_OP_N256_N256_N256(__m256,  fmadd_ps,    sw_fmadd_ps,    __m256,  a, __m256,  b, __m256,  c,  0)
+DEFINE_N256_OP_N256_N256_N256(__m256d, fmsub_pd,    sw_fmsub_pd,    __m256d, a, __m256d, b, __m256d, c,  0)
+DEFINE_N256_OP_N256_N256_N256(__m256,  fmsub_ps,    sw_fmsub_ps,    __m256,  a, __m256,  b, __m256,  c,  0)
+DEFINE_N256_OP_N256_N256_N256(__m256d, fnmadd_pd,   sw_fnmadd_pd,   __m256d, a, __m256d, b, __m256d, c,  0)
+DEFINE_N256_OP_N256_N256_N256(__m256,  fnmadd_ps,   sw_fnmadd_ps,   __m256,  a, __m256,  b, __m256,  c,  0)
+DEFINE_N256_OP_N256_N256_N256(__m256d, fnmsub_pd,   sw_fnmsub_pd,   __m256d, a, __m256d, b, __m256d, c,  0)
+DEFINE_N256_OP_N256_N256_N256(__m256,  fnmsub_ps,   sw_fnmsub_ps,   __m256,  a, __m256,  b, __m256,  c,  0)
+DEFINE_N256_OP_N256_N256_N256(__m256d, fmaddsub_pd, sw_fmaddsub_pd, __m256d, a, __m256d, b, __m256d, c,  0)
+DEFINE_N256_OP_N256_N256_N256(__m256,  fmaddsub_ps, sw_fmaddsub_ps, __m256,  a, __m256,  b, __m256,  c,  0)
+DEFINE_N256_OP_N256_N256_N256(__m256d, fmsubadd_pd, sw_fmsubadd_pd, __m256d, a, __m256d, b, __m256d, c,  0)
+DEFINE_N256_OP_N256_N256_N256(__m256,  fmsubadd_ps, sw_fmsubadd_ps, __m256,  a, __m256,  b, __m256,  c,  0)
+
+// VBLENDV
+
+DEFINE_N256_OP_N256_N256_N256(__m256i, blendv_epi8,  sw_blendv_epi8, __m256i, a, __m256i, b, __m256i, c,    0)
+DEFINE_N256_OP_N256_N256_N256(__m256d, blendv_pd,    sw_blendv_pd,   __m256d, a, __m256d, b, __m256d, c,    0)
+DEFINE_N256_OP_N256_N256_N256(__m256,  blendv_ps,    sw_blendv_ps,   __m256,  a, __m256,  b, __m256,  c,    0)
+
+// BROADCAST variants
+
+__forceinline __n128 sw_broadcastb_epi8(__n128 const a)      { __n128 T = vdupq_laneq_u8 (a, 0); return T; }
+__forceinline __n128 sw_broadcastw_epi16(__n128 const a)     { __n128 T = vdupq_laneq_u16(a, 0); return T; }
+__forceinline __n128 sw_broadcastd_epi32(__n128 const a)     { __n128 T = vdupq_laneq_u32(a, 0); return T; }
+__forceinline __n128 sw_broadcastq_epi64(__n128 const a)     { __n128 T = vdupq_laneq_u64(a, 0); return T; }
+__forceinline __n128 sw_broadcastsd_pd(__n128 const a)       { __n128 T = vdupq_laneq_s64(a, 0); return T; }
+__forceinline __n128 sw_broadcastss_ps(__n128 const a)       { __n128 T = vdupq_laneq_s32(a, 0); return T; }
+__forceinline __n128 sw_broadcastsi128_si256(__n128 const a) { __n128 T = a;                     return T; }
+
+DEFINE_N256_OP_N128(__m256i, broadcastb_epi8,      sw_broadcastb_epi8,      __m128i, a, _IF_DUP_128)
+DEFINE_N256_OP_N128(__m256i, broadcastw_epi16,     sw_broadcastw_epi16,     __m128i, a, _IF_DUP_128)
+DEFINE_N256_OP_N128(__m256i, broadcastd_epi32,     sw_broadcastd_epi32,     __m128i, a, _IF_DUP_128)
+DEFINE_N256_OP_N128(__m256i, broadcastq_epi64,     sw_broadcastq_epi64,     __m128i, a, _IF_DUP_128)
+DEFINE_N256_OP_N128(__m256d, broadcastsd_pd,       sw_broadcastsd_pd,       __m128d, a, _IF_DUP_128)
+DEFINE_N256_OP_N128(__m256,  broadcastss_ps,       sw_broadcastss_ps,       __m128,  a, _IF_DUP_128)
+DEFINE_N256_OP_N128(__m256i, broadcastsi128_si256, sw_broadcastsi128_si256, __m128i, a, _IF_DUP_128)
+
+// VEXTRACTF128 VEXTRACTI128 VINSERTF128 VINSERTI128
+//
+// With __n128x2 these are a plain register move of val[0] or val[1].
+
+__forceinline
+__n128 _nn256_extractf128(__n128x2 a, const int imm8)
+{
+    return a.val[imm8 & 1];
+}
+
+__forceinline
+__n128x2 _nn256_insertf128(__n128x2 a, __n128 b, const int imm8)
+{
+    a.val[imm8 & 1] = b;
+    return a;
+}
+
+#define _nn256_extractf128_pd       _nn256_extractf128
+#define _nn256_extractf128_ps       _nn256_extractf128
+#define _nn256_extractf128_si256    _nn256_extractf128
+#define _nn256_extracti128_si256    _nn256_extractf128
+#define _nn256_insertf128_pd        _nn256_insertf128
+#define _nn256_insertf128_ps        _nn256_insertf128
+#define _nn256_insertf128_si256     _nn256_insertf128
+#define _nn256_inserti128_si256     _nn256_insertf128
+
+#define DEFINE_EXTRACT128(rettype, name, argtype) \
+\
+__forceinline rettype _mm256_ ## name (argtype a, const int imm8) \
+{ \
+    return rettype ## _from___n128 ( _nn256_extractf128 ( __n128x2_from_ ## argtype (a), imm8 ) ); \
+}
+
+#define DEFINE_INSERT128(rettype, name, argtype) \
+\
+__forceinline rettype _mm256_ ## name (rettype a, argtype b, const int imm8) \
+{ \
+    return rettype ## _from___n128x2 ( _nn256_insertf128 ( __n128x2_from_ ## rettype (a), __n128_from_ ## argtype (b), imm8 ) ); \
+}
+
+DEFINE_EXTRACT128(__m128d, extractf128_pd,    __m256d)
+DEFINE_EXTRACT128(__m128,  extractf128_ps,    __m256)
+DEFINE_EXTRACT128(__m128i, extractf128_si256, __m256i)
+DEFINE_EXTRACT128(__m128i, extracti128_si256, __m256i)
+
+DEFINE_INSERT128(__m256d,  insertf128_pd,     __m128d)
+DEFINE_INSERT128(__m256,   insertf128_ps,     __m128)
+DEFINE_INSERT128(__m256i,  insertf128_si256,  __m128i)
+DEFINE_INSERT128(__m256i,  inserti128_si256,  __m128i)
+
+// VINSERTF128 forms which build a 256-bit vector from two 128-bit halves
+
+#define DEFINE_SET_M128(rettype, suffix, argtype) \
+\
+__forceinline rettype _mm256_set_ ## suffix (argtype hi, argtype lo) \
+{ \
+    __n128x2 T; \
+    T.val[0] = __n128_from_ ## argtype (lo); \
+    T.val[1] = __n128_from_ ## argtype (hi); \
+    return rettype ## _from___n128x2 (T); \
+} \
+\
+__forceinline rettype _mm256_setr_ ## suffix (argtype lo, argtype hi) \
+{ \
+    return _mm256_set_ ## suffix (hi, lo); \
+}
+
+DEFINE_SET_M128(__m256,  m128,  __m128)
+DEFINE_SET_M128(__m256d, m128d, __m128d)
+DEFINE_SET_M128(__m256i, m128i, __m128i)
+
+__forceinline
+__n128x2 sw_loadu2_n128(void const * hiaddr, void const * loaddr)
+{
+    __n128x2 T;
+
+    T.val[0] = vld1q_u8((unsigned __int8 const *)loaddr);
+    T.val[1] = vld1q_u8((unsigned __int8 const *)hiaddr);
+
+    return T;
+}
+
+__forceinline
+void sw_storeu2_n128(void * hiaddr, void * loaddr, __n128x2 a)
+{
+    vst1q_u8((unsigned __int8 *)loaddr, a.val[0]);
+    vst1q_u8((unsigned __int8 *)hiaddr, a.val[1]);
+}
+
+__forceinline
+__m256 _mm256_loadu2_m128(float const * hiaddr, float const * loaddr)
+{
+    return _nn256_castn256_ps( sw_loadu2_n128(hiaddr, loaddr) );
+}
+
+__forceinline
+__m256d _mm256_loadu2_m128d(double const * hiaddr, double const * loaddr)
+{
+    return _nn256_castn256_pd( sw_loadu2_n128(hiaddr, loaddr) );
+}
+
+__forceinline
+__m256i _mm256_loadu2_m128i(__m128i const * hiaddr, __m128i const * loaddr)
+{
+    return _nn256_castn256_si256( sw_loadu2_n128(hiaddr, loaddr) );
+}
+
+__forceinline
+void _mm256_storeu2_m128(float * hiaddr, float * loaddr, __m256 a)
+{
+    sw_storeu2_n128(hiaddr, loaddr, _nn256_castps_n256(a));
+}
+
+__forceinline
+void _mm256_storeu2_m128d(double * hiaddr, double * loaddr, __m256d a)
+{
+    sw_storeu2_n128(hiaddr, loaddr, _nn256_castpd_n256(a));
+}
+
+__forceinline
+void _mm256_storeu2_m128i(__m128i * hiaddr, __m128i * loaddr, __m256i a)
+{
+    sw_storeu2_n128(hiaddr, loaddr, _nn256_castsi256_n256(a));
+}
+
+// VPEXTRB VPEXTRW VPEXTRD VPEXTRQ VPINSRB VPINSRW VPINSRD VPINSRQ
+//
+// Element index bits above the 128-bit lane select val[0] or val[1], then the
+// 128-bit macros above do the UMOV/INS.  Like the 128-bit forms, imm8 must be
+// a constant.
+
+__forceinline
+__n128x2 sw_insert_half_n256(__n128x2 a, __n128 half, const int hi)
+{
+    a.val[hi & 1] = half;
+    return a;
+}
+
+#define _nn256_extract_epi8(a, imm8)    _nn_extract_epi8 ((a).val[((imm8) >> 4) & 1], imm8)
+#define _nn256_extract_epi16(a, imm8)   _nn_extract_epi16((a).val[((imm8) >> 3) & 1], imm8)
+#define _nn256_extract_epi32(a, imm8)   _nn_extract_epi32((a).val[((imm8) >> 2) & 1], imm8)
+#define _nn256_extract_epi64(a, imm8)   _nn_extract_epi64((a).val[((imm8) >> 1) & 1], imm8)
+
+#define _nn256_insert_epi8(a, i, imm8)  sw_insert_half_n256((a), _nn_insert_epi8 ((a).val[((imm8) >> 4) & 1], i, imm8), (imm8) >> 4)
+#define _nn256_insert_epi16(a, i, imm8) sw_insert_half_n256((a), _nn_insert_epi16((a).val[((imm8) >> 3) & 1], i, imm8), (imm8) >> 3)
+#define _nn256_insert_epi32(a, i, imm8) sw_insert_half_n256((a), _nn_insert_epi32((a).val[((imm8) >> 2) & 1], i, imm8), (imm8) >> 2)
+#define _nn256_insert_epi64(a, i, imm8) sw_insert_half_n256((a), _nn_insert_epi64((a).val[((imm8) >> 1) & 1], i, imm8), (imm8) >> 1)
+
+#define _mm256_extract_epi8(a, imm8)    _nn256_extract_epi8 (__n128x2_from___m256i(a), imm8)
+#define _mm256_extract_epi16(a, imm8)   _nn256_extract_epi16(__n128x2_from___m256i(a), imm8)
+#define _mm256_extract_epi32(a, imm8)   _nn256_extract_epi32(__n128x2_from___m256i(a), imm8)
+#define _mm256_extract_epi64(a, imm8)   _nn256_extract_epi64(__n128x2_from___m256i(a), imm8)
+
+#define _mm256_insert_epi8(a, i, imm8)  __m256i_from___n128x2(_nn256_insert_epi8 (__n128x2_from___m256i(a), i, imm8))
+#define _mm256_insert_epi16(a, i, imm8) __m256i_from___n128x2(_nn256_insert_epi16(__n128x2_from___m256i(a), i, imm8))
+#define _mm256_insert_epi32(a, i, imm8) __m256i_from___n128x2(_nn256_insert_epi32(__n128x2_from___m256i(a), i, imm8))
+#define _mm256_insert_epi64(a, i, imm8) __m256i_from___n128x2(_nn256_insert_epi64(__n128x2_from___m256i(a), i, imm8))
+
+// VPERF2F128
+
+__forceinline
+__n256i _nn256_permute2f128_si256 (__n256i a, __n256i b, const int imm8)
+{
+    __n256i T;
+
+    T.val[0] = (imm8 & 0x08) ? _nn_set1_ps(0.0f) : ((imm8 & 0x02) ? b.val[(imm8 & 0x01) >> 0] : a.val[(imm8 & 0x01) >> 0]);
+    T.val[1] = (imm8 & 0x80) ? _nn_set1_ps(0.0f) : ((imm8 & 0x20) ? b.val[(imm8 & 0x10) >> 4] : a.val[(imm8 & 0x10) >> 4]);
+
+    return T;
+}
+
+__forceinline
+__m256i _mm256_permute2f128_si256 (__m256i a, __m256i b, const int imm8)
+{
+    return _nn256_castn256_si256( _nn256_permute2f128_si256(_nn256_castsi256_n256(a), _nn256_castsi256_n256(b), imm8) );
+}
+
+__forceinline
+__m256d _mm256_permute2f128_pd (__m256d a, __m256d b, const int imm8)
+{
+    return _nn256_castn256_pd( _nn256_permute2f128_si256(_nn256_castpd_n256(a), _nn256_castpd_n256(b), imm8) );
+}
+
+__forceinline
+__m256 _mm256_permute2f128_ps (__m256 a, __m256 b, const int imm8)
+{
+    return _nn256_castn256_ps( _nn256_permute2f128_si256(_nn256_castps_n256(a), _nn256_castps_n256(b), imm8) );
+}
+
+// VPERMILPD VPERMILPS
+
+__forceinline
+__m256d _mm256_permute_pd(__m256d a, const int imm8)
+{
+    __m256d T =
+    {
+        a.m256d_f64[0 + ((imm8 >> 0) & 1)],
+        a.m256d_f64[0 + ((imm8 >> 1) & 1)],
+        a.m256d_f64[2 + ((imm8 >> 2) & 1)],
+        a.m256d_f64[2 + ((imm8 >> 3) & 1)],
+    };
+
+    return T;
+}
+
+__forceinline
+__m256 _mm256_permute_ps(__m256 a, const int imm8)
+{
+    __m256 T =
+    {
+        a.m256_f32[0 + ((imm8 >> 0) & 3)],
+        a.m256_f32[0 + ((imm8 >> 2) & 3)],
+        a.m256_f32[0 + ((imm8 >> 4) & 3)],
+        a.m256_f32[0 + ((imm8 >> 6) & 3)],
+        a.m256_f32[4 + ((imm8 >> 0) & 3)],
+        a.m256_f32[4 + ((imm8 >> 2) & 3)],
+        a.m256_f32[4 + ((imm8 >> 4) & 3)],
+        a.m256_f32[4 + ((imm8 >> 6) & 3)],
+    };
+
+    return T;
+}
+
+// VPERMILPS VPERMILPD (variable in-lane forms)
+
+#undef _mm_permutevar_pd
+#undef _mm_permutevar_ps
+
+__forceinline
+__n128 sw_permutevar_ps(__n128 a, const __n128 b)
+{
+    // convert each dword selector 0..3 into TBL byte indices 4*i+0 .. 4*i+3
+
+    __n128 Index = vandq_u32(b, vdupq_n_u32(3));
+    Index = vmlaq_u32(vdupq_n_u32(0x03020100), Index, vdupq_n_u32(0x04040404));
+
+    return vqtbl1q_u8(a, Index);
+}
+
+__forceinline
+__n128 sw_permutevar_pd(__n128 a, const __n128 b)
+{
+    // qword selector is bit 1 (not bit 0!) of each 64-bit control element
+
+    __n128 Select = vtstq_u64(b, vdupq_n_u64(2));
+
+    return vbslq_u64(Select, vdupq_laneq_u64(a, 1), vdupq_laneq_u64(a, 0));
+}
+
+DEFINE_N128_OP_N128_N128(__m128d, permutevar_pd, sw_permutevar_pd, __m128d, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128,  permutevar_ps, sw_permutevar_ps, __m128,  a, __m128i, b, 0)
+
+DEFINE_N256_OP_N256_N256(__m256d, permutevar_pd, sw_permutevar_pd, __m256d, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256,  permutevar_ps, sw_permutevar_ps, __m256,  a, __m256i, b, 0)
+
+// VPERMD VPERMPS
+//
+// Cross-lane permutes use TBL with both __n128x2 halves as a 32-byte table
+
+__forceinline
+__n128 sw_permutevar8x32_index(__n128 idx)
+{
+    // convert each dword selector 0..7 into TBL byte indices 4*i+0 .. 4*i+3
+
+    __n128 Index = vandq_u32(idx, vdupq_n_u32(7));
+    Index = vmlaq_u32(vdupq_n_u32(0x03020100), Index, vdupq_n_u32(0x04040404));
+
+    return Index;
+}
+
+__forceinline
+__n256i _nn256_permutevar8x32_epi32(__n256i a, __n256i idx)
+{
+    __n256i T;
+
+    T.val[0] = vqtbl2q_u8(a, sw_permutevar8x32_index(idx.val[0]));
+    T.val[1] = vqtbl2q_u8(a, sw_permutevar8x32_index(idx.val[1]));
+
+    return T;
+}
+
+#define _nn256_permutevar8x32_ps _nn256_permutevar8x32_epi32
+
+__forceinline
+__m256i _mm256_permutevar8x32_epi32(__m256i a, __m256i idx)
+{
+    return _nn256_castn256_si256( _nn256_permutevar8x32_epi32(_nn256_castsi256_n256(a), _nn256_castsi256_n256(idx)) );
+}
+
+__forceinline
+__m256 _mm256_permutevar8x32_ps(__m256 a, __m256i idx)
+{
+    return _nn256_castn256_ps( _nn256_permutevar8x32_ps(_nn256_castps_n256(a), _nn256_castsi256_n256(idx)) );
+}
+
+// VPERMQ VPERMPD
+
+__forceinline
+__n128 sw_permute4x64_index(const int imm2x2)
+{
+    // TBL byte indices for two qword selectors 0..3, i.e. 8*i+0 .. 8*i+7
+
+    const unsigned __int64 Bytes  = 0x0706050403020100ull;
+    const unsigned __int64 Eights = 0x0808080808080808ull;
+
+    return vcombine_u64(vcreate_u64(Bytes + Eights * ((imm2x2 >> 0) & 3)),
+                        vcreate_u64(Bytes + Eights * ((imm2x2 >> 2) & 3)));
+}
+
+__forceinline
+__n256i _nn256_permute4x64_epi64(__n256i a, const int imm8)
+{
+    __n256i T;
+
+    // check for common shuffles which map to one or two simple operations
+
+    switch (imm8 & 0xFF)
+    {
+        case 0xE4:  // 3 2 1 0  identity
+            T = a;
+            break;
+
+        case 0x4E:  // 1 0 3 2  swap 128-bit halves
+            T.val[0] = a.val[1];
+            T.val[1] = a.val[0];
+            break;
+
+        case 0x44:  // 1 0 1 0  broadcast low 128 bits
+            T.val[0] = a.val[0];
+            T.val[1] = a.val[0];
+            break;
+
+        case 0xEE:  // 3 2 3 2  broadcast high 128 bits
+            T.val[0] = a.val[1];
+            T.val[1] = a.val[1];
+            break;
+
+        case 0xD8:  // 3 1 2 0  interleave halves, e.g. after 256-bit pack/unpack
+            T.val[0] = vzip1q_u64(a.val[0], a.val[1]);
+            T.val[1] = vzip2q_u64(a.val[0], a.val[1]);
+            break;
+
+        case 0xB1:  // 2 3 0 1  swap qwords within each half
+            T.val[0] = vextq_u8(a.val[0], a.val[0], 8);
+            T.val[1] = vextq_u8(a.val[1], a.val[1], 8);
+            break;
+
+        case 0x1B:  // 0 1 2 3  reverse
+            T.val[0] = vextq_u8(a.val[1], a.val[1], 8);
+            T.val[1] = vextq_u8(a.val[0], a.val[0], 8);
+            break;
+
+        case 0x00:  // broadcast qword 0
+            T.val[0] = T.val[1] = vdupq_laneq_u64(a.val[0], 0);
+            break;
+
+        case 0x55:  // broadcast qword 1
+            T.val[0] = T.val[1] = vdupq_laneq_u64(a.val[0], 1);
+            break;
+
+        case 0xAA:  // broadcast qword 2
+            T.val[0] = T.val[1] = vdupq_laneq_u64(a.val[1], 0);
+            break;
+
+        case 0xFF:  // broadcast qword 3
+            T.val[0] = T.val[1] = vdupq_laneq_u64(a.val[1], 1);
+            break;
+
+        default:    // all other cases are a TBL per half with constant indices
+            T.val[0] = vqtbl2q_u8(a, sw_permute4x64_index(imm8 >> 0));
+            T.val[1] = vqtbl2q_u8(a, sw_permute4x64_index(imm8 >> 4));
+            break;
+    }
+
+    return T;
+}
+
+#define _nn256_permute4x64_pd _nn256_permute4x64_epi64
+
+__forceinline
+__m256i _mm256_permute4x64_epi64(__m256i a, const int imm8)
+{
+    return _nn256_castn256_si256( _nn256_permute4x64_epi64(_nn256_castsi256_n256(a), imm8) );
+}
+
+__forceinline
+__m256d _mm256_permute4x64_pd(__m256d a, const int imm8)
+{
+    return _nn256_castn256_pd( _nn256_permute4x64_pd(_nn256_castpd_n256(a), imm8) );
+}
+
+// VPERM2I128
+
+#define _nn256_permute2x128_si256 _nn256_permute2f128_si256
+
+__forceinline
+__m256i _mm256_permute2x128_si256 (__m256i a, __m256i b, const int imm8)
+{
+    return _nn256_castn256_si256( _nn256_permute2x128_si256(_nn256_castsi256_n256(a), _nn256_castsi256_n256(b), imm8) );
+}
+
+// VPALIGNR
+//
+// Shifts each 128-bit lane independently using the same imm8
+
+__forceinline
+__n256i _nn256_alignr_epi8(__n256i a, __n256i b, const int imm8)
+{
+    __n256i T;
+
+    T.val[0] = _nn_alignr_epi8(a.val[0], b.val[0], imm8);
+    T.val[1] = _nn_alignr_epi8(a.val[1], b.val[1], imm8);
+
+    return T;
+}
+
+__forceinline
+__m256i _mm256_alignr_epi8(__m256i a, __m256i b, const int imm8)
+{
+    return _nn256_castn256_si256( _nn256_alignr_epi8(_nn256_castsi256_n256(a), _nn256_castsi256_n256(b), imm8) );
+}
+
+// VMOVSHDUP VMOVSLDUP
+
+__forceinline
+__m256 _mm256_moveldup_ps(__m256 a)
+{
+    return _mm256_permute_ps(a, 0xA0); // A0 = 10'10'00'00
+}
+
+__forceinline
+__m256 _mm256_movehdup_ps(__m256 a)
+{
+    return _mm256_permute_ps(a, 0xF5); // F5 = 11'11'01'01
+}
+
+// VPMOVSX VPMOVZX
+//
+// Both halves are widened from the one 128-bit source in registers: the chain is
+// shared up to the last step, which is SXTL/UXTL for the low half and SXTL2/UXTL2
+// for the high half.
+
+__forceinline __n128 sw_sxtl2_8 (__n128 const a) { return vmovl_high_s8 (a); }
+__forceinline __n128 sw_sxtl2_16(__n128 const a) { return vmovl_high_s16(a); }
+__forceinline __n128 sw_sxtl2_32(__n128 const a) { return vmovl_high_s32(a); }
+__forceinline __n128 sw_uxtl2_8 (__n128 const a) { return vmovl_high_u8 (a); }
+__forceinline __n128 sw_uxtl2_16(__n128 const a) { return vmovl_high_u16(a); }
+__forceinline __n128 sw_uxtl2_32(__n128 const a) { return vmovl_high_u32(a); }
+
+__forceinline __n128 sw_mov_n128(__n128 const a) { return a; }
+
+//
+// Template for 128-bit to 256-bit widening instructions which split at the last step
+//
+
+#define DEFINE_N256_WIDEN_N128(rettype, name, pre, intrin_lo, intrin_hi, arg1type, arg1) \
+\
+__forceinline __n128x2 _nn256_ ## name (const __n128 a) \
+{ \
+    __n128x2 T; \
+    const __n128 W = pre (a); \
+    T.val[0] = intrin_lo (W); \
+    T.val[1] = intrin_hi (W); \
+    return T; \
+} \
+\
+__forceinline rettype _mm256_ ## name (arg1type arg1) \
+{ \
+    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128_from_ ## arg1type (a) ) ); \
+}
+
+DEFINE_N256_WIDEN_N128(__m256i, cvtepi8_epi16,  sw_mov_n128,         sw_sxtl8,  sw_sxtl2_8,  __m128i, a)
+DEFINE_N256_WIDEN_N128(__m256i, cvtepi8_epi32,  sw_sxtl8,            sw_sxtl16, sw_sxtl2_16, __m128i, a)
+DEFINE_N256_WIDEN_N128(__m256i, cvtepi8_epi64,  sw_cvtepi8_epi32,    sw_sxtl32, sw_sxtl2_32, __m128i, a)
+DEFINE_N256_WIDEN_N128(__m256i, cvtepi16_epi32, sw_mov_n128,         sw_sxtl16, sw_sxtl2_16, __m128i, a)
+DEFINE_N256_WIDEN_N128(__m256i, cvtepi16_epi64, sw_sxtl16,           sw_sxtl32, sw_sxtl2_32, __m128i, a)
+DEFINE_N256_WIDEN_N128(__m256i, cvtepi32_epi64, sw_mov_n128,         sw_sxtl32, sw_sxtl2_32, __m128i, a)
+DEFINE_N256_WIDEN_N128(__m256i, cvtepu8_epi16,  sw_mov_n128,         sw_uxtl8,  sw_uxtl2_8,  __m128i, a)
+DEFINE_N256_WIDEN_N128(__m256i, cvtepu8_epi32,  sw_uxtl8,            sw_uxtl16, sw_uxtl2_16, __m128i, a)
+DEFINE_N256_WIDEN_N128(__m256i, cvtepu8_epi64,  sw_cvtepu8_epi32,    sw_uxtl32, sw_uxtl2_32, __m128i, a)
+DEFINE_N256_WIDEN_N128(__m256i, cvtepu16_epi32, sw_mov_n128,         sw_uxtl16, sw_uxtl2_16, __m128i, a)
+DEFINE_N256_WIDEN_N128(__m256i, cvtepu16_epi64, sw_uxtl16,           sw_uxtl32, sw_uxtl2_32, __m128i, a)
+DEFINE_N256_WIDEN_N128(__m256i, cvtepu32_epi64, sw_mov_n128,         sw_uxtl32, sw_uxtl2_32, __m128i, a)
+
+// load-fused forms reading only the 4, 8, or 16 bytes consumed
+
+__forceinline __n256i _nn256_cvtepi8_epi16_mem (void const * p) { return _nn256_cvtepi8_epi16 (vld1q_u8((unsigned __int8 const *)p)); }
+__forceinline __n256i _nn256_cvtepi8_epi32_mem (void const * p) { return _nn256_cvtepi8_epi32 (sw_load_lo64(p)); }
+__forceinline __n256i _nn256_cvtepi8_epi64_mem (void const * p) { return _nn256_cvtepi8_epi64 (sw_load_lo32(p)); }
+__forceinline __n256i _nn256_cvtepi16_epi32_mem(void const * p) { return _nn256_cvtepi16_epi32(vld1q_u8((unsigned __int8 const *)p)); }
+__forceinline __n256i _nn256_cvtepi16_epi64_mem(void const * p) { return _nn256_cvtepi16_epi64(sw_load_lo64(p)); }
+__forceinline __n256i _nn256_cvtepi32_epi64_mem(void const * p) { return _nn256_cvtepi32_epi64(vld1q_u8((unsigned __int8 const *)p)); }
+__forceinline __n256i _nn256_cvtepu8_epi16_mem (void const * p) { return _nn256_cvtepu8_epi16 (vld1q_u8((unsigned __int8 const *)p)); }
+__forceinline __n256i _nn256_cvtepu8_epi32_mem (void const * p) { return _nn256_cvtepu8_epi32 (sw_load_lo64(p)); }
+__forceinline __n256i _nn256_cvtepu8_epi64_mem (void const * p) { return _nn256_cvtepu8_epi64 (sw_load_lo32(p)); }
+__forceinline __n256i _nn256_cvtepu16_epi32_mem(void const * p) { return _nn256_cvtepu16_epi32(vld1q_u8((unsigned __int8 const *)p)); }
+__forceinline __n256i _nn256_cvtepu16_epi64_mem(void const * p) { return _nn256_cvtepu16_epi64(sw_load_lo64(p)); }
+__forceinline __n256i _nn256_cvtepu32_epi64_mem(void const * p) { return _nn256_cvtepu32_epi64(vld1q_u8((unsigned __int8 const *)p)); }
+
+// VCVT variants
+
+// VCVTDQ2PD
+
+__forceinline
+__n128x2 _nn256_sw_cvtepi32_pd(__n128i a)
+{
+    __n128x2 T;
+
+    T.val[0].n128_f64[0] = (int)a.n128_u32[0];
+    T.val[0].n128_f64[1] = (int)a.n128_u32[1];
+    T.val[1].n128_f64[0] = (int)a.n128_u32[2];
+    T.val[1].n128_f64[1] = (int)a.n128_u32[3];
+
+    return T;
+}
+
+#if 0
+__forceinline
+__n128x2 _nn256_cvtepi32_pd(__n128i a)
+{
+    __n128x2 T;
+
+    T.val[0] = vcvt_f64_s32(a.DUMMYNEONSTRUCT.low64);
+    T.val[1] = vcvt_high_f64_s32(a);
+
+    return T;
+}
+#endif
+
+// VCVTDQ2PS
+
+__forceinline
+__m256d _mm256_cvtepi32_pd(__m128i a)
+{
+    return _nn256_castn256_pd( _nn256_sw_cvtepi32_pd(_nn128_castsi128_n128(a)) );
+}
+
+__forceinline
+__n256 _nn256_sw_cvtepi32_ps(__n256i a)
+{
+    __n256 T;
+
+    T.val[0].n128_f32[0] = (float)(__int32)a.val[0].n128_u32[0];
+    T.val[0].n128_f32[1] = (float)(__int32)a.val[0].n128_u32[1];
+    T.val[0].n128_f32[2] = (float)(__int32)a.val[0].n128_u32[2];
+    T.val[0].n128_f32[3] = (float)(__int32)a.val[0].n128_u32[3];
+    T.val[1].n128_f32[0] = (float)(__int32)a.val[1].n128_u32[0];
+    T.val[1].n128_f32[1] = (float)(__int32)a.val[1].n128_u32[1];
+    T.val[1].n128_f32[2] = (float)(__int32)a.val[1].n128_u32[2];
+    T.val[1].n128_f32[3] = (float)(__int32)a.val[1].n128_u32[3];
+
+    return T;
+}
+
+__forceinline
+__m256 _mm256_cvtepi32_ps(__m256i a)
+{
+    return _nn256_castn256_ps( _nn256_sw_cvtepi32_ps(_nn256_castsi256_n256(a)) );
+}
+
+// VCVTPS2PD
+
+__forceinline
+__n128x2 _nn256_sw_cvtps_pd(__n128 a)
+{
+    __n128x2 T;
+
+    T.val[0].n128_f64[0] = a.n128_f32[0];
+    T.val[0].n128_f64[1] = a.n128_f32[1];
+    T.val[1].n128_f64[0] = a.n128_f32[2];
+    T.val[1].n128_f64[1] = a.n128_f32[3];
+
+    return T;
+}
+
+__forceinline
+__n128x2 _nn256_cvtps_pd(__n128 a)
+{
+    __n128x2 T;
+
+    T.val[0] = vcvt_f64_f32(a.DUMMYNEONSTRUCT.low64);
+    T.val[1] = vcvt_high_f64_f32(a);
+
+    return T;
+}
+
+__forceinline
+__m256d _mm256_cvtps_pd(__m128 a)
+{
+    return _nn256_castn256_pd( _nn256_cvtps_pd(_nn128_castps_n128(a)) );
+}
+
+// VCVTPD2DQ
+
+__forceinline
+__n128i _nn256_sw_cvtpd_epi32(__n256d a)
+{
+    __n128 T;
+
+    T.n128_u32[0] = (__int32)a.val[0].n128_f64[0];
+    T.n128_u32[1] = (__int32)a.val[0].n128_f64[1];
+    T.n128_u32[2] = (__int32)a.val[1].n128_f64[0];
+    T.n128_u32[3] = (__int32)a.val[1].n128_f64[1];
+
+    return T;
+}
+
+__forceinline
+__m128i _mm256_cvtpd_epi32(__m256d a)
+{
+    return _nn128_castn128_si128( _nn256_sw_cvtpd_epi32(_nn256_castpd_n256(a)) );
+}
+
+// VCVTTPD2DQ
+
+__forceinline
+__n128i _nn256_sw_cvttpd_epi32(__n256d a)
+{
+    __n128 T;
+
+    T.n128_u32[0] = (__int32)a.val[0].n128_f64[0];
+    T.n128_u32[1] = (__int32)a.val[0].n128_f64[1];
+    T.n128_u32[2] = (__int32)a.val[1].n128_f64[0];
+    T.n128_u32[3] = (__int32)a.val[1].n128_f64[1];
+
+    return T;
+}
+
+__forceinline
+__m128i _mm256_cvttpd_epi32(__m256d a)
+{
+    return _nn128_castn128_si128( _nn256_sw_cvttpd_epi32(_nn256_castpd_n256(a)) );
+}
+
+// VCVTPD2PS
+
+__forceinline
+__n128 _nn256_sw_cvtpd_ps(__n128x2 a)
+{
+    __n128 T;
+
+    T.n128_f32[0] = (float)a.val[0].n128_f64[0];
+    T.n128_f32[1] = (float)a.val[0].n128_f64[1];
+    T.n128_f32[2] = (float)a.val[1].n128_f64[0];
+    T.n128_f32[3] = (float)a.val[1].n128_f64[1];
+
+    return T;
+}
+
+__forceinline
+__n128 _nn256_cvtpd_ps(__n256 a)
+{
+    __n128 T = vcvt_high_f32_f64(vcvt_f32_f64(a.val[0]), a.val[1]);
+
+    return T;
+}
+
+__forceinline
+__m128 _mm256_cvtpd_ps(__m256d a)
+{
+    return _nn128_castn128_ps( _nn256_cvtpd_ps(_nn256_castpd_n256(a)) );
+}
+
+// VCVTPH2PS VCVTPS2PH (F16C)
+//
+// Widening is exact with FCVTL/FCVTL2.  Narrowing with FCVTN rounds in the FPCR
+// mode, which is what imm8 = _MM_FROUND_CUR_DIRECTION asks for.  For an explicit
+// rounding direction each float is first rounded to binary16 precision with the
+// matching FRINT at a power of 2 scale, so that FCVTN is exact and the FPCR mode
+// never matters.  Overflow is resolved the same way before FCVTN.  FCVT takes
+// NaNs to the same quiet NaN and payload bits as x86 (FPCR.DN = 0), and binary16
+// denormals are never flushed (FPCR.FZ16 does not apply to FCVT).
+//
+
+#define SOFT_INTRINSICS_F16C
+
+#undef _mm_cvtph_ps
+#undef _mm_cvtps_ph
+#undef _mm256_cvtph_ps
+#undef _mm256_cvtps_ph
+#undef _cvtsh_ss
+#undef _cvtss_sh
+
+__forceinline
+__n128 sw_cvtps_ph_round(__n128 a, const int imm8)
+{
+    // The binary16 ulp of a is 2^(e-10) for exponent e, but never below 2^-24
+    // (biased exponent 113 is 2^-14, the smallest binary16 normal).
+
+    const __n128 Exp   = vmaxq_u32(vshrq_n_u32(vshlq_n_u32(a, 1), 24), vdupq_n_u32(113));
+    const __n128 Scale = vshlq_n_u32(vsubq_u32(vdupq_n_u32(127 + 10 + 127), Exp), 23);
+    const __n128 Ulp   = vshlq_n_u32(vsubq_u32(Exp, vdupq_n_u32(10)), 23);
+
+    __n128 T = vmulq_f32(sw_round_ps(vmulq_f32(a, Scale), imm8 & 3), Ulp);
+
+    // Finite results past 65504 are already at least 65536 and become infinity
+    // or 65504 depending on the rounding direction and the sign.
+
+    __n128 InfMask;
+
+    switch (imm8 & 3)
+    {
+    case _MM_FROUND_TO_NEAREST_INT: InfMask = neon_mvniqw(0); break;
+    case _MM_FROUND_TO_NEG_INF:     InfMask = vshrq_n_s32(a, 31); break;
+    case _MM_FROUND_TO_POS_INF:     InfMask = neon_notq(vshrq_n_s32(a, 31)); break;
+    default:                        InfMask = neon_moviqw(0); break;
+    }
+
+    const __n128 Overflow = neon_andq(vcageq_f32(T, vdupq_n_f32(65536.0f)), vcaltq_f32(T, vdupq_n_u32(0x7F800000)));
+    const __n128 Sign     = neon_andq(a, vdupq_n_u32(0x80000000));
+    const __n128 Limit    = neon_orrq(Sign, vbslq_u32(InfMask, vdupq_n_u32(0x7F800000), vdupq_n_u32(0x477FE000)));
+
+    return vbslq_u32(Overflow, Limit, T);
+}
+
+__forceinline
+__n64 sw_cvtps_ph(__n128 a, const int imm8)
+{
+    if ((imm8 & _MM_FROUND_CUR_DIRECTION) == 0)
+    {
+        a = sw_cvtps_ph_round(a, imm8);
+    }
+
+    return vcvt_f16_f32(a);
+}
+
+__forceinline
+__n128 _nn_cvtph_ps(__n128 a)
+{
+    return vcvt_f32_f16(a.DUMMYNEONSTRUCT.low64);
+}
+
+__forceinline
+__n128 _nn_cvtps_ph(__n128 a, const int imm8)
+{
+    return vcombine_u64(sw_cvtps_ph(a, imm8), vcreate_u64(0));
+}
+
+__forceinline
+__n128x2 _nn256_cvtph_ps(__n128 a)
+{
+    __n128x2 T;
+
+    T.val[0] = vcvt_f32_f16(a.DUMMYNEONSTRUCT.low64);
+    T.val[1] = vcvt_high_f32_f16(a);
+
+    return T;
+}
+
+__forceinline
+__n128 _nn256_cvtps_ph(__n128x2 a, const int imm8)
+{
+    if ((imm8 & _MM_FROUND_CUR_DIRECTION) == 0)
+    {
+        a.val[0] = sw_cvtps_ph_round(a.val[0], imm8);
+        a.val[1] = sw_cvtps_ph_round(a.val[1], imm8);
+    }
+
+    return vcvt_high_f16_f32(vcvt_f16_f32(a.val[0]), a.val[1]);
+}
+
+__forceinline
+__m128 _mm_cvtph_ps(__m128i a)
+{
+    return _nn128_castn128_ps( _nn_cvtph_ps(_nn128_castsi128_n128(a)) );
+}
+
+__forceinline
+__m128i _mm_cvtps_ph(__m128 a, const int imm8)
+{
+    return _nn128_castn128_si128( _nn_cvtps_ph(_nn128_castps_n128(a), imm8) );
+}
+
+__forceinline
+__m256 _mm256_cvtph_ps(__m128i a)
+{
+    return _nn256_castn256_ps( _nn256_cvtph_ps(_nn128_castsi128_n128(a)) );
+}
+
+__forceinline
+__m128i _mm256_cvtps_ph(__m256 a, const int imm8)
+{
+    return _nn128_castn128_si128( _nn256_cvtps_ph(_nn256_castps_n256(a), imm8) );
+}
+
+__forceinline
+float _cvtsh_ss(unsigned short a)
+{
+    return vgetq_lane_f32(vcvt_f32_f16(vcreate_u64(a)), 0);
+}
+
+__forceinline
+unsigned short _cvtss_sh(float a, const int imm8)
+{
+    return vget_lane_u16(sw_cvtps_ph(vdupq_n_f32(a), imm8), 0);
+}
+
+// VPSLL VPSRL VPSRA
+
+__forceinline
+__n256i _nn256_sw_sli_si256(__n256i a, const int imm8)
+{
+    __n256 T;
+
+    for (unsigned i = 0; i < 16; i++)
+    {
+        unsigned FromLane = (i + imm8);
+
+        T.val[0].n128_i8[i] = (FromLane >= 16) ? 0 : a.val[0].n128_i8[FromLane];
+        T.val[1].n128_i8[i] = (FromLane >= 16) ? 0 : a.val[1].n128_i8[FromLane];
+    }
+
+    return T;
+}
+
+__forceinline
+__n256i _nn256_slli_si256(__n256i a, const int imm8)
+{
+    return _nn256_sw_sli_si256(a, -imm8);
+}
+
+__forceinline
+__n256i _nn256_srli_si256(__n256i a, const int imm8)
+{
+    return _nn256_sw_sli_si256(a, +imm8);
+}
+
+__forceinline
+__m256i _mm256_slli_si256(__m256i a, const int imm8)
+{
+    return _nn256_castn256_si256( _nn256_slli_si256(_nn256_castsi256_n256(a), imm8 ) );
+}
+
+__forceinline
+__m256i _mm256_srli_si256(__m256i a, const int imm8)
+{
+    return _nn256_castn256_si256( _nn256_srli_si256(_nn256_castsi256_n256(a), imm8 ) );
+}
+
+//
+// Double-wide AVX operations derived by doubling existing SSE operations
+//
+
+//
+// Template for double-wide 256-bit dest,source1 vector instructions
+//
+
+#define DEFINE_M256_OP_M256(rettype, rettype128, name, arg1type, arg1type128) \
+\
+__forceinline __n128x2 _nn256_ ## name (__n128x2 a) \
+{ \
+    __n128x2 T; \
+    T.val[0] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[0]) ) ); \
+    T.val[1] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[1]) ) ); \
+    return T; \
+} \
+\
+__forceinline rettype _mm256_ ## name (arg1type arg1) \
+{ \
+    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128x2_from_ ## arg1type (arg1) ) ); \
+}
+
+// VCVTPS2DQ
+// VCVTTPS2DQ
+
+DEFINE_M256_OP_M256(__m256i, __m128i, cvtps_epi32,   __m256 , __m128 )
+DEFINE_M256_OP_M256(__m256i, __m128i, cvttps_epi32,  __m256 , __m128 )
+
+// VRCPPS
+// VRSQRTPS
+
+DEFINE_M256_OP_M256(__m256 , __m128 , rcp_ps,        __m256 , __m128 )
+DEFINE_M256_OP_M256(__m256 , __m128 , rsqrt_ps,      __m256 , __m128 )
+
+//
+// Template for double-wide 256-bit dest,source1,imm8 vector instructions
+//
+
+#define DEFINE_M256_OP_M256_IMM8(rettype, rettype128, name, arg1type, arg1type128) \
+\
+__forceinline __n128x2 _nn256_ ## name (__n128x2 a, const int imm8) \
+{ \
+    __n128x2 T; \
+    T.val[0] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[0]), imm8 ) ); \
+    T.val[1] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[1]), imm8 ) ); \
+    return T; \
+} \
+\
+__forceinline rettype _mm256_ ## name (arg1type arg1, const int imm8) \
+{ \
+    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128x2_from_ ## arg1type (arg1), imm8 ) ); \
+}
+
+DEFINE_M256_OP_M256_IMM8(__m256i, __m128i, shuffle_epi32, __m256i, __m128i)
+
+DEFINE_M256_OP_M256_IMM8(__m256i, __m128i, slli_epi16,    __m256i, __m128i)
+DEFINE_M256_OP_M256_IMM8(__m256i, __m128i, slli_epi32,    __m256i, __m128i)
+DEFINE_M256_OP_M256_IMM8(__m256i, __m128i, slli_epi64,    __m256i, __m128i)
+
+DEFINE_M256_OP_M256_IMM8(__m256i, __m128i, srai_epi16,    __m256i, __m128i)
+DEFINE_M256_OP_M256_IMM8(__m256i, __m128i, srai_epi32,    __m256i, __m128i)
+
+DEFINE_M256_OP_M256_IMM8(__m256i, __m128i, srli_epi16,    __m256i, __m128i)
+DEFINE_M256_OP_M256_IMM8(__m256i, __m128i, srli_epi32,    __m256i, __m128i)
+DEFINE_M256_OP_M256_IMM8(__m256i, __m128i, srli_epi64,    __m256i, __m128i)
+
+//
+// Template for double-wide 256-bit dest,source1,source2 vector instructions
+// Variants for source2 is 128-bit and 256-bit
+//
+
+#define DEFINE_M256_OP_M256_M128(rettype, rettype128, name, arg1type, arg1type128, arg2type, arg2type128) \
+\
+__forceinline __n128x2 _nn256_ ## name (__n128x2 a, const __n128 b) \
+{ \
+    __n128x2 T; \
+    T.val[0] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[0]), arg2type128 ## _from___n128(b) ) ); \
+    T.val[1] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[1]), arg2type128 ## _from___n128(b) ) ); \
+    return T; \
+} \
+\
+__forceinline rettype _mm256_ ## name (arg1type arg1, arg2type arg2) \
+{ \
+    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128x2_from_ ## arg1type (arg1), __n128_from_ ## arg2type (arg2) ) ); \
+}
+
+DEFINE_M256_OP_M256_M128(__m256i, __m128i, sll_epi16,     __m256i, __m128i, __m128i, __m128i)
+DEFINE_M256_OP_M256_M128(__m256i, __m128i, sll_epi32,     __m256i, __m128i, __m128i, __m128i)
+DEFINE_M256_OP_M256_M128(__m256i, __m128i, sll_epi64,     __m256i, __m128i, __m128i, __m128i)
+
+DEFINE_M256_OP_M256_M128(__m256i, __m128i, sra_epi16,     __m256i, __m128i, __m128i, __m128i)
+DEFINE_M256_OP_M256_M128(__m256i, __m128i, sra_epi32,     __m256i, __m128i, __m128i, __m128i)
+
+DEFINE_M256_OP_M256_M128(__m256i, __m128i, srl_epi16,     __m256i, __m128i, __m128i, __m128i)
+DEFINE_M256_OP_M256_M128(__m256i, __m128i, srl_epi32,     __m256i, __m128i, __m128i, __m128i)
+DEFINE_M256_OP_M256_M128(__m256i, __m128i, srl_epi64,     __m256i, __m128i, __m128i, __m128i)
+
+#define DEFINE_M256_OP_M256_M256(rettype, rettype128, name, arg1type, arg1type128, arg2type, arg2type128) \
+\
+__forceinline __n128x2 _nn256_ ## name (__n128x2 a, const __n128x2 b) \
+{ \
+    __n128x2 T; \
+    T.val[0] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[0]), arg2type128 ## _from___n128(b.val[0]) ) ); \
+    T.val[1] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[1]), arg2type128 ## _from___n128(b.val[1]) ) ); \
+    return T; \
+} \
+\
+__forceinline rettype _mm256_ ## name (arg1type arg1, arg2type arg2) \
+{ \
+    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128x2_from_ ## arg1type (arg1), __n128x2_from_ ## arg2type (arg2) ) ); \
+}
+
+DEFINE_M256_OP_M256_M256(__m256i, __m128i, mulhi_epi16,   __m256i, __m128i, __m256i, __m128i)
+DEFINE_M256_OP_M256_M256(__m256i, __m128i, mulhi_epu16,   __m256i, __m128i, __m256i, __m128i)
+DEFINE_M256_OP_M256_M256(__m256i, __m128i, mulhrs_epi16,  __m256i, __m128i, __m256i, __m128i)
+
+DEFINE_M256_OP_M256_M256(__m256i, __m128i, sllv_epi32,    __m256i, __m128i, __m256i, __m128i)
+DEFINE_M256_OP_M256_M256(__m256i, __m128i, sllv_epi64,    __m256i, __m128i, __m256i, __m128i)
+
+DEFINE_M256_OP_M256_M256(__m256i, __m128i, srav_epi32,    __m256i, __m128i, __m256i, __m128i)
+
+DEFINE_M256_OP_M256_M256(__m256i, __m128i, srlv_epi32,    __m256i, __m128i, __m256i, __m128i)
+DEFINE_M256_OP_M256_M256(__m256i, __m128i, srlv_epi64,    __m256i, __m128i, __m256i, __m128i)
+
+DEFINE_M256_OP_M256_M256(__m256d, __m128d, addsub_pd,     __m256d, __m128d, __m256d, __m128d)
+DEFINE_M256_OP_M256_M256(__m256 , __m128 , addsub_ps,     __m256 , __m128 , __m256 , __m128 )
+DEFINE_M256_OP_M256_M256(__m256d, __m128d, hsub_pd,       __m256d, __m128d, __m256d, __m128d)
+DEFINE_M256_OP_M256_M256(__m256 , __m128 , hsub_ps,       __m256 , __m128 , __m256 , __m128 )
+
+//
+// Template for double-wide 256-bit dest,source1,source2,imm8 vector instructions
+//
+
+#define DEFINE_M256_OP_M256_M256_IMM8(rettype, rettype128, name, arg1type, arg1type128, arg2type, arg2type128, hish) \
+\
+__forceinline __n128x2 _nn256_ ## name (__n128x2 a, const __n128x2 b, const int imm8) \
+{ \
+    __n128x2 T; \
+    T.val[0] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[0]), arg2type128 ## _from___n128(b.val[0]), imm8 ) ); \
+    T.val[1] = __n128_from_ ## rettype128 ( _mm_ ## name( arg1type128 ## _from___n128(a.val[1]), arg2type128 ## _from___n128(b.val[1]), imm8 >> hish ) ); \
+    return T; \
+} \
+\
+__forceinline rettype _mm256_ ## name (arg1type arg1, arg2type arg2, const int imm8) \
+{ \
+    return rettype ## _from___n128x2 ( _nn256_ ## name ( __n128x2_from_ ## arg1type (arg1), __n128x2_from_ ## arg2type (arg2), imm8 ) ); \
+}
+
+DEFINE_M256_OP_M256_M256_IMM8(__m256d, __m128d, blend_pd,      __m256d, __m128d, __m256d, __m128d, 2)
+DEFINE_M256_OP_M256_M256_IMM8(__m256 , __m128 , blend_ps,      __m256 , __m128 , __m256 , __m128 , 4)
+DEFINE_M256_OP_M256_M256_IMM8(__m256i, __m128i, blend_epi16,   __m256i, __m128i, __m256i, __m128i, 0)
+// DEFINE_M256_OP_M256_M256_IMM8(__m256i, __m128i, blend_epi32,   __m256i, __m128i, __m256i, __m128i, 4)
+
+DEFINE_M256_OP_M256_M256_IMM8(__m256 , __m128 , dp_ps,         __m256 , __m128 , __m256 , __m128 , 0)
+
+DEFINE_M256_OP_M256_M256_IMM8(__m256d, __m128d, shuffle_pd,    __m256d, __m128d, __m256d, __m128d, 2)
+DEFINE_M256_OP_M256_M256_IMM8(__m256 , __m128 , shuffle_ps,    __m256 , __m128 , __m256 , __m128 , 0)
+
+//
+// Scalar bit manipulation: BMI1 BMI2 LZCNT
+//
+// These are always compiled in, so cpuid_avx2.h reports BMI1, BMI2 and LZCNT
+// whenever SOFT_INTRINSICS_BMI is defined.
+//
+
+#define SOFT_INTRINSICS_BMI
+
+#undef _andn_u32
+#undef _andn_u64
+#undef _bextr_u32
+#undef _bextr_u64
+#undef _bextr2_u32
+#undef _bextr2_u64
+#undef _blsi_u32
+#undef _blsi_u64
+#undef _blsmsk_u32
+#undef _blsmsk_u64
+#undef _blsr_u32
+#undef _blsr_u64
+#undef _tzcnt_u32
+#undef _tzcnt_u64
+#undef _lzcnt_u32
+#undef _lzcnt_u64
+#undef _bzhi_u32
+#undef _bzhi_u64
+#undef _pdep_u32
+#undef _pdep_u64
+#undef _pext_u32
+#undef _pext_u64
+#undef _mulx_u32
+#undef _mulx_u64
+#undef _rorx_u32
+#undef _rorx_u64
+#undef _sarx_i32
+#undef _sarx_i64
+#undef _shlx_u32
+#undef _shlx_u64
+#undef _shrx_u32
+#undef _shrx_u64
+
+// ANDN BLSI BLSMSK BLSR
+
+__forceinline unsigned int     _andn_u32  (unsigned int a,     unsigned int b)     { return ~a & b; }
+__forceinline unsigned __int64 _andn_u64  (unsigned __int64 a, unsigned __int64 b) { return ~a & b; }
+__forceinline unsigned int     _blsi_u32  (unsigned int a)     { return a & (0 - a); }
+__forceinline unsigned __int64 _blsi_u64  (unsigned __int64 a) { return a & (0 - a); }
+__forceinline unsigned int     _blsmsk_u32(unsigned int a)     { return a ^ (a - 1); }
+__forceinline unsigned __int64 _blsmsk_u64(unsigned __int64 a) { return a ^ (a - 1); }
+__forceinline unsigned int     _blsr_u32  (unsigned int a)     { return a & (a - 1); }
+__forceinline unsigned __int64 _blsr_u64  (unsigned __int64 a) { return a & (a - 1); }
+
+// TZCNT LZCNT
+//
+// RBIT + CLZ and CLZ, both of which return the operand size for a zero input
+
+__forceinline unsigned int     _tzcnt_u32(unsigned int a)     { return _CountTrailingZeros(a); }
+__forceinline unsigned __int64 _tzcnt_u64(unsigned __int64 a) { return _CountTrailingZeros64(a); }
+__forceinline unsigned int     _lzcnt_u32(unsigned int a)     { return _CountLeadingZeros(a); }
+__forceinline unsigned __int64 _lzcnt_u64(unsigned __int64 a) { return _CountLeadingZeros64(a); }
+
+// BZHI BEXTR
+//
+// Only the low byte of the index, start, and length operands is used.  As in the
+// hardware, an index or length past the operand size keeps all bits, and a start
+// past the operand size returns zero.
+
+__forceinline
+unsigned __int64 sw_bzhi(unsigned __int64 a, unsigned int index, unsigned int bits)
+{
+    index &= 0xFF;
+    return (index >= bits) ? a : (a & ((1ull << index) - 1));
+}
+
+__forceinline
+unsigned __int64 sw_bextr(unsigned __int64 a, unsigned int start, unsigned int len, unsigned int bits)
+{
+    start &= 0xFF;
+    return (start >= bits) ? 0 : sw_bzhi(a >> start, len, bits);
+}
+
+__forceinline unsigned int     _bzhi_u32  (unsigned int a,     unsigned int index) { return (unsigned int)sw_bzhi(a, index, 32); }
+__forceinline unsigned __int64 _bzhi_u64  (unsigned __int64 a, unsigned int index) { return sw_bzhi(a, index, 64); }
+
+__forceinline unsigned int     _bextr_u32 (unsigned int a,     unsigned int start, unsigned int len) { return (unsigned int)sw_bextr(a, start, len, 32); }
+__forceinline unsigned __int64 _bextr_u64 (unsigned __int64 a, unsigned int start, unsigned int len) { return sw_bextr(a, start, len, 64); }
+__forceinline unsigned int     _bextr2_u32(unsigned int a,     unsigned int control) { return (unsigned int)sw_bextr(a, control, control >> 8, 32); }
+__forceinline unsigned __int64 _bextr2_u64(unsigned __int64 a, unsigned __int64 control) { return sw_bextr(a, (unsigned int)control, (unsigned int)control >> 8, 64); }
+
+// PDEP PEXT
+//
+// The mask is split into bytes and each byte into two nibbles, which index a
+// 16x16 table of the 4-bit PDEP or PEXT result.  The bit offset of each byte
+// in the packed value is the exclusive prefix sum of the byte popcounts of the
+// mask, computed for all bytes at once by a SWAR popcount and one multiply.
+// This costs the same fixed ~8 table lookups per 32 bits for any mask, instead
+// of one loop iteration per mask bit.
+
+static const unsigned __int8 sw_pext4[16][16] =  // [mask][value]
+{
+    { 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0 },
+    { 0x0, 0x1, 0x0, 0x1, 0x0, 0x1, 0x0, 0x1, 0x0, 0x1, 0x0, 0x1, 0x0, 0x1, 0x0, 0x1 },
+    { 0x0, 0x0, 0x1, 0x1, 0x0, 0x0, 0x1, 0x1, 0x0, 0x0, 0x1, 0x1, 0x0, 0x0, 0x1, 0x1 },
+    { 0x0, 0x1, 0x2, 0x3, 0x0, 0x1, 0x2, 0x3, 0x0, 0x1, 0x2, 0x3, 0x0, 0x1, 0x2, 0x3 },
+    { 0x0, 0x0, 0x0, 0x0, 0x1, 0x1, 0x1, 0x1, 0x0, 0x0, 0x0, 0x0, 0x1, 0x1, 0x1, 0x1 },
+    { 0x0, 0x1, 0x0, 0x1, 0x2, 0x3, 0x2, 0x3, 0x0, 0x1, 0x0, 0x1, 0x2, 0x3, 0x2, 0x3 },
+    { 0x0, 0x0, 0x1, 0x1, 0x2, 0x2, 0x3, 0x3, 0x0, 0x0, 0x1, 0x1, 0x2, 0x2, 0x3, 0x3 },
+    { 0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7 },
+    { 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x1, 0x1, 0x1, 0x1, 0x1, 0x1, 0x1, 0x1 },
+    { 0x0, 0x1, 0x0, 0x1, 0x0, 0x1, 0x0, 0x1, 0x2, 0x3, 0x2, 0x3, 0x2, 0x3, 0x2, 0x3 },
+    { 0x0, 0x0, 0x1, 0x1, 0x0, 0x0, 0x1, 0x1, 0x2, 0x2, 0x3, 0x3, 0x2, 0x2, 0x3, 0x3 },
+    { 0x0, 0x1, 0x2, 0x3, 0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x4, 0x5, 0x6, 0x7 },
+    { 0x0, 0x0, 0x0, 0x0, 0x1, 0x1, 0x1, 0x1, 0x2, 0x2, 0x2, 0x2, 0x3, 0x3, 0x3, 0x3 },
+    { 0x0, 0x1, 0x0, 0x1, 0x2, 0x3, 0x2, 0x3, 0x4, 0x5, 0x4, 0x5, 0x6, 0x7, 0x6, 0x7 },
+    { 0x0, 0x0, 0x1, 0x1, 0x2, 0x2, 0x3, 0x3, 0x4, 0x4, 0x5, 0x5, 0x6, 0x6, 0x7, 0x7 },
+    { 0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8, 0x9, 0xA, 0xB, 0xC, 0xD, 0xE, 0xF },
+};
+
+static const unsigned __int8 sw_pdep4[16][16] =  // [mask][value]
+{
+    { 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0 },
+    { 0x0, 0x1, 0x0, 0x1, 0x0, 0x1, 0x0, 0x1, 0x0, 0x1, 0x0, 0x1, 0x0, 0x1, 0x0, 0x1 },
+    { 0x0, 0x2, 0x0, 0x2, 0x0, 0x2, 0x0, 0x2, 0x0, 0x2, 0x0, 0x2, 0x0, 0x2, 0x0, 0x2 },
+    { 0x0, 0x1, 0x2, 0x3, 0x0, 0x1, 0x2, 0x3, 0x0, 0x1, 0x2, 0x3, 0x0, 0x1, 0x2, 0x3 },
+    { 0x0, 0x4, 0x0, 0x4, 0x0, 0x4, 0x0, 0x4, 0x0, 0x4, 0x0, 0x4, 0x0, 0x4, 0x0, 0x4 },
+    { 0x0, 0x1, 0x4, 0x5, 0x0, 0x1, 0x4, 0x5, 0x0, 0x1, 0x4, 0x5, 0x0, 0x1, 0x4, 0x5 },
+    { 0x0, 0x2, 0x4, 0x6, 0x0, 0x2, 0x4, 0x6, 0x0, 0x2, 0x4, 0x6, 0x0, 0x2, 0x4, 0x6 },
+    { 0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7 },
+    { 0x0, 0x8, 0x0, 0x8, 0x0, 0x8, 0x0, 0x8, 0x0, 0x8, 0x0, 0x8, 0x0, 0x8, 0x0, 0x8 },
+    { 0x0, 0x1, 0x8, 0x9, 0x0, 0x1, 0x8, 0x9, 0x0, 0x1, 0x8, 0x9, 0x0, 0x1, 0x8, 0x9 },
+    { 0x0, 0x2, 0x8, 0xA, 0x0, 0x2, 0x8, 0xA, 0x0, 0x2, 0x8, 0xA, 0x0, 0x2, 0x8, 0xA },
+    { 0x0, 0x1, 0x2, 0x3, 0x8, 0x9, 0xA, 0xB, 0x0, 0x1, 0x2, 0x3, 0x8, 0x9, 0xA, 0xB },
+    { 0x0, 0x4, 0x8, 0xC, 0x0, 0x4, 0x8, 0xC, 0x0, 0x4, 0x8, 0xC, 0x0, 0x4, 0x8, 0xC },
+    { 0x0, 0x1, 0x4, 0x5, 0x8, 0x9, 0xC, 0xD, 0x0, 0x1, 0x4, 0x5, 0x8, 0x9, 0xC, 0xD },
+    { 0x0, 0x2, 0x4, 0x6, 0x8, 0xA, 0xC, 0xE, 0x0, 0x2, 0x4, 0x6, 0x8, 0xA, 0xC, 0xE },
+    { 0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8, 0x9, 0xA, 0xB, 0xC, 0xD, 0xE, 0xF },
+};
+
+__forceinline
+unsigned __int64 sw_nibble_popcounts(unsigned __int64 mask)
+{
+    unsigned __int64 n = mask - ((mask >> 1) & 0x5555555555555555ull);
+    n = (n & 0x3333333333333333ull) + ((n >> 2) & 0x3333333333333333ull);
+
+    return n;
+}
+
+__forceinline
+unsigned __int64 sw_byte_offsets(unsigned __int64 nibble_counts)
+{
+    unsigned __int64 b = (nibble_counts + (nibble_counts >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+
+    return b * 0x0101010101010100ull;
+}
+
+__forceinline
+unsigned __int64 sw_pext(unsigned __int64 a, unsigned __int64 mask, const unsigned int bytes)
+{
+    const unsigned __int64 nibbles = sw_nibble_popcounts(mask);
+    const unsigned __int64 offsets = sw_byte_offsets(nibbles);
+    unsigned __int64 T = 0;
+
+    for (unsigned int i = 0; i < bytes * 8; i += 8)
+    {
+        const unsigned int m  = (unsigned int)(mask >> i);
+        const unsigned int v  = (unsigned int)(a >> i);
+        const unsigned int lo = sw_pext4[m & 15][v & 15];
+        const unsigned int hi = sw_pext4[(m >> 4) & 15][(v >> 4) & 15];
+        const unsigned int n  = (unsigned int)(nibbles >> i) & 15;
+
+        T |= (unsigned __int64)(lo | (hi << n)) << ((offsets >> i) & 0xFF);
+    }
+
+    return T;
+}
+
+__forceinline
+unsigned __int64 sw_pdep(unsigned __int64 a, unsigned __int64 mask, const unsigned int bytes)
+{
+    const unsigned __int64 nibbles = sw_nibble_popcounts(mask);
+    const unsigned __int64 offsets = sw_byte_offsets(nibbles);
+    unsigned __int64 T = 0;
+
+    for (unsigned int i = 0; i < bytes * 8; i += 8)
+    {
+        const unsigned int m  = (unsigned int)(mask >> i);
+        const unsigned int v  = (unsigned int)(a >> ((offsets >> i) & 0xFF));
+        const unsigned int n  = (unsigned int)(nibbles >> i) & 15;
+        const unsigned int lo = sw_pdep4[m & 15][v & 15];
+        const unsigned int hi = sw_pdep4[(m >> 4) & 15][(v >> n) & 15];
+
+        T |= (unsigned __int64)(lo | (hi << 4)) << i;
+    }
+
+    return T;
+}
+
+__forceinline unsigned int     _pdep_u32(unsigned int a,     unsigned int mask)     { return (unsigned int)sw_pdep(a, mask, 4); }
+__forceinline unsigned __int64 _pdep_u64(unsigned __int64 a, unsigned __int64 mask) { return sw_pdep(a, mask, 8); }
+__forceinline unsigned int     _pext_u32(unsigned int a,     unsigned int mask)     { return (unsigned int)sw_pext(a, mask, 4); }
+__forceinline unsigned __int64 _pext_u64(unsigned __int64 a, unsigned __int64 mask) { return sw_pext(a, mask, 8); }
+
+// MULX RORX SARX SHLX SHRX
+
+__forceinline
+unsigned int _mulx_u32(unsigned int a, unsigned int b, unsigned int * hi)
+{
+    unsigned __int64 T = (unsigned __int64)a * b;
+    *hi = (unsigned int)(T >> 32);
+    return (unsigned int)T;
+}
+
+__forceinline
+unsigned __int64 _mulx_u64(unsigned __int64 a, unsigned __int64 b, unsigned __int64 * hi)
+{
+    *hi = __umulh(a, b);
+    return a * b;
+}
+
+__forceinline unsigned int     _rorx_u32(unsigned int a,     const unsigned int imm8) { return _rotr  (a, imm8 & 31); }
+__forceinline unsigned __int64 _rorx_u64(unsigned __int64 a, const unsigned int imm8) { return _rotr64(a, imm8 & 63); }
+__forceinline int              _sarx_i32(int a,              unsigned int b) { return a >> (b & 31); }
+__forceinline __int64          _sarx_i64(__int64 a,          unsigned int b) { return a >> (b & 63); }
+__forceinline unsigned int     _shlx_u32(unsigned int a,     unsigned int b) { return a << (b & 31); }
+__forceinline unsigned __int64 _shlx_u64(unsigned __int64 a, unsigned int b) { return a << (b & 63); }
+__forceinline unsigned int     _shrx_u32(unsigned int a,     unsigned int b) { return a >> (b & 31); }
+__forceinline unsigned __int64 _shrx_u64(unsigned __int64 a, unsigned int b) { return a >> (b & 63); }
+
+//
+// POPCNT
+//
+// CNT counts the bits of each byte and ADDV sums the bytes.
+//
+
+#define SOFT_INTRINSICS_POPCNT
+
+#undef _mm_popcnt_u32
+#undef _mm_popcnt_u64
+
+__forceinline int     _mm_popcnt_u32(unsigned int a)     { return (int)vaddv_u8(vcnt_u8(vcreate_u8(a))); }
+__forceinline __int64 _mm_popcnt_u64(unsigned __int64 a) { return (__int64)vaddv_u8(vcnt_u8(vcreate_u8(a))); }
+
+//
+// Bulk popcount of a buffer, or of the AND of two buffers (the intersection count
+// of two bitmaps).  Each 64-byte step adds four CNT results, at most 32 per byte,
+// and folds them into eight 16-bit sums with UADALP.  At most 64 is added to a
+// 16-bit sum per step, so they are folded into the 64-bit sums every 1023 steps.
+// This beats a Harley-Seal carry-save adder tree on NEON, where CNT is as cheap
+// as the bitwise operations the tree would save.
+//
+
+#define SW_POPCOUNT_BLOCK_STEPS 1023
+
+__forceinline
+unsigned __int64 sw_popcount_buffer(const unsigned __int8 * pa, const unsigned __int8 * pb, size_t cb)
+{
+    __n128 Sum64 = vdupq_n_u64(0);
+    unsigned __int64 T;
+
+    while (cb >= 64)
+    {
+        size_t steps = cb / 64;
+        __n128 Sum16 = vdupq_n_u16(0);
+
+        if (steps > SW_POPCOUNT_BLOCK_STEPS)
+            steps = SW_POPCOUNT_BLOCK_STEPS;
+
+        cb -= steps * 64;
+
+        do
+        {
+            __n128 X0 = vld1q_u8(pa +  0);
+            __n128 X1 = vld1q_u8(pa + 16);
+            __n128 X2 = vld1q_u8(pa + 32);
+            __n128 X3 = vld1q_u8(pa + 48);
+
+            if (pb != NULL)
+            {
+                X0 = neon_andq(X0, vld1q_u8(pb +  0));
+                X1 = neon_andq(X1, vld1q_u8(pb + 16));
+                X2 = neon_andq(X2, vld1q_u8(pb + 32));
+                X3 = neon_andq(X3, vld1q_u8(pb + 48));
+                pb += 64;
+            }
+
+            __n128 C = vaddq_u8(vaddq_u8(vcntq_u8(X0), vcntq_u8(X1)), vaddq_u8(vcntq_u8(X2), vcntq_u8(X3)));
+            Sum16 = vpadalq_u8(Sum16, C);
+            pa += 64;
+        } while (--steps != 0);
+
+        Sum64 = vpadalq_u32(Sum64, vpaddlq_u16(Sum16));
+    }
+
+    T = vaddvq_u64(Sum64);
+
+    for (; cb >= 16; cb -= 16, pa += 16)
+    {
+        __n128 X = vld1q_u8(pa);
+
+        if (pb != NULL)
+        {
+            X = neon_andq(X, vld1q_u8(pb));
+            pb += 16;
+        }
+
+        T += vaddlvq_u8(vcntq_u8(X));
+    }
+
+    for (; cb != 0; cb--, pa++)
+    {
+        unsigned int x = *pa;
+
+        if (pb != NULL)
+            x &= *pb++;
+
+        T += _mm_popcnt_u32(x);
+    }
+
+    return T;
+}
+
+__forceinline
+unsigned __int64 _nn_popcount_buffer(const void * p, size_t cb)
+{
+    return sw_popcount_buffer((const unsigned __int8 *)p, NULL, cb);
+}
+
+__forceinline
+unsigned __int64 _nn_popcount_and_buffer(const void * pa, const void * pb, size_t cb)
+{
+    return sw_popcount_buffer((const unsigned __int8 *)pa, (const unsigned __int8 *)pb, cb);
+}
+
+//
+// CRC32 (SSE4.2)
+//
+// The SSE4.2 CRC32 instruction computes CRC-32C (Castagnoli) with the same bit
+// reflection as the ARMv8 CRC32C instructions, so these map one to one.
+//
+
+#define SOFT_INTRINSICS_CRC32
+
+#undef _mm_crc32_u8
+#undef _mm_crc32_u16
+#undef _mm_crc32_u32
+#undef _mm_crc32_u64
+
+__forceinline unsigned int     _mm_crc32_u8 (unsigned int crc,     unsigned char v)    { return __crc32cb(crc, v); }
+__forceinline unsigned int     _mm_crc32_u16(unsigned int crc,     unsigned short v)   { return __crc32ch(crc, v); }
+__forceinline unsigned int     _mm_crc32_u32(unsigned int crc,     unsigned int v)     { return __crc32cw(crc, v); }
+__forceinline unsigned __int64 _mm_crc32_u64(unsigned __int64 crc, unsigned __int64 v) { return __crc32cd((unsigned int)crc, v); }
+
+//
+// Bulk CRC-32C of a buffer, returning the same value as _mm_crc32_u8 applied to
+// each byte in turn (so any initial and final inversion is left to the caller).
+//
+// Each 768-byte step checksums three 256-byte streams at once to keep three
+// CRC32CX in flight, then combines them.  CRC is linear, so the CRC of A||B is
+// the CRC of A shifted past the length of B, XOR the CRC of B from zero.  The
+// shift by n bytes is a carry-less multiply by x^(8n-33) mod P followed by one
+// CRC32CX of the 64-bit product, which supplies the remaining x^33 and reduces.
+//
+
+#define SW_CRC32C_STREAM_BYTES  256
+#define SW_CRC32C_SHIFT_256     0xB9E02B86ull   // x^(8*256-33) mod P, bit reflected
+#define SW_CRC32C_SHIFT_512     0xDD7E3B0Cull   // x^(8*512-33) mod P, bit reflected
+
+__forceinline
+unsigned int sw_crc32c_shift(unsigned int crc, unsigned __int64 k)
+{
+    __n128 T = vmull_p64(crc, k);
+
+    return __crc32cd(0, vgetq_lane_u64(T, 0));
+}
+
+__forceinline
+unsigned int _nn_crc32c_buffer(unsigned int crc, const void * p, size_t cb)
+{
+    const unsigned __int8 * pb = (const unsigned __int8 *)p;
+
+    for (; cb >= 3 * SW_CRC32C_STREAM_BYTES; cb -= 3 * SW_CRC32C_STREAM_BYTES, pb += 3 * SW_CRC32C_STREAM_BYTES)
+    {
+        const unsigned __int64 __unaligned * pq = (const unsigned __int64 __unaligned *)pb;
+        unsigned int crc0 = crc;
+        unsigned int crc1 = 0;
+        unsigned int crc2 = 0;
+
+        for (unsigned int i = 0; i < SW_CRC32C_STREAM_BYTES / 8; i++)
+        {
+            crc0 = __crc32cd(crc0, pq[i]);
+            crc1 = __crc32cd(crc1, pq[i + SW_CRC32C_STREAM_BYTES / 8]);
+            crc2 = __crc32cd(crc2, pq[i + SW_CRC32C_STREAM_BYTES / 4]);
+        }
+
+        crc = sw_crc32c_shift(crc0, SW_CRC32C_SHIFT_512) ^ sw_crc32c_shift(crc1, SW_CRC32C_SHIFT_256) ^ crc2;
+    }
+
+    for (; cb >= 8; cb -= 8, pb += 8)
+        crc = __crc32cd(crc, *(const unsigned __int64 __unaligned *)pb);
+
+    for (; cb != 0; cb--, pb++)
+        crc = __crc32cb(crc, *pb);
+
+    return crc;
+}
+
+//
+// AES-NI and VAES
+//
+// AESENC does ShiftRows, SubBytes, MixColumns, then XORs the round key, whereas
+// AESE XORs its key first and then does ShiftRows and SubBytes, with MixColumns a
+// separate AESMC.  Passing a zero key to AESE and XORing the round key after
+// AESMC reorders the ARM steps into the x86 order.  Decryption is the same with
+// AESD and AESIMC.  The AESE/AESMC pair is still fused by cores which do so.
+//
+
+#define SOFT_INTRINSICS_AES
+#define SOFT_INTRINSICS_VAES
+
+#undef _mm_aesenc_si128
+#undef _mm_aesenclast_si128
+#undef _mm_aesdec_si128
+#undef _mm_aesdeclast_si128
+#undef _mm_aesimc_si128
+#undef _mm_aeskeygenassist_si128
+#undef _mm256_aesenc_epi128
+#undef _mm256_aesenclast_epi128
+#undef _mm256_aesdec_epi128
+#undef _mm256_aesdeclast_epi128
+
+__forceinline
+__n128 sw_aesenc_si128(__n128 a, __n128 RoundKey)
+{
+    __n128 T = vaesmcq_u8(vaeseq_u8(a, vdupq_n_u8(0)));
+
+    return neon_eorq(T, RoundKey);
+}
+
+__forceinline
+__n128 sw_aesenclast_si128(__n128 a, __n128 RoundKey)
+{
+    __n128 T = vaeseq_u8(a, vdupq_n_u8(0));
+
+    return neon_eorq(T, RoundKey);
+}
+
+__forceinline
+__n128 sw_aesdec_si128(__n128 a, __n128 RoundKey)
+{
+    __n128 T = vaesimcq_u8(vaesdq_u8(a, vdupq_n_u8(0)));
+
+    return neon_eorq(T, RoundKey);
+}
+
+__forceinline
+__n128 sw_aesdeclast_si128(__n128 a, __n128 RoundKey)
+{
+    __n128 T = vaesdq_u8(a, vdupq_n_u8(0));
+
+    return neon_eorq(T, RoundKey);
+}
+
+__forceinline
+__n128 sw_aesimc_si128(__n128 a)
+{
+    __n128 T = vaesimcq_u8(a);
+
+    return T;
+}
+
+DEFINE_N128_OP_N128_N128(__m128i, aesenc_si128,     sw_aesenc_si128,     __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, aesenclast_si128, sw_aesenclast_si128, __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, aesdec_si128,     sw_aesdec_si128,     __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, aesdeclast_si128, sw_aesdeclast_si128, __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128     (__m128i, aesimc_si128,     sw_aesimc_si128,     __m128i, a, 0)
+
+// AESKEYGENASSIST
+//
+// The result is SubWord(X1), RotWord(SubWord(X1)) ^ rcon, SubWord(X3), RotWord(SubWord(X3)) ^ rcon
+// where X1 and X3 are dwords 1 and 3 of the source.  AESE with a zero key does
+// ShiftRows before SubBytes, so one TBL first gathers the bytes of X1 and X3 to
+// where ShiftRows moves them into the result order.
+
+__forceinline
+__n128 _nn_aeskeygenassist_si128(__n128 a, const int imm8)
+{
+    const __n128 Index = vcombine_u64(vcreate_u64(0x0F0F0505040E0E04ull), vcreate_u64(0x07070D0D0C06060Cull));
+    const __n128 Rcon  = vdupq_n_u64((unsigned __int64)(imm8 & 0xFF) << 32);
+
+    __n128 T = vaeseq_u8(vqtbl1q_u8(a, Index), vdupq_n_u8(0));
+
+    return neon_eorq(T, Rcon);
+}
+
+__forceinline
+__m128i _mm_aeskeygenassist_si128(__m128i a, const int imm8)
+{
+    return _nn128_castn128_si128( _nn_aeskeygenassist_si128(_nn128_castsi128_n128(a), imm8) );
+}
+
+// VAESENC VAESENCLAST VAESDEC VAESDECLAST (each 128-bit lane with its own round key)
+
+DEFINE_N256_OP_N256_N256(__m256i, aesenc_epi128,     sw_aesenc_si128,     __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, aesenclast_epi128, sw_aesenclast_si128, __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, aesdec_epi128,     sw_aesdec_si128,     __m256i, a, __m256i, b, 0)
+DEFINE_N256_OP_N256_N256(__m256i, aesdeclast_epi128, sw_aesdeclast_si128, __m256i, a, __m256i, b, 0)
+
+// PCLMULQDQ and VPCLMULQDQ
+//
+// imm8 bit 0 selects the qword of a and bit 4 the qword of b.  PMULL multiplies
+// the low qwords and PMULL2 the high qwords, so the two mixed selectors first
+// DUP the low qword of one source into its high qword and use PMULL2.  The
+// halves are selected in registers, never through memory.
+//
+
+#define SOFT_INTRINSICS_PCLMULQDQ
+#define SOFT_INTRINSICS_VPCLMULQDQ
+
+#undef _mm_clmulepi64_si128
+#undef _mm256_clmulepi64_epi128
+
+__forceinline
+__n128 sw_clmulepi64_si128(__n128 a, __n128 b, const int imm8)
+{
+    __n128 T;
+
+    switch (imm8 & 0x11)
+    {
+    case 0x00: T = vmull_p64(vgetq_lane_u64(a, 0), vgetq_lane_u64(b, 0)); break;
+    case 0x01: T = vmull_high_p64(a, vdupq_laneq_u64(b, 0)); break;
+    case 0x10: T = vmull_high_p64(vdupq_laneq_u64(a, 0), b); break;
+    default:   T = vmull_high_p64(a, b); break;
+    }
+
+    return T;
+}
+
+__forceinline
+__n128 _nn_clmulepi64_si128(__n128 a, __n128 b, const int imm8)
+{
+    return sw_clmulepi64_si128(a, b, imm8);
+}
+
+__forceinline
+__m128i _mm_clmulepi64_si128(__m128i a, __m128i b, const int imm8)
+{
+    return _nn128_castn128_si128( _nn_clmulepi64_si128(_nn128_castsi128_n128(a), _nn128_castsi128_n128(b), imm8) );
+}
+
+__forceinline
+__n128x2 _nn256_clmulepi64_epi128(__n128x2 a, __n128x2 b, const int imm8)
+{
+    __n128x2 T;
+
+    T.val[0] = sw_clmulepi64_si128(a.val[0], b.val[0], imm8);
+    T.val[1] = sw_clmulepi64_si128(a.val[1], b.val[1], imm8);
+
+    return T;
+}
+
+__forceinline
+__m256i _mm256_clmulepi64_epi128(__m256i a, __m256i b, const int imm8)
+{
+    return _nn256_castn256_si256( _nn256_clmulepi64_epi128(_nn256_castsi256_n256(a), _nn256_castsi256_n256(b), imm8) );
+}
+
+// SHA-NI
+//
+// The x86 SHA-256 state is split as ABEF and CDGH with A in the top dword, while
+// SHA256H and SHA256H2 take ABCD and EFGH with A in dword 0.  The adapters below
+// convert between the two layouts with two permutes each.  SHA256RNDS2 does two
+// rounds and SHA256H does four, but the C and D (G and H) outputs of four rounds
+// are the A and B (E and F) values after the first two, which depend only on the
+// first two message words, so two rounds are read from the upper half of a four
+// round result.  SHA-1 keeps A in the top dword on x86 and in dword 0 on ARM, so
+// the SHA-1 forms reverse the dword order around SHA1C/SHA1P/SHA1M and SHA1SU1.
+// SHA1RNDS4 expects E to be already added into the message, and SHA1C adds a
+// separate E, so E is passed as zero and the round constant is added here.
+//
+
+#define SOFT_INTRINSICS_SHA
+
+#undef _mm_sha256rnds2_epu32
+#undef _mm_sha256msg1_epu32
+#undef _mm_sha256msg2_epu32
+#undef _mm_sha1rnds4_epu32
+#undef _mm_sha1nexte_epu32
+#undef _mm_sha1msg1_epu32
+#undef _mm_sha1msg2_epu32
+
+__forceinline
+__n128 _nn_sha256_abef_cdgh_to_abcd(__n128 abef, __n128 cdgh)
+{
+    return vrev64q_u32(vzip2q_u64(abef, cdgh));
+}
+
+__forceinline
+__n128 _nn_sha256_abef_cdgh_to_efgh(__n128 abef, __n128 cdgh)
+{
+    return vrev64q_u32(vzip1q_u64(abef, cdgh));
+}
+
+__forceinline
+__n128 _nn_sha256_abcd_efgh_to_abef(__n128 abcd, __n128 efgh)
+{
+    return vrev64q_u32(vzip1q_u64(efgh, abcd));
+}
+
+__forceinline
+__n128 _nn_sha256_abcd_efgh_to_cdgh(__n128 abcd, __n128 efgh)
+{
+    return vrev64q_u32(vzip2q_u64(efgh, abcd));
+}
+
+__forceinline
+__n128 sw_sha256rnds2_epu32(__n128 cdgh, __n128 abef, __n128 k)
+{
+    __n128 abcd = _nn_sha256_abef_cdgh_to_abcd(abef, cdgh);
+    __n128 efgh = _nn_sha256_abef_cdgh_to_efgh(abef, cdgh);
+    __n128 wk = vzip1q_u64(k, vdupq_n_u64(0));
+
+    __n128 T0 = vsha256hq_u32(abcd, efgh, wk);
+    __n128 T1 = vsha256h2q_u32(efgh, abcd, wk);
+
+    // the new ABEF is the C, D, G, H of the four round result
+
+    return _nn_sha256_abcd_efgh_to_cdgh(T0, T1);
+}
+
+__forceinline
+__n128 sw_sha256msg1_epu32(__n128 a, __n128 b)
+{
+    return vsha256su0q_u32(a, b);
+}
+
+__forceinline
+__n128 sw_sha256msg2_epu32(__n128 a, __n128 b)
+{
+    // SHA256SU1 also adds W[t-7] from its second and third sources, which
+    // SHA256MSG2 leaves to the caller, so those words are passed as zero.
+
+    return vsha256su1q_u32(a, vdupq_n_u32(0), vsetq_lane_u32(0, b, 0));
+}
+
+__forceinline
+__n128 sw_sha_reverse_epi32(__n128 a)
+{
+    __n128 T = vrev64q_u32(a);
+
+    return vextq_u8(T, T, 8);
+}
+
+__forceinline
+__n128 sw_sha1nexte_epu32(__n128 a, __n128 b)
+{
+    const __n128 Mask = vcombine_u64(vcreate_u64(0), vcreate_u64(0xFFFFFFFF00000000ull));
+
+    __n128 T = vsriq_n_u32(vshlq_n_u32(a, 30), a, 2);
+
+    return vaddq_u32(b, neon_andq(T, Mask));
+}
+
+__forceinline
+__n128 sw_sha1msg1_epu32(__n128 a, __n128 b)
+{
+    return neon_eorq(a, vextq_u32(b, a, 2));
+}
+
+__forceinline
+__n128 sw_sha1msg2_epu32(__n128 a, __n128 b)
+{
+    __n128 T = vsha1su1q_u32(sw_sha_reverse_epi32(a), sw_sha_reverse_epi32(b));
+
+    return sw_sha_reverse_epi32(T);
+}
+
+DEFINE_N128_OP_N128_N128(__m128i, sha256msg1_epu32, sw_sha256msg1_epu32, __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, sha256msg2_epu32, sw_sha256msg2_epu32, __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, sha1nexte_epu32,  sw_sha1nexte_epu32,  __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, sha1msg1_epu32,   sw_sha1msg1_epu32,   __m128i, a, __m128i, b, 0)
+DEFINE_N128_OP_N128_N128(__m128i, sha1msg2_epu32,   sw_sha1msg2_epu32,   __m128i, a, __m128i, b, 0)
+
+__forceinline
+__n128 _nn_sha256rnds2_epu32(__n128 a, __n128 b, __n128 k)
+{
+    return sw_sha256rnds2_epu32(a, b, k);
+}
+
+__forceinline
+__m128i _mm_sha256rnds2_epu32(__m128i a, __m128i b, __m128i k)
+{
+    return _nn128_castn128_si128( _nn_sha256rnds2_epu32(_nn128_castsi128_n128(a), _nn128_castsi128_n128(b), _nn128_castsi128_n128(k)) );
+}
+
+// SHA1RNDS4 (func selects the round function and constant of rounds 0-19, 20-39, 40-59, 60-79)
+
+__forceinline
+__n128 _nn_sha1rnds4_epu32(__n128 a, __n128 b, const int func)
+{
+    __n128 abcd = sw_sha_reverse_epi32(a);
+    __n128 w = sw_sha_reverse_epi32(b);
+    __n128 T;
+
+    switch (func & 3)
+    {
+    case 0:  T = vsha1cq_u32(abcd, 0, vaddq_u32(w, vdupq_n_u32(0x5A827999))); break;
+    case 1:  T = vsha1pq_u32(abcd, 0, vaddq_u32(w, vdupq_n_u32(0x6ED9EBA1))); break;
+    case 2:  T = vsha1mq_u32(abcd, 0, vaddq_u32(w, vdupq_n_u32(0x8F1BBCDC))); break;
+    default: T = vsha1pq_u32(abcd, 0, vaddq_u32(w, vdupq_n_u32(0xCA62C1D6))); break;
+    }
+
+    return sw_sha_reverse_epi32(T);
+}
+
+__forceinline
+__m128i _mm_sha1rnds4_epu32(__m128i a, __m128i b, const int func)
+{
+    return _nn128_castn128_si128( _nn_sha1rnds4_epu32(_nn128_castsi128_n128(a), _nn128_castsi128_n128(b), func) );
+}
+
+// PREFETCHh PREFETCHW CLFLUSH CLFLUSHOPT CLWB LFENCE MFENCE PAUSE
+//
+// Each cache control and fence intrinsic maps to one explicit ARM64 operation:
+//
+//   _mm_prefetch(p, _MM_HINT_T0)    PRFM PLDL1KEEP
+//   _mm_prefetch(p, _MM_HINT_T1)    PRFM PLDL2KEEP
+//   _mm_prefetch(p, _MM_HINT_T2)    PRFM PLDL3KEEP
+//   _mm_prefetch(p, _MM_HINT_NTA)   PRFM PLDL1STRM
+//   _mm_prefetch(p, _MM_HINT_ET0)   PRFM PSTL1KEEP    (also _m_prefetchw)
+//   _mm_prefetch(p, _MM_HINT_ET1)   PRFM PSTL2KEEP
+//   _mm_prefetch(p, _MM_HINT_ET2)   PRFM PSTL3KEEP
+//   _mm_prefetch(p, _MM_HINT_ENTA)  PRFM PSTL1STRM
+//   _mm_clflush(p)                  DC CIVAC, DSB ISH
+//   _mm_clflushopt(p)               DC CIVAC
+//   _mm_clwb(p)                     DC CVAC
+//   _mm_lfence()                    DMB ISHLD
+//   _mm_sfence()                    DMB ISHST         (with the streaming stores)
+//   _mm_mfence()                    DMB ISH
+//   _mm_pause()                     ISB SY            (YIELD with SOFT_INTRINSICS_PAUSE_YIELD)
+//
+// CLFLUSH is ordered against other stores and flushes, so it waits for the
+// DC CIVAC with DSB ISH.  CLFLUSHOPT and CLWB are weakly ordered like on x86
+// and are ordered by a following _mm_sfence or _mm_mfence.
+//
+// LFENCE only orders loads here.  It is not a speculation barrier.
+//
+// YIELD is a NOP on most ARM cores, so a spin loop with it hammers the
+// contended line as fast as the core can.  ISB flushes the pipeline, which
+// takes tens of cycles, closer to the x86 PAUSE delay.  Define
+// SOFT_INTRINSICS_PAUSE_YIELD before including this header to use YIELD.
+//
+
+#define SOFT_INTRINSICS_CACHE_CONTROL
+
+#undef _mm_prefetch
+#undef _m_prefetchw
+#undef _mm_clflush
+#undef _mm_clflushopt
+#undef _mm_clwb
+#undef _mm_lfence
+#undef _mm_mfence
+#undef _mm_pause
+
+#if !defined(_MM_HINT_T0)
+#define _MM_HINT_NTA    0
+#define _MM_HINT_T0     1
+#define _MM_HINT_T1     2
+#define _MM_HINT_T2     3
+#endif
+
+#if !defined(_MM_HINT_ENTA)
+#define _MM_HINT_ENTA   4
+#endif
+#if !defined(_MM_HINT_ET0)
+#define _MM_HINT_ET0    5
+#endif
+#if !defined(_MM_HINT_ET1)
+#define _MM_HINT_ET1    6
+#endif
+#if !defined(_MM_HINT_ET2)
+#define _MM_HINT_ET2    7
+#endif
+
+// PRFM operation: type (0 = PLD, 2 = PST) << 3 | (cache level - 1) << 1 | (1 = STRM)
+
+#define SW_ARM64_PLDL1KEEP      0
+#define SW_ARM64_PLDL1STRM      1
+#define SW_ARM64_PLDL2KEEP      2
+#define SW_ARM64_PLDL3KEEP      4
+#define SW_ARM64_PSTL1KEEP      16
+#define SW_ARM64_PSTL1STRM      17
+#define SW_ARM64_PSTL2KEEP      18
+#define SW_ARM64_PSTL3KEEP      20
+
+// SYS encoding of the data cache maintenance operations for __sys
+
+#define SW_ARM64_SYSINSTR(op1, crn, crm, op2)   (((op1) << 11) | ((crn) << 7) | ((crm) << 3) | (op2))
+#define SW_ARM64_DC_CVAC        SW_ARM64_SYSINSTR(3, 7, 10, 1)
+#define SW_ARM64_DC_CIVAC       SW_ARM64_SYSINSTR(3, 7, 14, 1)
+
+__forceinline
+void _mm_prefetch(char const * p, int sel)
+{
+    switch (sel)
+    {
+    case _MM_HINT_T0:   __prefetch2(p, SW_ARM64_PLDL1KEEP); break;
+    case _MM_HINT_T1:   __prefetch2(p, SW_ARM64_PLDL2KEEP); break;
+    case _MM_HINT_T2:   __prefetch2(p, SW_ARM64_PLDL3KEEP); break;
+    case _MM_HINT_ET0:  __prefetch2(p, SW_ARM64_PSTL1KEEP); break;
+    case _MM_HINT_ET1:  __prefetch2(p, SW_ARM64_PSTL2KEEP); break;
+    case _MM_HINT_ET2:  __prefetch2(p, SW_ARM64_PSTL3KEEP); break;
+    case _MM_HINT_ENTA: __prefetch2(p, SW_ARM64_PSTL1STRM); break;
+    default:            __prefetch2(p, SW_ARM64_PLDL1STRM); break;
+    }
+}
+
+__forceinline
+void _m_prefetchw(volatile const void * p)
+{
+    __prefetch2((const void *)p, SW_ARM64_PSTL1KEEP);
+}
+
+__forceinline
+void _mm_clflush(void const * p)
+{
+    __sys(SW_ARM64_DC_CIVAC, (__int64)p);
+    __dsb(_ARM64_BARRIER_ISH);
+}
+
+__forceinline
+void _mm_clflushopt(void const * p)
+{
+    __sys(SW_ARM64_DC_CIVAC, (__int64)p);
+}
+
+__forceinline
+void _mm_clwb(void const * p)
+{
+    __sys(SW_ARM64_DC_CVAC, (__int64)p);
+}
+
+__forceinline
+void _mm_lfence(void)
+{
+    __dmb(_ARM64_BARRIER_ISHLD);
+}
+
+__forceinline
+void _mm_mfence(void)
+{
+    __dmb(_ARM64_BARRIER_ISH);
+}
+
+__forceinline
+void _mm_pause(void)
+{
+#if defined(SOFT_INTRINSICS_PAUSE_YIELD)
+    __yield();
+#else
+    __isb(_ARM64_BARRIER_SY);
+#endif
+}
 
 
 #pragma strict_gs_check(pop)
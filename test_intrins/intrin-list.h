@@ -25,6 +25,19 @@ DEFINE_TEST_OP_RA  (_mm_cvtt_ss2si,         __int32,    __m128)
 
 DEFINE_TEST_OP_RAB (_mm_cvtsi32_sd,         __m128d,    __m128d,    __int32)
 
+DEFINE_TEST_OP_RA  (_mm_cvtepi8_epi16,      __m128i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm_cvtepi8_epi32,      __m128i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm_cvtepi8_epi64,      __m128i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm_cvtepi16_epi32,     __m128i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm_cvtepi16_epi64,     __m128i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm_cvtepi32_epi64,     __m128i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm_cvtepu8_epi16,      __m128i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm_cvtepu8_epi32,      __m128i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm_cvtepu8_epi64,      __m128i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm_cvtepu16_epi32,     __m128i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm_cvtepu16_epi64,     __m128i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm_cvtepu32_epi64,     __m128i,    __m128i)
+
 DEFINE_TEST_OP_RA  (_mm_cvtepi32_pd,        __m128d,    __m128i)
 DEFINE_TEST_OP_RA  (_mm_cvtepi32_ps,        __m128,     __m128i)
 DEFINE_TEST_OP_RA  (_mm_cvtpd_epi32,        __m128i,    __m128d)
@@ -76,6 +89,13 @@ DEFINE_TEST_OP_RABC(_mm_blendv_pd,          __m128d,    __m128d,    __m128d,
 DEFINE_TEST_OP_RABC(_mm_blendv_ps,          __m128,     __m128,     __m128,     __m128)
 
 DEFINE_TEST_OP_RAB (_mm_sad_epu8,           __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RABI(_mm_mpsadbw_epu8,      __m128i,    __m128i,    __m128i,    0)
+DEFINE_TEST_OP_RABI(_mm_mpsadbw_epu8,      __m128i,    __m128i,    __m128i,    1)
+DEFINE_TEST_OP_RABI(_mm_mpsadbw_epu8,      __m128i,    __m128i,    __m128i,    2)
+DEFINE_TEST_OP_RABI(_mm_mpsadbw_epu8,      __m128i,    __m128i,    __m128i,    3)
+DEFINE_TEST_OP_RABI(_mm_mpsadbw_epu8,      __m128i,    __m128i,    __m128i,    4)
+DEFINE_TEST_OP_RABI(_mm_mpsadbw_epu8,      __m128i,    __m128i,    __m128i,    5)
+DEFINE_TEST_OP_RABI(_mm_mpsadbw_epu8,      __m128i,    __m128i,    __m128i,    7)
 
 DEFINE_TEST_OP_RAB (_mm_sub_epi8,           __m128i,    __m128i,    __m128i)
 DEFINE_TEST_OP_RAB (_mm_sub_epi16,          __m128i,    __m128i,    __m128i)
@@ -162,11 +182,29 @@ DEFINE_TEST_OP_RAB (_mm_mulhi_epu16,        __m128i,    __m128i,    __m128i)
 DEFINE_TEST_OP_RAB (_mm_mulhrs_epi16,       __m128i,    __m128i,    __m128i)
 DEFINE_TEST_OP_RAB (_mm_mullo_epi16,        __m128i,    __m128i,    __m128i)
 DEFINE_TEST_OP_RAB (_mm_mullo_epi32,        __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_madd_epi16,         __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_maddubs_epi16,      __m128i,    __m128i,    __m128i)
+
+DEFINE_TEST_OP_RAB (_mm_cmpeq_epi8,         __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_cmpeq_epi16,        __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_cmpeq_epi32,        __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_cmpeq_epi64,        __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_cmpgt_epi8,         __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_cmpgt_epi16,        __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_cmpgt_epi32,        __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_cmpgt_epi64,        __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_cmplt_epi8,         __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_cmplt_epi16,        __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_cmplt_epi32,        __m128i,    __m128i,    __m128i)
 
 DEFINE_TEST_OP_RA  (_mm_movemask_epi8,      int,        __m128i)
 DEFINE_TEST_OP_RA  (_mm_movemask_pd,        int,        __m128d)
 DEFINE_TEST_OP_RA  (_mm_movemask_ps,        int,        __m128)
 
+DEFINE_TEST_OP_RAB (_mm_testz_si128,        int,        __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_testc_si128,        int,        __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_testnzc_si128,      int,        __m128i,    __m128i)
+
 DEFINE_TEST_OP_RAB (_mm_or_si128,           __m128i,    __m128i,    __m128i)
 DEFINE_TEST_OP_RAB (_mm_or_pd,              __m128d,    __m128d,    __m128d)
 DEFINE_TEST_OP_RAB (_mm_or_ps,              __m128,     __m128,     __m128)
@@ -175,6 +213,34 @@ DEFINE_TEST_OP_RAB (_mm_xor_si128,          __m128i,    __m128i,    __m128i)
 DEFINE_TEST_OP_RAB (_mm_xor_pd,             __m128d,    __m128d,    __m128d)
 DEFINE_TEST_OP_RAB (_mm_xor_ps,             __m128,     __m128,     __m128)
 
+DEFINE_TEST_OP_RAB (_mm_packs_epi16,        __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_packs_epi32,        __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_packus_epi16,       __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_packus_epi32,       __m128i,    __m128i,    __m128i)
+
+DEFINE_TEST_OP_RAB (_mm_unpacklo_epi8,      __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_unpacklo_epi16,     __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_unpacklo_epi32,     __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_unpacklo_epi64,     __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_unpackhi_epi8,      __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_unpackhi_epi16,     __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_unpackhi_epi32,     __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_unpackhi_epi64,     __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_unpacklo_ps,        __m128,     __m128,     __m128)
+DEFINE_TEST_OP_RAB (_mm_unpackhi_ps,        __m128,     __m128,     __m128)
+DEFINE_TEST_OP_RAB (_mm_unpacklo_pd,        __m128d,    __m128d,    __m128d)
+DEFINE_TEST_OP_RAB (_mm_unpackhi_pd,        __m128d,    __m128d,    __m128d)
+
+DEFINE_TEST_OP_RABI(_mm_alignr_epi8,       __m128i,    __m128i,    __m128i,    0)
+DEFINE_TEST_OP_RABI(_mm_alignr_epi8,       __m128i,    __m128i,    __m128i,    1)
+DEFINE_TEST_OP_RABI(_mm_alignr_epi8,       __m128i,    __m128i,    __m128i,    8)
+DEFINE_TEST_OP_RABI(_mm_alignr_epi8,       __m128i,    __m128i,    __m128i,    15)
+DEFINE_TEST_OP_RABI(_mm_alignr_epi8,       __m128i,    __m128i,    __m128i,    16)
+DEFINE_TEST_OP_RABI(_mm_alignr_epi8,       __m128i,    __m128i,    __m128i,    17)
+DEFINE_TEST_OP_RABI(_mm_alignr_epi8,       __m128i,    __m128i,    __m128i,    31)
+DEFINE_TEST_OP_RABI(_mm_alignr_epi8,       __m128i,    __m128i,    __m128i,    32)
+DEFINE_TEST_OP_RABI(_mm_alignr_epi8,       __m128i,    __m128i,    __m128i,    255)
+
 DEFINE_TEST_OP_RA  (_mm_rcp_ps,             __m128,     __m128)
 DEFINE_TEST_OP_RA  (_mm_rcp_ss,             __m128,     __m128)
 
@@ -186,6 +252,31 @@ DEFINE_TEST_OP_RA  (_mm_sqrt_ps,            __m128,     __m128)
 DEFINE_TEST_OP_RAB (_mm_sqrt_sd,            __m128d,    __m128d,    __m128d)
 DEFINE_TEST_OP_RA  (_mm_sqrt_ss,            __m128,     __m128)
 
+DEFINE_TEST_OP_RAI (_mm_round_pd,           __m128d,    __m128d,    0x08)
+DEFINE_TEST_OP_RAI (_mm_round_pd,           __m128d,    __m128d,    0x09)
+DEFINE_TEST_OP_RAI (_mm_round_pd,           __m128d,    __m128d,    0x0A)
+DEFINE_TEST_OP_RAI (_mm_round_pd,           __m128d,    __m128d,    0x0B)
+DEFINE_TEST_OP_RAI (_mm_round_pd,           __m128d,    __m128d,    0x04)
+DEFINE_TEST_OP_RAI (_mm_round_ps,           __m128,     __m128,     0x08)
+DEFINE_TEST_OP_RAI (_mm_round_ps,           __m128,     __m128,     0x09)
+DEFINE_TEST_OP_RAI (_mm_round_ps,           __m128,     __m128,     0x0A)
+DEFINE_TEST_OP_RAI (_mm_round_ps,           __m128,     __m128,     0x0B)
+DEFINE_TEST_OP_RAI (_mm_round_ps,           __m128,     __m128,     0x04)
+DEFINE_TEST_OP_RABI(_mm_round_sd,           __m128d,    __m128d,    __m128d,    0x08)
+DEFINE_TEST_OP_RABI(_mm_round_sd,           __m128d,    __m128d,    __m128d,    0x0B)
+DEFINE_TEST_OP_RABI(_mm_round_sd,           __m128d,    __m128d,    __m128d,    0x04)
+DEFINE_TEST_OP_RABI(_mm_round_ss,           __m128,     __m128,     __m128,     0x08)
+DEFINE_TEST_OP_RABI(_mm_round_ss,           __m128,     __m128,     __m128,     0x0B)
+DEFINE_TEST_OP_RABI(_mm_round_ss,           __m128,     __m128,     __m128,     0x04)
+DEFINE_TEST_OP_RA  (_mm_floor_pd,           __m128d,    __m128d)
+DEFINE_TEST_OP_RA  (_mm_floor_ps,           __m128,     __m128)
+DEFINE_TEST_OP_RAB (_mm_floor_sd,           __m128d,    __m128d,    __m128d)
+DEFINE_TEST_OP_RAB (_mm_floor_ss,           __m128,     __m128,     __m128)
+DEFINE_TEST_OP_RA  (_mm_ceil_pd,            __m128d,    __m128d)
+DEFINE_TEST_OP_RA  (_mm_ceil_ps,            __m128,     __m128)
+DEFINE_TEST_OP_RAB (_mm_ceil_sd,            __m128d,    __m128d,    __m128d)
+DEFINE_TEST_OP_RAB (_mm_ceil_ss,            __m128,     __m128,     __m128)
+
 DEFINE_TEST_OP_RAB (_mm_sll_epi16,          __m128i,    __m128i,    __m128i)
 DEFINE_TEST_OP_RAB (_mm_srl_epi16,          __m128i,    __m128i,    __m128i)
 DEFINE_TEST_OP_RAB (_mm_sra_epi16,          __m128i,    __m128i,    __m128i)
@@ -253,6 +344,24 @@ DEFINE_TEST_OP_RABI(_mm_shuffle_ps,         __m128,     __m128,     __m128,
 DEFINE_TEST_OP_RABI(_mm_shuffle_ps,         __m128,     __m128,     __m128,     0x96)   // 2 1 1 2
 DEFINE_TEST_OP_RABI(_mm_shuffle_ps,         __m128,     __m128,     __m128,     0xFF)   // 3 3 3 3
 
+DEFINE_TEST_OP_RAI (_mm_extract_epi8,       int,        __m128i,    0)
+DEFINE_TEST_OP_RAI (_mm_extract_epi8,       int,        __m128i,    15)
+DEFINE_TEST_OP_RAI (_mm_extract_epi16,      int,        __m128i,    0)
+DEFINE_TEST_OP_RAI (_mm_extract_epi16,      int,        __m128i,    7)
+DEFINE_TEST_OP_RAI (_mm_extract_epi32,      int,        __m128i,    0)
+DEFINE_TEST_OP_RAI (_mm_extract_epi32,      int,        __m128i,    3)
+#if !defined(_M_IX86)
+DEFINE_TEST_OP_RAI (_mm_extract_epi64,      __int64,    __m128i,    0)
+DEFINE_TEST_OP_RAI (_mm_extract_epi64,      __int64,    __m128i,    1)
+#endif
+
+DEFINE_TEST_OP_RABI(_mm_insert_epi8,        __m128i,    __m128i,    int,        9)
+DEFINE_TEST_OP_RABI(_mm_insert_epi16,       __m128i,    __m128i,    int,        6)
+DEFINE_TEST_OP_RABI(_mm_insert_epi32,       __m128i,    __m128i,    int,        1)
+#if !defined(_M_IX86)
+DEFINE_TEST_OP_RABI(_mm_insert_epi64,       __m128i,    __m128i,    __int64,    1)
+#endif
+
 DEFINE_TEST_OP_VAB (_mm_store_pd,                       pdouble,    __m128d)
 DEFINE_TEST_OP_VAB (_mm_store_ps,                       pfloat,     __m128)
 DEFINE_TEST_OP_VAB (_mm_storeu_pd,                      pdouble,    __m128d)
@@ -277,6 +386,25 @@ DEFINE_TEST_OP_RA  (_mm256_cvtsd_f64,       double,     __m256d)
 DEFINE_TEST_OP_RA  (_mm256_cvtss_f32,       float,      __m256)
 DEFINE_TEST_OP_RA  (_mm256_cvtsi256_si32,   __int32,    __m256i)
 
+DEFINE_TEST_OP_RA  (_mm256_cvtepi8_epi16,   __m256i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm256_cvtepi8_epi32,   __m256i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm256_cvtepi8_epi64,   __m256i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm256_cvtepi16_epi32,  __m256i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm256_cvtepi16_epi64,  __m256i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm256_cvtepi32_epi64,  __m256i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm256_cvtepu8_epi16,   __m256i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm256_cvtepu8_epi32,   __m256i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm256_cvtepu8_epi64,   __m256i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm256_cvtepu16_epi32,  __m256i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm256_cvtepu16_epi64,  __m256i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm256_cvtepu32_epi64,  __m256i,    __m128i)
+
+// load-fused widening of the bytes just before a guard page
+
+DEFINE_TEST_KERNEL (_kernel_cvtepu8_epi32_mem_tail)
+DEFINE_TEST_KERNEL (_kernel_cvtepi16_epi64_mem_tail)
+DEFINE_TEST_KERNEL (_kernel_cvtepi8_epi32_mem_tail)
+
 DEFINE_TEST_OP_RA  (_mm256_cvtepi32_pd,     __m256d,    __m128i)
 DEFINE_TEST_OP_RA  (_mm256_cvtepi32_ps,     __m256,     __m256i)
 DEFINE_TEST_OP_RA  (_mm256_cvtpd_epi32,     __m128i,    __m256d)
@@ -335,7 +463,64 @@ DEFINE_TEST_OP_RA  (_mm256_broadcastsi128_si256,__m256i,__m128i)
 DEFINE_TEST_OP_RA  (_mm256_broadcastsd_pd,  __m256d,    __m128d)
 DEFINE_TEST_OP_RA  (_mm256_broadcastss_ps,  __m256,     __m128)
 
+DEFINE_TEST_OP_RAI (_mm256_extractf128_pd,  __m128d,    __m256d,    0)
+DEFINE_TEST_OP_RAI (_mm256_extractf128_pd,  __m128d,    __m256d,    1)
+DEFINE_TEST_OP_RAI (_mm256_extractf128_ps,  __m128,     __m256,     1)
+DEFINE_TEST_OP_RAI (_mm256_extractf128_si256,__m128i,   __m256i,    1)
+DEFINE_TEST_OP_RAI (_mm256_extracti128_si256,__m128i,   __m256i,    0)
+DEFINE_TEST_OP_RAI (_mm256_extracti128_si256,__m128i,   __m256i,    1)
+
+DEFINE_TEST_OP_RABI(_mm256_insertf128_pd,   __m256d,    __m256d,    __m128d,    0)
+DEFINE_TEST_OP_RABI(_mm256_insertf128_pd,   __m256d,    __m256d,    __m128d,    1)
+DEFINE_TEST_OP_RABI(_mm256_insertf128_ps,   __m256,     __m256,     __m128,     1)
+DEFINE_TEST_OP_RABI(_mm256_insertf128_si256,__m256i,    __m256i,    __m128i,    1)
+DEFINE_TEST_OP_RABI(_mm256_inserti128_si256,__m256i,    __m256i,    __m128i,    0)
+DEFINE_TEST_OP_RABI(_mm256_inserti128_si256,__m256i,    __m256i,    __m128i,    1)
+
+DEFINE_TEST_OP_RAI (_mm256_extract_epi8,    int,        __m256i,    0)
+DEFINE_TEST_OP_RAI (_mm256_extract_epi8,    int,        __m256i,    17)
+DEFINE_TEST_OP_RAI (_mm256_extract_epi8,    int,        __m256i,    31)
+DEFINE_TEST_OP_RAI (_mm256_extract_epi16,   int,        __m256i,    3)
+DEFINE_TEST_OP_RAI (_mm256_extract_epi16,   int,        __m256i,    12)
+DEFINE_TEST_OP_RAI (_mm256_extract_epi32,   int,        __m256i,    1)
+DEFINE_TEST_OP_RAI (_mm256_extract_epi32,   int,        __m256i,    6)
+#if !defined(_M_IX86)
+DEFINE_TEST_OP_RAI (_mm256_extract_epi64,   __int64,    __m256i,    0)
+DEFINE_TEST_OP_RAI (_mm256_extract_epi64,   __int64,    __m256i,    3)
+#endif
+
+DEFINE_TEST_OP_RABI(_mm256_insert_epi8,     __m256i,    __m256i,    int,        20)
+DEFINE_TEST_OP_RABI(_mm256_insert_epi16,    __m256i,    __m256i,    int,        5)
+DEFINE_TEST_OP_RABI(_mm256_insert_epi32,    __m256i,    __m256i,    int,        7)
+#if !defined(_M_IX86)
+DEFINE_TEST_OP_RABI(_mm256_insert_epi64,    __m256i,    __m256i,    __int64,    2)
+#endif
+
+DEFINE_TEST_OP_RAB (_mm256_set_m128,        __m256,     __m128,     __m128)
+DEFINE_TEST_OP_RAB (_mm256_set_m128d,       __m256d,    __m128d,    __m128d)
+DEFINE_TEST_OP_RAB (_mm256_set_m128i,       __m256i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm256_setr_m128,       __m256,     __m128,     __m128)
+DEFINE_TEST_OP_RAB (_mm256_setr_m128d,      __m256d,    __m128d,    __m128d)
+DEFINE_TEST_OP_RAB (_mm256_setr_m128i,      __m256i,    __m128i,    __m128i)
+
+// split 128-bit loads and stores, and reduction epilogues built on lane extracts
+
+DEFINE_TEST_KERNEL (_kernel_loadu2_m128)
+DEFINE_TEST_KERNEL (_kernel_loadu2_m128i)
+DEFINE_TEST_KERNEL (_kernel_storeu2_m128d)
+DEFINE_TEST_KERNEL (_kernel_hsum_ps)
+DEFINE_TEST_KERNEL (_kernel_hsum_epi32)
+
 DEFINE_TEST_OP_RAB (_mm256_sad_epu8,        __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RABI(_mm256_mpsadbw_epu8,   __m256i,    __m256i,    __m256i,    0x00)
+DEFINE_TEST_OP_RABI(_mm256_mpsadbw_epu8,   __m256i,    __m256i,    __m256i,    0x05)
+DEFINE_TEST_OP_RABI(_mm256_mpsadbw_epu8,   __m256i,    __m256i,    __m256i,    0x2C)
+DEFINE_TEST_OP_RABI(_mm256_mpsadbw_epu8,   __m256i,    __m256i,    __m256i,    0x3F)
+
+// block matching as done by motion estimation: SAD of a 32x4 block, and the best of 8 offsets per row
+
+DEFINE_TEST_KERNEL (_kernel_sad_epu8_block)
+DEFINE_TEST_KERNEL (_kernel_mpsadbw_epu8_search)
 
 DEFINE_TEST_OP_RAB (_mm256_sub_epi8,        __m256i,    __m256i,    __m256i)
 DEFINE_TEST_OP_RAB (_mm256_sub_epi16,       __m256i,    __m256i,    __m256i)
@@ -396,6 +581,60 @@ DEFINE_TEST_OP_RAB (_mm256_mulhi_epu16,     __m256i,    __m256i,    __m256i)
 DEFINE_TEST_OP_RAB (_mm256_mulhrs_epi16,    __m256i,    __m256i,    __m256i)
 DEFINE_TEST_OP_RAB (_mm256_mullo_epi16,     __m256i,    __m256i,    __m256i)
 DEFINE_TEST_OP_RAB (_mm256_mullo_epi32,     __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_madd_epi16,      __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_maddubs_epi16,   __m256i,    __m256i,    __m256i)
+
+// multiply-add with operands at the saturation and wraparound edges, and int8/int16 dot product throughput
+
+DEFINE_TEST_KERNEL (_kernel_madd_epi16_edges)
+DEFINE_TEST_KERNEL (_kernel_maddubs_epi16_edges)
+DEFINE_TEST_KERNEL (_kernel_madd_epi16_dot)
+DEFINE_TEST_KERNEL (_kernel_maddubs_epi16_dot)
+
+DEFINE_TEST_OP_RAB (_mm256_cmpeq_epi8,      __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_cmpeq_epi16,     __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_cmpeq_epi32,     __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_cmpeq_epi64,     __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_cmpgt_epi8,      __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_cmpgt_epi16,     __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_cmpgt_epi32,     __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_cmpgt_epi64,     __m256i,    __m256i,    __m256i)
+
+DEFINE_TEST_OP_RA  (_mm256_movemask_epi8,   int,        __m256i)
+DEFINE_TEST_OP_RA  (_mm256_movemask_pd,     int,        __m256d)
+DEFINE_TEST_OP_RA  (_mm256_movemask_ps,     int,        __m256)
+
+// movemask compared to the scalar loop it replaces, and compare + movemask per 32-byte block
+
+DEFINE_TEST_KERNEL (_kernel_movemask_epi8_loop)
+DEFINE_TEST_KERNEL (_kernel_cmpeq_movemask_epi8)
+DEFINE_TEST_KERNEL (_kernel_cmpeq_movemask_epi8_loop)
+
+DEFINE_TEST_OP_RAB (_mm_testz_ps,           int,        __m128,     __m128)
+DEFINE_TEST_OP_RAB (_mm_testc_ps,           int,        __m128,     __m128)
+DEFINE_TEST_OP_RAB (_mm_testnzc_ps,         int,        __m128,     __m128)
+DEFINE_TEST_OP_RAB (_mm_testz_pd,           int,        __m128d,    __m128d)
+DEFINE_TEST_OP_RAB (_mm_testc_pd,           int,        __m128d,    __m128d)
+DEFINE_TEST_OP_RAB (_mm_testnzc_pd,         int,        __m128d,    __m128d)
+DEFINE_TEST_OP_RAB (_mm256_testz_si256,     int,        __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_testc_si256,     int,        __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_testnzc_si256,   int,        __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_testz_ps,        int,        __m256,     __m256)
+DEFINE_TEST_OP_RAB (_mm256_testc_ps,        int,        __m256,     __m256)
+DEFINE_TEST_OP_RAB (_mm256_testnzc_ps,      int,        __m256,     __m256)
+DEFINE_TEST_OP_RAB (_mm256_testz_pd,        int,        __m256d,    __m256d)
+DEFINE_TEST_OP_RAB (_mm256_testc_pd,        int,        __m256d,    __m256d)
+DEFINE_TEST_OP_RAB (_mm256_testnzc_pd,      int,        __m256d,    __m256d)
+
+// PTEST feeding a branch, and operands constructed to set ZF or CF
+
+DEFINE_TEST_KERNEL (_kernel_testz_si128_chain)
+DEFINE_TEST_KERNEL (_kernel_testz_si256_chain)
+DEFINE_TEST_KERNEL (_kernel_testc_ps_chain)
+DEFINE_TEST_KERNEL (_kernel_testz_si128_set)
+DEFINE_TEST_KERNEL (_kernel_testc_si256_set)
+DEFINE_TEST_KERNEL (_kernel_testz_pd_set)
+DEFINE_TEST_KERNEL (_kernel_test_all_ones)
 
 DEFINE_TEST_OP_RAB (_mm256_or_si256,        __m256i,    __m256i,    __m256i)
 DEFINE_TEST_OP_RAB (_mm256_or_pd,           __m256d,    __m256d,    __m256d)
@@ -405,6 +644,44 @@ DEFINE_TEST_OP_RAB (_mm256_xor_si256,       __m256i,    __m256i,    __m256i)
 DEFINE_TEST_OP_RAB (_mm256_xor_pd,          __m256d,    __m256d,    __m256d)
 DEFINE_TEST_OP_RAB (_mm256_xor_ps,          __m256,     __m256,     __m256)
 
+DEFINE_TEST_OP_RAB (_mm256_packs_epi16,     __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_packs_epi32,     __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_packus_epi16,    __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_packus_epi32,    __m256i,    __m256i,    __m256i)
+
+DEFINE_TEST_OP_RAB (_mm256_unpacklo_epi8,   __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_unpacklo_epi16,  __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_unpacklo_epi32,  __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_unpacklo_epi64,  __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_unpackhi_epi8,   __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_unpackhi_epi16,  __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_unpackhi_epi32,  __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_unpackhi_epi64,  __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_unpacklo_ps,     __m256,     __m256,     __m256)
+DEFINE_TEST_OP_RAB (_mm256_unpackhi_ps,     __m256,     __m256,     __m256)
+DEFINE_TEST_OP_RAB (_mm256_unpacklo_pd,     __m256d,    __m256d,    __m256d)
+DEFINE_TEST_OP_RAB (_mm256_unpackhi_pd,     __m256d,    __m256d,    __m256d)
+
+// packs and unpacks fixed up across lanes, as used for pixel and sample narrowing
+
+DEFINE_TEST_KERNEL (_kernel_packus_epi16_linear)
+DEFINE_TEST_KERNEL (_kernel_unpack_epi8_linear)
+
+DEFINE_TEST_OP_RABI(_mm256_alignr_epi8,    __m256i,    __m256i,    __m256i,    0)
+DEFINE_TEST_OP_RABI(_mm256_alignr_epi8,    __m256i,    __m256i,    __m256i,    1)
+DEFINE_TEST_OP_RABI(_mm256_alignr_epi8,    __m256i,    __m256i,    __m256i,    8)
+DEFINE_TEST_OP_RABI(_mm256_alignr_epi8,    __m256i,    __m256i,    __m256i,    15)
+DEFINE_TEST_OP_RABI(_mm256_alignr_epi8,    __m256i,    __m256i,    __m256i,    16)
+DEFINE_TEST_OP_RABI(_mm256_alignr_epi8,    __m256i,    __m256i,    __m256i,    17)
+DEFINE_TEST_OP_RABI(_mm256_alignr_epi8,    __m256i,    __m256i,    __m256i,    31)
+DEFINE_TEST_OP_RABI(_mm256_alignr_epi8,    __m256i,    __m256i,    __m256i,    32)
+DEFINE_TEST_OP_RABI(_mm256_alignr_epi8,    __m256i,    __m256i,    __m256i,    255)
+
+// palignr compared to the byte loop of the SDK library, and as used in a 3-tap sliding window
+
+DEFINE_TEST_KERNEL (_kernel_alignr_epi8_loop)
+DEFINE_TEST_KERNEL (_kernel_alignr_epi8_window)
+
 DEFINE_TEST_OP_RA  (_mm256_rcp_ps,          __m256,     __m256)
 
 DEFINE_TEST_OP_RA  (_mm256_rsqrt_ps,        __m256,     __m256)
@@ -412,6 +689,113 @@ DEFINE_TEST_OP_RA  (_mm256_rsqrt_ps,        __m256,     __m256)
 DEFINE_TEST_OP_RA  (_mm256_sqrt_pd,         __m256d,    __m256d)
 DEFINE_TEST_OP_RA  (_mm256_sqrt_ps,         __m256,     __m256)
 
+DEFINE_TEST_OP_RAI (_mm256_round_pd,        __m256d,    __m256d,    0x08)
+DEFINE_TEST_OP_RAI (_mm256_round_pd,        __m256d,    __m256d,    0x09)
+DEFINE_TEST_OP_RAI (_mm256_round_pd,        __m256d,    __m256d,    0x0A)
+DEFINE_TEST_OP_RAI (_mm256_round_pd,        __m256d,    __m256d,    0x0B)
+DEFINE_TEST_OP_RAI (_mm256_round_pd,        __m256d,    __m256d,    0x04)
+DEFINE_TEST_OP_RAI (_mm256_round_ps,        __m256,     __m256,     0x08)
+DEFINE_TEST_OP_RAI (_mm256_round_ps,        __m256,     __m256,     0x09)
+DEFINE_TEST_OP_RAI (_mm256_round_ps,        __m256,     __m256,     0x0A)
+DEFINE_TEST_OP_RAI (_mm256_round_ps,        __m256,     __m256,     0x0B)
+DEFINE_TEST_OP_RAI (_mm256_round_ps,        __m256,     __m256,     0x04)
+DEFINE_TEST_OP_RA  (_mm256_floor_pd,        __m256d,    __m256d)
+DEFINE_TEST_OP_RA  (_mm256_floor_ps,        __m256,     __m256)
+DEFINE_TEST_OP_RA  (_mm256_ceil_pd,         __m256d,    __m256d)
+DEFINE_TEST_OP_RA  (_mm256_ceil_ps,         __m256,     __m256)
+
+// rounding of ties, signed zeros, NaNs (quiet and signalling), infinities, denormals,
+// and values next to the largest non-integral magnitude, in every rounding mode
+
+DEFINE_TEST_KERNEL (_kernel_round_pd_edges)
+DEFINE_TEST_KERNEL (_kernel_round_ps_edges)
+DEFINE_TEST_KERNEL (_kernel_round_sd_edges)
+DEFINE_TEST_KERNEL (_kernel_round_ss_edges)
+
+// every pair of +0, -0, +Inf, -Inf, QNaN, SNaN, +1, -1 for each compare predicate (ps, pd, ss, sd)
+
+DEFINE_TEST_KERNEL (_kernel_cmp_EQ_OQ_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_LT_OS_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_LE_OS_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_UNORD_Q_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_NEQ_UQ_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_NLT_US_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_NLE_US_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_ORD_Q_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_EQ_UQ_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_NGE_US_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_NGT_US_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_FALSE_OQ_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_NEQ_OQ_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_GE_OS_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_GT_OS_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_TRUE_UQ_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_EQ_OS_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_LT_OQ_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_LE_OQ_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_UNORD_S_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_NEQ_US_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_NLT_UQ_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_NLE_UQ_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_ORD_S_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_EQ_US_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_NGE_UQ_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_NGT_UQ_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_FALSE_OS_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_NEQ_OS_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_GE_OQ_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_GT_OQ_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmp_TRUE_US_matrix)
+
+DEFINE_TEST_KERNEL (_kernel_cmpeq_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmplt_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmple_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmpgt_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmpge_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmpneq_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmpnlt_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmpnle_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmpngt_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmpnge_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmpord_matrix)
+DEFINE_TEST_KERNEL (_kernel_cmpunord_matrix)
+
+// FMA3 (single rounding, so results may differ from separate mul + add in the last bit)
+
+DEFINE_TEST_OP_RABC(_mm_fmadd_pd,           __m128d,    __m128d,    __m128d,    __m128d)
+DEFINE_TEST_OP_RABC(_mm_fmadd_ps,           __m128,     __m128,     __m128,     __m128)
+DEFINE_TEST_OP_RABC(_mm_fmadd_sd,           __m128d,    __m128d,    __m128d,    __m128d)
+DEFINE_TEST_OP_RABC(_mm_fmadd_ss,           __m128,     __m128,     __m128,     __m128)
+DEFINE_TEST_OP_RABC(_mm_fmsub_pd,           __m128d,    __m128d,    __m128d,    __m128d)
+DEFINE_TEST_OP_RABC(_mm_fmsub_ps,           __m128,     __m128,     __m128,     __m128)
+DEFINE_TEST_OP_RABC(_mm_fmsub_sd,           __m128d,    __m128d,    __m128d,    __m128d)
+DEFINE_TEST_OP_RABC(_mm_fmsub_ss,           __m128,     __m128,     __m128,     __m128)
+DEFINE_TEST_OP_RABC(_mm_fnmadd_pd,          __m128d,    __m128d,    __m128d,    __m128d)
+DEFINE_TEST_OP_RABC(_mm_fnmadd_ps,          __m128,     __m128,     __m128,     __m128)
+DEFINE_TEST_OP_RABC(_mm_fnmadd_sd,          __m128d,    __m128d,    __m128d,    __m128d)
+DEFINE_TEST_OP_RABC(_mm_fnmadd_ss,          __m128,     __m128,     __m128,     __m128)
+DEFINE_TEST_OP_RABC(_mm_fnmsub_pd,          __m128d,    __m128d,    __m128d,    __m128d)
+DEFINE_TEST_OP_RABC(_mm_fnmsub_ps,          __m128,     __m128,     __m128,     __m128)
+DEFINE_TEST_OP_RABC(_mm_fnmsub_sd,          __m128d,    __m128d,    __m128d,    __m128d)
+DEFINE_TEST_OP_RABC(_mm_fnmsub_ss,          __m128,     __m128,     __m128,     __m128)
+DEFINE_TEST_OP_RABC(_mm_fmaddsub_pd,        __m128d,    __m128d,    __m128d,    __m128d)
+DEFINE_TEST_OP_RABC(_mm_fmaddsub_ps,        __m128,     __m128,     __m128,     __m128)
+DEFINE_TEST_OP_RABC(_mm_fmsubadd_pd,        __m128d,    __m128d,    __m128d,    __m128d)
+DEFINE_TEST_OP_RABC(_mm_fmsubadd_ps,        __m128,     __m128,     __m128,     __m128)
+
+DEFINE_TEST_OP_RABC(_mm256_fmadd_pd,        __m256d,    __m256d,    __m256d,    __m256d)
+DEFINE_TEST_OP_RABC(_mm256_fmadd_ps,        __m256,     __m256,     __m256,     __m256)
+DEFINE_TEST_OP_RABC(_mm256_fmsub_pd,        __m256d,    __m256d,    __m256d,    __m256d)
+DEFINE_TEST_OP_RABC(_mm256_fmsub_ps,        __m256,     __m256,     __m256,     __m256)
+DEFINE_TEST_OP_RABC(_mm256_fnmadd_pd,       __m256d,    __m256d,    __m256d,    __m256d)
+DEFINE_TEST_OP_RABC(_mm256_fnmadd_ps,       __m256,     __m256,     __m256,     __m256)
+DEFINE_TEST_OP_RABC(_mm256_fnmsub_pd,       __m256d,    __m256d,    __m256d,    __m256d)
+DEFINE_TEST_OP_RABC(_mm256_fnmsub_ps,       __m256,     __m256,     __m256,     __m256)
+DEFINE_TEST_OP_RABC(_mm256_fmaddsub_pd,     __m256d,    __m256d,    __m256d,    __m256d)
+DEFINE_TEST_OP_RABC(_mm256_fmaddsub_ps,     __m256,     __m256,     __m256,     __m256)
+DEFINE_TEST_OP_RABC(_mm256_fmsubadd_pd,     __m256d,    __m256d,    __m256d,    __m256d)
+DEFINE_TEST_OP_RABC(_mm256_fmsubadd_ps,     __m256,     __m256,     __m256,     __m256)
+
 DEFINE_TEST_OP_RAB (_mm256_sll_epi16,       __m256i,    __m256i,    __m128i)
 DEFINE_TEST_OP_RAB (_mm256_srl_epi16,       __m256i,    __m256i,    __m128i)
 DEFINE_TEST_OP_RAB (_mm256_sra_epi16,       __m256i,    __m256i,    __m128i)
@@ -474,6 +858,42 @@ DEFINE_TEST_OP_RA  (_mm256_castsi256_si128, __m128i,    __m256i)
 DEFINE_TEST_OP_RABI(_mm256_permute2f128_pd, __m256d,    __m256d,    __m256d,     0)
 DEFINE_TEST_OP_RABI(_mm256_permute2f128_pd, __m256d,    __m256d,    __m256d,     1)
 
+DEFINE_TEST_OP_RABI(_mm256_permute2x128_si256, __m256i, __m256i,    __m256i,     0x20)
+DEFINE_TEST_OP_RABI(_mm256_permute2x128_si256, __m256i, __m256i,    __m256i,     0x31)
+DEFINE_TEST_OP_RABI(_mm256_permute2x128_si256, __m256i, __m256i,    __m256i,     0x83)
+
+DEFINE_TEST_OP_RAI (_mm256_permute4x64_epi64,__m256i,   __m256i,    0xE4)               // 3 2 1 0
+DEFINE_TEST_OP_RAI (_mm256_permute4x64_epi64,__m256i,   __m256i,    0x4E)               // 1 0 3 2
+DEFINE_TEST_OP_RAI (_mm256_permute4x64_epi64,__m256i,   __m256i,    0xD8)               // 3 1 2 0
+DEFINE_TEST_OP_RAI (_mm256_permute4x64_epi64,__m256i,   __m256i,    0x1B)               // 0 1 2 3
+DEFINE_TEST_OP_RAI (_mm256_permute4x64_epi64,__m256i,   __m256i,    0xAA)               // 2 2 2 2
+DEFINE_TEST_OP_RAI (_mm256_permute4x64_epi64,__m256i,   __m256i,    0x93)               // 2 1 0 3
+DEFINE_TEST_OP_RAI (_mm256_permute4x64_pd,  __m256d,    __m256d,    0x39)               // 0 3 2 1
+DEFINE_TEST_OP_RAI (_mm256_permute4x64_pd,  __m256d,    __m256d,    0xB1)               // 2 3 0 1
+
+DEFINE_TEST_OP_RAB (_mm256_permutevar8x32_epi32,__m256i,__m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_permutevar8x32_ps,__m256,    __m256,     __m256i)
+
+DEFINE_TEST_OP_RAB (_mm_permutevar_pd,      __m128d,    __m128d,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_permutevar_ps,      __m128,     __m128,     __m128i)
+DEFINE_TEST_OP_RAB (_mm256_permutevar_pd,   __m256d,    __m256d,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_permutevar_ps,   __m256,     __m256,     __m256i)
+
+// AVX2 gathers (see test-kernels.h for the index patterns)
+
+DEFINE_TEST_KERNEL (_kernel_i32gather_epi32_seq)
+DEFINE_TEST_KERNEL (_kernel_i32gather_epi32_stride)
+DEFINE_TEST_KERNEL (_kernel_i32gather_epi32_random)
+DEFINE_TEST_KERNEL (_kernel_i32gather_ps_seq)
+DEFINE_TEST_KERNEL (_kernel_i32gather_ps_stride)
+DEFINE_TEST_KERNEL (_kernel_i32gather_ps_random)
+DEFINE_TEST_KERNEL (_kernel_i64gather_pd_seq)
+DEFINE_TEST_KERNEL (_kernel_i64gather_pd_stride)
+DEFINE_TEST_KERNEL (_kernel_i64gather_pd_random)
+DEFINE_TEST_KERNEL (_kernel_mask_i64gather_pd_seq)
+DEFINE_TEST_KERNEL (_kernel_mask_i64gather_pd_stride)
+DEFINE_TEST_KERNEL (_kernel_mask_i64gather_pd_random)
+
 DEFINE_TEST_OP_RA  (_mm256_load_pd,         __m256d,    pdouble)
 DEFINE_TEST_OP_RA  (_mm256_load_ps,         __m256,     pfloat)
 DEFINE_TEST_OP_RA  (_mm256_loadu_pd,        __m256d,    pdouble)
@@ -507,6 +927,278 @@ DEFINE_TEST_OP_VAB (_mm256_store_ps,                    pfloat,     __m256)
 DEFINE_TEST_OP_VAB (_mm256_storeu_pd,                   pdouble,    __m256d)
 DEFINE_TEST_OP_VAB (_mm256_storeu_ps,                   pfloat,     __m256)
 
+// masked loads and stores of an array tail ending at a guard page
+
+DEFINE_TEST_KERNEL (_kernel_maskload_ps_tail)
+DEFINE_TEST_KERNEL (_kernel_maskload_epi32_tail)
+DEFINE_TEST_KERNEL (_kernel_maskload_pd_tail)
+DEFINE_TEST_KERNEL (_kernel_maskload_epi64_tail)
+DEFINE_TEST_KERNEL (_kernel_maskstore_epi32_tail)
+DEFINE_TEST_KERNEL (_kernel_maskstore_pd_tail)
+
+// BMI1 BMI2 LZCNT scalar bit manipulation (present on all AVX2 capable processors)
+
+DEFINE_TEST_OP_RA  (_blsi_u32,              __int32,    __int32)
+DEFINE_TEST_OP_RA  (_blsmsk_u32,            __int32,    __int32)
+DEFINE_TEST_OP_RA  (_blsr_u32,              __int32,    __int32)
+DEFINE_TEST_OP_RA  (_tzcnt_u32,             __int32,    __int32)
+DEFINE_TEST_OP_RA  (_lzcnt_u32,             __int32,    __int32)
+DEFINE_TEST_OP_RAB (_andn_u32,              __int32,    __int32,    __int32)
+DEFINE_TEST_OP_RAB (_bzhi_u32,              __int32,    __int32,    __int32)
+DEFINE_TEST_OP_RAB (_bextr2_u32,            __int32,    __int32,    __int32)
+DEFINE_TEST_OP_RAB (_pdep_u32,              __int32,    __int32,    __int32)
+DEFINE_TEST_OP_RAB (_pext_u32,              __int32,    __int32,    __int32)
+DEFINE_TEST_OP_RAB (_sarx_i32,              __int32,    __int32,    __int32)
+DEFINE_TEST_OP_RAB (_shlx_u32,              __int32,    __int32,    __int32)
+DEFINE_TEST_OP_RAB (_shrx_u32,              __int32,    __int32,    __int32)
+DEFINE_TEST_OP_RAI (_rorx_u32,              __int32,    __int32,    1)
+DEFINE_TEST_OP_RAI (_rorx_u32,              __int32,    __int32,    31)
+
+// three argument BEXTR with fields in range, straddling bit 32, and zero start or length, and MULX
+
+DEFINE_TEST_KERNEL (_kernel_bextr_u32_fields)
+DEFINE_TEST_KERNEL (_kernel_mulx_u32)
+
+DEFINE_TEST_OP_RA  (_mm_popcnt_u32,         __int32,    __int32)
+
+DEFINE_TEST_OP_RAB (_mm_crc32_u8,           __int32,    __int32,    __int8)
+DEFINE_TEST_OP_RAB (_mm_crc32_u16,          __int32,    __int32,    __int16)
+DEFINE_TEST_OP_RAB (_mm_crc32_u32,          __int32,    __int32,    __int32)
+
+DEFINE_TEST_OP_RAB (_mm_aesenc_si128,       __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_aesenclast_si128,   __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_aesdec_si128,       __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_aesdeclast_si128,   __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RA  (_mm_aesimc_si128,       __m128i,    __m128i)
+DEFINE_TEST_OP_RAI (_mm_aeskeygenassist_si128, __m128i, __m128i,    0x01)
+DEFINE_TEST_OP_RAI (_mm_aeskeygenassist_si128, __m128i, __m128i,    0x36)
+
+// AES-128 FIPS-197 known answer and key schedule, and CTR keystream with AESENC
+
+DEFINE_TEST_KERNEL (_kernel_aes128_fips197)
+DEFINE_TEST_KERNEL (_kernel_aes128_keyexpand)
+DEFINE_TEST_KERNEL (_kernel_aes128_ctr)
+
+DEFINE_TEST_OP_RABI(_mm_clmulepi64_si128,   __m128i,    __m128i,    __m128i,    0x00)
+DEFINE_TEST_OP_RABI(_mm_clmulepi64_si128,   __m128i,    __m128i,    __m128i,    0x01)
+DEFINE_TEST_OP_RABI(_mm_clmulepi64_si128,   __m128i,    __m128i,    __m128i,    0x10)
+DEFINE_TEST_OP_RABI(_mm_clmulepi64_si128,   __m128i,    __m128i,    __m128i,    0x11)
+
+// carry-less multiply vectors, and GHASH with one reduction per block and per 4 blocks
+
+DEFINE_TEST_KERNEL (_kernel_clmul_vectors)
+DEFINE_TEST_KERNEL (_kernel_clmul_vectors_mixed)
+DEFINE_TEST_KERNEL (_kernel_ghash_known_answer)
+DEFINE_TEST_KERNEL (_kernel_ghash_serial)
+DEFINE_TEST_KERNEL (_kernel_ghash_aggregated)
+
+DEFINE_TEST_OP_RA  (_mm_cvtph_ps,           __m128,     __m128i)
+DEFINE_TEST_OP_RA  (_mm256_cvtph_ps,        __m256,     __m128i)
+DEFINE_TEST_OP_RAI (_mm_cvtps_ph,           __m128i,    __m128,     0)
+DEFINE_TEST_OP_RAI (_mm_cvtps_ph,           __m128i,    __m128,     4)
+DEFINE_TEST_OP_RAI (_mm256_cvtps_ph,        __m128i,    __m256,     0)
+DEFINE_TEST_OP_RAI (_mm256_cvtps_ph,        __m128i,    __m256,     1)
+DEFINE_TEST_OP_RAI (_mm256_cvtps_ph,        __m128i,    __m256,     2)
+DEFINE_TEST_OP_RAI (_mm256_cvtps_ph,        __m128i,    __m256,     3)
+DEFINE_TEST_OP_RAI (_mm256_cvtps_ph,        __m128i,    __m256,     4)
+DEFINE_TEST_OP_RA  (_cvtsh_ss,              float,      __int16)
+DEFINE_TEST_OP_RAI (_cvtss_sh,              __int16,    float,      0)
+DEFINE_TEST_OP_RAI (_cvtss_sh,              __int16,    float,      4)
+
+// fp16 conversion of edge values in every rounding mode, and of a buffer
+
+DEFINE_TEST_KERNEL (_kernel_cvtps_ph_edges)
+DEFINE_TEST_KERNEL (_kernel_cvtph_ps_edges)
+DEFINE_TEST_KERNEL (_kernel_cvtss_sh_edges)
+DEFINE_TEST_KERNEL (_kernel_cvtps_ph_buffer)
+
+// streaming stores and loads, and ordinary versus streaming fill bandwidth
+
+DEFINE_TEST_KERNEL (_kernel_stream_roundtrip)
+DEFINE_TEST_KERNEL (_kernel_fill_store_1mb)
+DEFINE_TEST_KERNEL (_kernel_fill_stream_1mb)
+DEFINE_TEST_KERNEL (_kernel_fill_store_16mb)
+DEFINE_TEST_KERNEL (_kernel_fill_stream_16mb)
+DEFINE_TEST_KERNEL (_kernel_fill_store_256mb)
+DEFINE_TEST_KERNEL (_kernel_fill_stream_256mb)
+#if !defined(_M_IX86)
+DEFINE_TEST_KERNEL (_kernel_fill_store_1gb)
+DEFINE_TEST_KERNEL (_kernel_fill_stream_1gb)
+#endif
+
+// spin lock with PAUSE alone and contended, fences, flush, prefetch hints, and pointer chasing with prefetch
+
+DEFINE_TEST_KERNEL (_kernel_spinlock_uncontended)
+DEFINE_TEST_KERNEL (_kernel_spinlock_contended)
+DEFINE_TEST_KERNEL (_kernel_spinlock_stop_contender)
+DEFINE_TEST_KERNEL (_kernel_pause)
+DEFINE_TEST_KERNEL (_kernel_fences)
+DEFINE_TEST_KERNEL (_kernel_clflush)
+DEFINE_TEST_KERNEL (_kernel_prefetch_hints)
+DEFINE_TEST_KERNEL (_kernel_pointer_chase_plain)
+DEFINE_TEST_KERNEL (_kernel_pointer_chase_t0)
+DEFINE_TEST_KERNEL (_kernel_pointer_chase_nta)
+
+DEFINE_TEST_OP_RABI(_mm_cmpistri,           __int32,    __m128i,    __m128i,    0x00)
+DEFINE_TEST_OP_RABI(_mm_cmpistri,           __int32,    __m128i,    __m128i,    0x06)
+DEFINE_TEST_OP_RABI(_mm_cmpistri,           __int32,    __m128i,    __m128i,    0x09)
+DEFINE_TEST_OP_RABI(_mm_cmpistri,           __int32,    __m128i,    __m128i,    0x0C)
+DEFINE_TEST_OP_RABI(_mm_cmpistri,           __int32,    __m128i,    __m128i,    0x4D)
+DEFINE_TEST_OP_RABI(_mm_cmpistri,           __int32,    __m128i,    __m128i,    0x3A)
+DEFINE_TEST_OP_RABI(_mm_cmpistrm,           __m128i,    __m128i,    __m128i,    0x00)
+DEFINE_TEST_OP_RABI(_mm_cmpistrm,           __m128i,    __m128i,    __m128i,    0x44)
+DEFINE_TEST_OP_RABI(_mm_cmpistrm,           __m128i,    __m128i,    __m128i,    0x19)
+DEFINE_TEST_OP_RABI(_mm_cmpistrm,           __m128i,    __m128i,    __m128i,    0x4F)
+DEFINE_TEST_OP_RABI(_mm_cmpistra,           __int32,    __m128i,    __m128i,    0x0C)
+DEFINE_TEST_OP_RABI(_mm_cmpistrc,           __int32,    __m128i,    __m128i,    0x00)
+DEFINE_TEST_OP_RABI(_mm_cmpistro,           __int32,    __m128i,    __m128i,    0x08)
+DEFINE_TEST_OP_RABI(_mm_cmpistrs,           __int32,    __m128i,    __m128i,    0x01)
+DEFINE_TEST_OP_RABI(_mm_cmpistrz,           __int32,    __m128i,    __m128i,    0x00)
+
+// string compares in each aggregation mode and element type with explicit and implicit lengths
+
+DEFINE_TEST_KERNEL (_kernel_cmpestr_equal_any)
+DEFINE_TEST_KERNEL (_kernel_cmpestr_ranges)
+DEFINE_TEST_KERNEL (_kernel_cmpestr_equal_each)
+DEFINE_TEST_KERNEL (_kernel_cmpestr_equal_ordered)
+DEFINE_TEST_KERNEL (_kernel_cmpistr_equal_any)
+DEFINE_TEST_KERNEL (_kernel_cmpistr_ranges)
+DEFINE_TEST_KERNEL (_kernel_cmpistr_equal_each)
+DEFINE_TEST_KERNEL (_kernel_cmpistr_equal_ordered)
+
+// HTTP header delimiter scan with PCMPESTRI and CSV tokenizer with PCMPESTRM
+
+DEFINE_TEST_KERNEL (_kernel_http_header_scan)
+DEFINE_TEST_KERNEL (_kernel_csv_tokenize)
+
+// these are not 32-bit x86 compatible
+#if !defined(_M_IX86)
+DEFINE_TEST_OP_RA  (_blsi_u64,              __int64,    __int64)
+DEFINE_TEST_OP_RA  (_blsmsk_u64,            __int64,    __int64)
+DEFINE_TEST_OP_RA  (_blsr_u64,              __int64,    __int64)
+DEFINE_TEST_OP_RA  (_tzcnt_u64,             __int64,    __int64)
+DEFINE_TEST_OP_RA  (_lzcnt_u64,             __int64,    __int64)
+DEFINE_TEST_OP_RAB (_andn_u64,              __int64,    __int64,    __int64)
+DEFINE_TEST_OP_RAB (_bzhi_u64,              __int64,    __int64,    __int32)
+DEFINE_TEST_OP_RAB (_bextr2_u64,            __int64,    __int64,    __int64)
+DEFINE_TEST_OP_RAB (_pdep_u64,              __int64,    __int64,    __int64)
+DEFINE_TEST_OP_RAB (_pext_u64,              __int64,    __int64,    __int64)
+DEFINE_TEST_OP_RAB (_sarx_i64,              __int64,    __int64,    __int32)
+DEFINE_TEST_OP_RAB (_shlx_u64,              __int64,    __int64,    __int32)
+DEFINE_TEST_OP_RAB (_shrx_u64,              __int64,    __int64,    __int32)
+DEFINE_TEST_OP_RAI (_rorx_u64,              __int64,    __int64,    1)
+DEFINE_TEST_OP_RAI (_rorx_u64,              __int64,    __int64,    63)
+
+DEFINE_TEST_OP_RA  (_mm_popcnt_u64,         __int64,    __int64)
+
+// bitmap intersection counts: AVX2 nibble lookup idiom, bulk popcount helper, and POPCNT loop
+
+DEFINE_TEST_KERNEL (_kernel_popcount_nibble_epi8)
+DEFINE_TEST_KERNEL (_kernel_popcount_and_buffer)
+DEFINE_TEST_KERNEL (_kernel_popcnt_u64_loop)
+
+DEFINE_TEST_OP_RAB (_mm_crc32_u64,          __int64,    __int64,    __int64)
+
+// CRC-32C of a buffer with one dependent CRC32 chain, and with the interleaved bulk helper
+
+DEFINE_TEST_KERNEL (_kernel_crc32_u64_loop)
+DEFINE_TEST_KERNEL (_kernel_crc32c_buffer)
+
+// three argument BEXTR with fields in range, straddling bit 64, and zero start or length
+
+DEFINE_TEST_KERNEL (_kernel_bextr_u64_fields)
+
+// PEXT and PDEP over sparse (bitboard) and dense (rank/select) masks, and a set bit scan
+
+DEFINE_TEST_KERNEL (_kernel_mulx_u64)
+DEFINE_TEST_KERNEL (_kernel_pext_u64_sparse)
+DEFINE_TEST_KERNEL (_kernel_pext_u64_dense)
+DEFINE_TEST_KERNEL (_kernel_pdep_u64_sparse)
+DEFINE_TEST_KERNEL (_kernel_pdep_u64_dense)
+DEFINE_TEST_KERNEL (_kernel_tzcnt_u64_bitscan)
+#endif
+
+#if defined(TEST_AVX_VNNI)
+
+// AVX-VNNI
+
+DEFINE_TEST_OP_RABC(_mm_dpbusd_avx_epi32,   __m128i,    __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RABC(_mm_dpbusds_avx_epi32,  __m128i,    __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RABC(_mm_dpwssd_avx_epi32,   __m128i,    __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RABC(_mm_dpwssds_avx_epi32,  __m128i,    __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RABC(_mm256_dpbusd_avx_epi32,__m256i,    __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RABC(_mm256_dpbusds_avx_epi32,__m256i,   __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RABC(_mm256_dpwssd_avx_epi32,__m256i,    __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RABC(_mm256_dpwssds_avx_epi32,__m256i,   __m256i,    __m256i,    __m256i)
+
+// accumulators next to INT_MAX / INT_MIN to hit the saturating cases, and int8 dot product throughput
+
+DEFINE_TEST_KERNEL (_kernel_dpbusds_epi32_edges)
+DEFINE_TEST_KERNEL (_kernel_dpwssds_epi32_edges)
+DEFINE_TEST_KERNEL (_kernel_dpbusd_epi32_dot)
+
+#endif // AVX-VNNI tests
+
+#if defined(TEST_VAES)
+
+// VAES
+
+DEFINE_TEST_OP_RAB (_mm256_aesenc_epi128,   __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_aesenclast_epi128, __m256i,  __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_aesdec_epi128,   __m256i,    __m256i,    __m256i)
+DEFINE_TEST_OP_RAB (_mm256_aesdeclast_epi128, __m256i,  __m256i,    __m256i)
+
+// CTR keystream with VAESENC, two blocks per instruction
+
+DEFINE_TEST_KERNEL (_kernel_vaes_ctr)
+
+#endif // VAES tests
+
+#if defined(TEST_VPCLMULQDQ)
+
+// VPCLMULQDQ
+
+DEFINE_TEST_OP_RABI(_mm256_clmulepi64_epi128, __m256i,  __m256i,    __m256i,    0x00)
+DEFINE_TEST_OP_RABI(_mm256_clmulepi64_epi128, __m256i,  __m256i,    __m256i,    0x11)
+
+// carry-less multiply of two 128-bit lanes per instruction
+
+DEFINE_TEST_KERNEL (_kernel_vpclmul_vectors)
+
+#endif // VPCLMULQDQ tests
+
+#if defined(TEST_SHA)
+
+// SHA-NI
+
+DEFINE_TEST_OP_RABC(_mm_sha256rnds2_epu32,  __m128i,    __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_sha256msg1_epu32,   __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_sha256msg2_epu32,   __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RABI(_mm_sha1rnds4_epu32,    __m128i,    __m128i,    __m128i,    0)
+DEFINE_TEST_OP_RABI(_mm_sha1rnds4_epu32,    __m128i,    __m128i,    __m128i,    1)
+DEFINE_TEST_OP_RABI(_mm_sha1rnds4_epu32,    __m128i,    __m128i,    __m128i,    2)
+DEFINE_TEST_OP_RABI(_mm_sha1rnds4_epu32,    __m128i,    __m128i,    __m128i,    3)
+DEFINE_TEST_OP_RAB (_mm_sha1nexte_epu32,    __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_sha1msg1_epu32,     __m128i,    __m128i,    __m128i)
+DEFINE_TEST_OP_RAB (_mm_sha1msg2_epu32,     __m128i,    __m128i,    __m128i)
+
+// SHA-256 and SHA-1 NIST known answers, and hashing throughput
+
+DEFINE_TEST_KERNEL (_kernel_sha256_nist)
+DEFINE_TEST_KERNEL (_kernel_sha1_nist)
+DEFINE_TEST_KERNEL (_kernel_sha256_buffer)
+DEFINE_TEST_KERNEL (_kernel_sha1_buffer)
+
+#endif // SHA tests
+
+#if defined(TEST_CLWB)
+
+// CLFLUSHOPT and CLWB
+
+DEFINE_TEST_KERNEL (_kernel_clflushopt_clwb)
+
+#endif // CLFLUSHOPT and CLWB tests
+
 #if defined(__AVX2512F__) || (defined(USE_SOFT_INTRINSICS) && (USE_SOFT_INTRINSICS >= 3))
 
 // Post-AVX2 (not supported by Prism or Rosetta at this time April 2025)
@@ -11,6 +11,21 @@ cl -FAsc -Zi -O2 -I../dvec_demo -I.. -arch:SSE4.2 -Tc test-intrins.c -link -out:
 @rem SSE4+AVX2 native 64-bit x64 build
 cl -FAsc -Zi -O2 -I../dvec_demo -I.. -arch:AVX2   -Tc test-intrins.c -link -out:test-intrins-x64-avx2.exe -debug -release -incremental:no
 
+@rem SSE4+AVX2+AVX-VNNI native 64-bit x64 build (only runs on Alder Lake, Zen 5, or later)
+cl -FAsc -Zi -O2 -I../dvec_demo -I.. -arch:AVX2 -DTEST_AVX_VNNI -Tc test-intrins.c -link -out:test-intrins-x64-vnni.exe -debug -release -incremental:no
+
+@rem SSE4+AVX2+VAES native 64-bit x64 build (only runs on Ice Lake, Zen 3, or later)
+cl -FAsc -Zi -O2 -I../dvec_demo -I.. -arch:AVX2 -DTEST_VAES -Tc test-intrins.c -link -out:test-intrins-x64-vaes.exe -debug -release -incremental:no
+
+@rem SSE4+AVX2+VPCLMULQDQ native 64-bit x64 build (only runs on Ice Lake, Zen 3, or later)
+cl -FAsc -Zi -O2 -I../dvec_demo -I.. -arch:AVX2 -DTEST_VPCLMULQDQ -Tc test-intrins.c -link -out:test-intrins-x64-vpclmul.exe -debug -release -incremental:no
+
+@rem SSE4+AVX2+SHA native 64-bit x64 build (only runs on Ice Lake, Zen, or later)
+cl -FAsc -Zi -O2 -I../dvec_demo -I.. -arch:AVX2 -DTEST_SHA -Tc test-intrins.c -link -out:test-intrins-x64-sha.exe -debug -release -incremental:no
+
+@rem SSE4+AVX2+CLFLUSHOPT+CLWB native 64-bit x64 build (only runs on Ice Lake, Zen 2, or later)
+cl -FAsc -Zi -O2 -I../dvec_demo -I.. -arch:AVX2 -DTEST_CLWB -Tc test-intrins.c -link -out:test-intrins-x64-clwb.exe -debug -release -incremental:no
+
 @rem Run both the correctness tests and micro-benchmarks.
 @rem Optionally define LOADER with a debugger command line (e.g. "cdb -o -g -G") or TTD command line (e.g. "sudo ttd")
 
@@ -18,9 +33,19 @@ cl -FAsc -Zi -O2 -I../dvec_demo -I.. -arch:AVX2   -Tc test-intrins.c -link -out:
 
 if exist test-intrins-x64-sse4.exe (%LOADER% test-intrins-x64-sse4.exe    -o test-x64-sse4.txt)
 if exist test-intrins-x64-avx2.exe (%LOADER% test-intrins-x64-avx2.exe    -o test-x64-avx2.txt)
+if exist test-intrins-x64-vnni.exe (%LOADER% test-intrins-x64-vnni.exe    -o test-x64-vnni.txt)
+if exist test-intrins-x64-vaes.exe (%LOADER% test-intrins-x64-vaes.exe    -o test-x64-vaes.txt)
+if exist test-intrins-x64-vpclmul.exe (%LOADER% test-intrins-x64-vpclmul.exe    -o test-x64-vpclmul.txt)
+if exist test-intrins-x64-sha.exe (%LOADER% test-intrins-x64-sha.exe    -o test-x64-sha.txt)
+if exist test-intrins-x64-clwb.exe (%LOADER% test-intrins-x64-clwb.exe    -o test-x64-clwb.txt)
 
 if exist test-intrins-x64-sse4.exe (%LOADER% test-intrins-x64-sse4.exe -b -o bench-x64-sse4.txt)
 if exist test-intrins-x64-avx2.exe (%LOADER% test-intrins-x64-avx2.exe -b -o bench-x64-avx2.txt)
+if exist test-intrins-x64-vnni.exe (%LOADER% test-intrins-x64-vnni.exe -b -o bench-x64-vnni.txt)
+if exist test-intrins-x64-vaes.exe (%LOADER% test-intrins-x64-vaes.exe -b -o bench-x64-vaes.txt)
+if exist test-intrins-x64-vpclmul.exe (%LOADER% test-intrins-x64-vpclmul.exe -b -o bench-x64-vpclmul.txt)
+if exist test-intrins-x64-sha.exe (%LOADER% test-intrins-x64-sha.exe -b -o bench-x64-sha.txt)
+if exist test-intrins-x64-clwb.exe (%LOADER% test-intrins-x64-clwb.exe -b -o bench-x64-clwb.txt)
 
 @rem Next steps:
 @rem
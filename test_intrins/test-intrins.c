@@ -27,6 +27,32 @@
 
 #include "debug_vec.h"
 
+//
+// Extensions past AVX2 that not every x64 test machine has are tested when the
+// compiler targets them or the soft intrinsics provide them.  x64 builds opt in
+// with -DTEST_AVX_VNNI, -DTEST_VAES, -DTEST_VPCLMULQDQ, -DTEST_SHA or -DTEST_CLWB.
+//
+
+#if !defined(TEST_AVX_VNNI) && (defined(__AVXVNNI__) || defined(SOFT_INTRINSICS_AVX_VNNI))
+#define TEST_AVX_VNNI
+#endif
+
+#if !defined(TEST_VAES) && (defined(__VAES__) || defined(SOFT_INTRINSICS_VAES))
+#define TEST_VAES
+#endif
+
+#if !defined(TEST_VPCLMULQDQ) && (defined(__VPCLMULQDQ__) || defined(SOFT_INTRINSICS_VPCLMULQDQ))
+#define TEST_VPCLMULQDQ
+#endif
+
+#if !defined(TEST_SHA) && (defined(__SHA__) || defined(SOFT_INTRINSICS_SHA))
+#define TEST_SHA
+#endif
+
+#if !defined(TEST_CLWB) && defined(SOFT_INTRINSICS_CACHE_CONTROL)
+#define TEST_CLWB
+#endif
+
 //
 // union of all possible scalar and vector types
 // totalling 256 bits = 32 bytes in size
@@ -297,6 +323,11 @@ __forceinline void __cdecl test ## op ## imm8 (unsigned index) { Vout[index]._ #
 #define DEFINE_TEST_OP_VAB(op, type_a, type_b) \
 __forceinline void __cdecl test ## op         (unsigned index) {                             op ( Vsrc[index + 0]._ ## type_a, Vsrc[index + 1]._ ## type_b ); }
 
+// kernel test functions are hand written in test-kernels.h
+
+#define DEFINE_TEST_KERNEL(op)
+
+#include "test-kernels.h"
 #include "intrin-list.h"
 
 //
@@ -310,6 +341,7 @@ __forceinline void __cdecl test ## op         (unsigned index) {
 #undef  DEFINE_TEST_OP_RAI
 #undef  DEFINE_TEST_OP_RABI
 #undef  DEFINE_TEST_OP_VAB
+#undef  DEFINE_TEST_KERNEL
 
 #define EXECUTE_TEST_OP(op)         do { if (init_vecs(# op)) { do { for (unsigned i = 0; i < (NUM_BIGVECS - 2); i++) { test ## op (i);         } } while (Run()); dump_vecs(# op); } } while(0);
 #define EXECUTE_TEST_OP_I(op, imm8) do { if (init_vecs(# op)) { do { for (unsigned i = 0; i < (NUM_BIGVECS - 2); i++) { test ## op ## imm8 (i); } } while (Run()); dump_vecs(# op); } } while(0);
@@ -321,6 +353,7 @@ __forceinline void __cdecl test ## op         (unsigned index) {
 #define DEFINE_TEST_OP_RAI( op, type_ret, type_a,         imm8)    EXECUTE_TEST_OP_I(op, imm8)
 #define DEFINE_TEST_OP_RABI(op, type_ret, type_a, type_b, imm8)    EXECUTE_TEST_OP_I(op, imm8)
 #define DEFINE_TEST_OP_VAB( op,           type_a, type_b)          EXECUTE_TEST_OP  (op)
+#define DEFINE_TEST_KERNEL( op)                                    EXECUTE_TEST_OP  (op)
 
 void RunTests(void)
 {
@@ -447,6 +480,8 @@ Usage:
 
     timeBeginPeriod(1);
 
+    init_kernels();
+
     RunTests();
 
     timeEndPeriod(1);
@@ -0,0 +1,1652 @@
+//
+// TEST-KERNELS.H
+//
+// Hand written test kernels which exercise intrinsics with realistic inputs
+// (lookup tables, index patterns, buffers) instead of the raw Vsrc vectors.
+//
+// Each kernel is a test_* function with the same signature as the functions
+// generated by the DEFINE_TEST_OP_* macros, and is listed in intrin-list.h
+// with DEFINE_TEST_KERNEL so that it supports the same -f and -b options.
+//
+// This file must be #include-ed by test-intrins.c after Vsrc and Vout are declared!
+//
+
+#if defined(__AVX2__) || (defined(USE_SOFT_INTRINSICS) && (USE_SOFT_INTRINSICS >= 2))
+
+//
+// Gathers from a 4096 entry lookup table using sequential, strided (one element
+// per 64-byte cache line), and pseudo-random index patterns
+//
+
+#define GATHER_TABLE_SIZE (4096)
+
+typedef enum GATHER_PATTERN
+{
+    GATHER_SEQUENTIAL = 0,
+    GATHER_STRIDED    = 1,
+    GATHER_RANDOM     = 2,
+    GATHER_PATTERNS   = 3,
+} GATHER_PATTERN;
+
+__declspec(align(64)) float   GatherTablePs[GATHER_TABLE_SIZE];
+__declspec(align(64)) double  GatherTablePd[GATHER_TABLE_SIZE];
+
+__declspec(align(32)) __m256i GatherIndex32[GATHER_PATTERNS][NUM_BIGVECS];   // 8 x int32 indices
+__declspec(align(32)) __m256i GatherIndex64[GATHER_PATTERNS][NUM_BIGVECS];   // 4 x int64 indices
+
+__declspec(noinline)
+void init_gather_kernels(void)
+{
+    uint32_t Seed = 0x2545F491;
+
+    for (unsigned i = 0; i < GATHER_TABLE_SIZE; i++)
+    {
+        GatherTablePs[i] = (float)i * 0.5f;
+        GatherTablePd[i] = (double)i * -0.25;
+    }
+
+    for (unsigned i = 0; i < NUM_BIGVECS; i++)
+    {
+        for (unsigned k = 0; k < 8; k++)
+        {
+            unsigned Element = i * 8 + k;
+
+            Seed = Seed * 1664525 + 1013904223;
+
+            GatherIndex32[GATHER_SEQUENTIAL][i].m256i_i32[k] = Element;
+            GatherIndex32[GATHER_STRIDED][i].m256i_i32[k]    = Element * 16;
+            GatherIndex32[GATHER_RANDOM][i].m256i_i32[k]     = (Seed >> 8) % GATHER_TABLE_SIZE;
+        }
+
+        for (unsigned k = 0; k < 4; k++)
+        {
+            for (unsigned p = 0; p < GATHER_PATTERNS; p++)
+                GatherIndex64[p][i].m256i_i64[k] = GatherIndex32[p][i].m256i_i32[k * 2 + 1];
+        }
+    }
+}
+
+#define DEFINE_GATHER_KERNELS(pattern, suffix) \
+__forceinline void __cdecl test_kernel_i32gather_epi32_ ## suffix (unsigned index) { \
+    Vout[index].___m128i = _mm_i32gather_epi32((int const *)GatherTablePs, _mm256_castsi256_si128(GatherIndex32[pattern][index]), 4); } \
+__forceinline void __cdecl test_kernel_i32gather_ps_ ## suffix (unsigned index) { \
+    Vout[index].___m256  = _mm256_i32gather_ps(GatherTablePs, GatherIndex32[pattern][index], 4); } \
+__forceinline void __cdecl test_kernel_i64gather_pd_ ## suffix (unsigned index) { \
+    Vout[index].___m256d = _mm256_i64gather_pd(GatherTablePd, GatherIndex64[pattern][index], 8); } \
+__forceinline void __cdecl test_kernel_mask_i64gather_pd_ ## suffix (unsigned index) { \
+    Vout[index].___m256d = _mm256_mask_i64gather_pd(Vsrc[index].___m256d, GatherTablePd, GatherIndex64[pattern][index], Vsrc[index + 1].___m256d, 8); }
+
+DEFINE_GATHER_KERNELS(GATHER_SEQUENTIAL, seq)
+DEFINE_GATHER_KERNELS(GATHER_STRIDED,    stride)
+DEFINE_GATHER_KERNELS(GATHER_RANDOM,     random)
+
+//
+// Movemask kernels, comparing against the scalar byte loop previously used
+// by the soft intrinsics, both standalone and fused with a 32-byte compare
+// as commonly used by parsers and hash table probes
+//
+
+__forceinline
+int movemask_epi8_loop(const __m128i a)
+{
+    int mask = 0;
+
+    for (unsigned i = 0; i < 16; i++)
+        mask |= (a.m128i_u8[i] >> 7) << i;
+
+    return mask;
+}
+
+__forceinline void __cdecl test_kernel_movemask_epi8_loop(unsigned index) {
+    Vout[index]._int = movemask_epi8_loop(Vsrc[index].___m128i); }
+
+__forceinline void __cdecl test_kernel_cmpeq_movemask_epi8(unsigned index) {
+    Vout[index]._int = _mm256_movemask_epi8(_mm256_cmpeq_epi8(Vsrc[index].___m256i, Vsrc[index + 1].___m256i)); }
+
+__forceinline void __cdecl test_kernel_cmpeq_movemask_epi8_loop(unsigned index) {
+    Vout[index]._int = movemask_epi8_loop(_mm_cmpeq_epi8(Vsrc[index].__am128i[0], Vsrc[index + 1].__am128i[0])) |
+                      (movemask_epi8_loop(_mm_cmpeq_epi8(Vsrc[index].__am128i[1], Vsrc[index + 1].__am128i[1])) << 16); }
+
+//
+// PTEST kernels, in a chain where each test result selects the next value
+// tested so that the measured time is the test-to-branch latency.  Each call
+// runs TEST_CHAIN_LENGTH dependent tests.  The _set variants pick operands
+// which guarantee ZF or CF is set, as random data almost never sets either.
+//
+
+#define TEST_CHAIN_LENGTH 8
+
+__forceinline void __cdecl test_kernel_testz_si128_chain(unsigned index) {
+    __m128i a = Vsrc[index].___m128i;
+    __m128i b = Vsrc[index + 1].___m128i;
+    for (unsigned i = 0; i < TEST_CHAIN_LENGTH; i++) {
+        if (_mm_testz_si128(a, b)) a = _mm_add_epi32(a, b); else a = _mm_xor_si128(a, b);
+    }
+    Vout[index].___m128i = a; }
+
+__forceinline void __cdecl test_kernel_testz_si256_chain(unsigned index) {
+    __m256i a = Vsrc[index].___m256i;
+    __m256i b = Vsrc[index + 1].___m256i;
+    for (unsigned i = 0; i < TEST_CHAIN_LENGTH; i++) {
+        if (_mm256_testz_si256(a, b)) a = _mm256_add_epi32(a, b); else a = _mm256_xor_si256(a, b);
+    }
+    Vout[index].___m256i = a; }
+
+__forceinline void __cdecl test_kernel_testc_ps_chain(unsigned index) {
+    __m256 a = Vsrc[index].___m256;
+    __m256 b = Vsrc[index + 1].___m256;
+    for (unsigned i = 0; i < TEST_CHAIN_LENGTH; i++) {
+        if (_mm256_testc_ps(a, b)) a = _mm256_add_ps(a, b); else a = _mm256_xor_ps(a, b);
+    }
+    Vout[index].___m256 = a; }
+
+__forceinline void __cdecl test_kernel_testz_si128_set(unsigned index) {
+    Vout[index]._int = _mm_testz_si128(Vsrc[index].___m128i, _mm_andnot_si128(Vsrc[index].___m128i, Vsrc[index + 1].___m128i)); }
+
+__forceinline void __cdecl test_kernel_testc_si256_set(unsigned index) {
+    Vout[index]._int = _mm256_testc_si256(_mm256_or_si256(Vsrc[index].___m256i, Vsrc[index + 1].___m256i), Vsrc[index + 1].___m256i); }
+
+__forceinline void __cdecl test_kernel_testz_pd_set(unsigned index) {
+    Vout[index]._int = _mm256_testz_pd(Vsrc[index].___m256d, _mm256_andnot_pd(Vsrc[index].___m256d, Vsrc[index + 1].___m256d)); }
+
+__forceinline void __cdecl test_kernel_test_all_ones(unsigned index) {
+    Vout[index]._int = _mm_test_all_ones(_mm_cmpeq_epi32(Vsrc[index].___m128i, Vsrc[index].___m128i)); }
+
+//
+// 256-bit packs and unpacks work within each 128-bit lane, so producing a
+// linear result needs a cross-lane fixup, which these kernels include
+//
+
+__forceinline void __cdecl test_kernel_packus_epi16_linear(unsigned index) {
+    Vout[index].___m256i = _mm256_permute4x64_epi64(_mm256_packus_epi16(Vsrc[index].___m256i, Vsrc[index + 1].___m256i), 0xD8); }
+
+__forceinline void __cdecl test_kernel_unpack_epi8_linear(unsigned index) {
+    __m256i a  = _mm256_permute4x64_epi64(Vsrc[index].___m256i, 0xD8);
+    __m256i lo = _mm256_unpacklo_epi8(a, Vsrc[index + 1].___m256i);
+    __m256i hi = _mm256_unpackhi_epi8(a, Vsrc[index + 1].___m256i);
+    Vout[index].___m256i = _mm256_xor_si256(lo, hi); }
+
+//
+// PALIGNR kernels, comparing against a byte loop equivalent to the SDK library
+// implementation, and a 3-tap box filter over a sliding window of bytes
+//
+
+__forceinline
+__m128i alignr_epi8_loop(__m128i a, __m128i b, unsigned imm8)
+{
+    __m128i T;
+
+    for (unsigned i = 0; i < 16; i++)
+    {
+        unsigned j = i + imm8;
+
+        T.m128i_u8[i] = (j < 16) ? b.m128i_u8[j] : (j < 32) ? a.m128i_u8[j - 16] : 0;
+    }
+
+    return T;
+}
+
+__forceinline void __cdecl test_kernel_alignr_epi8_loop(unsigned index) {
+    Vout[index].___m128i = alignr_epi8_loop(Vsrc[index].___m128i, Vsrc[index + 1].___m128i, 5); }
+
+__forceinline void __cdecl test_kernel_alignr_epi8_window(unsigned index) {
+    __m256i prev = Vsrc[index].___m256i;
+    __m256i next = Vsrc[index + 1].___m256i;
+    __m256i avg  = _mm256_avg_epu8(prev, _mm256_alignr_epi8(next, prev, 2));
+    Vout[index].___m256i = _mm256_avg_epu8(avg, _mm256_alignr_epi8(next, prev, 1)); }
+
+//
+// Split 128-bit loads and stores, and the horizontal sum epilogues found at the
+// end of most vectorized reductions, which extract the upper 128 bits and fold
+//
+
+__forceinline void __cdecl test_kernel_loadu2_m128(unsigned index) {
+    Vout[index].___m256 = _mm256_loadu2_m128(&Vsrc[index + 1]._float + 1, &Vsrc[index]._float + 3); }
+
+__forceinline void __cdecl test_kernel_loadu2_m128i(unsigned index) {
+    Vout[index].___m256i = _mm256_loadu2_m128i(&Vsrc[index].__am128i[0], &Vsrc[index + 1].__am128i[1]); }
+
+__forceinline void __cdecl test_kernel_storeu2_m128d(unsigned index) {
+    _mm256_storeu2_m128d(&Vout[index]._double + 0, &Vout[index]._double + 2, Vsrc[index].___m256d); }
+
+__forceinline void __cdecl test_kernel_hsum_ps(unsigned index) {
+    __m256 v = Vsrc[index].___m256;
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_shuffle_ps(s, s, 0x4E));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0xB1));
+    Vout[index]._float = _mm_cvtss_f32(s); }
+
+__forceinline void __cdecl test_kernel_hsum_epi32(unsigned index) {
+    __m256i v = Vsrc[index].___m256i;
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+    Vout[index]._int = _mm_extract_epi32(s, 0) + _mm_extract_epi32(s, 1); }
+
+//
+// PMADDWD and PMADDUBSW at the edges, where the 16-bit sums of PMADDUBSW saturate
+// and the 32-bit sum of PMADDWD wraps.  The two 128-bit lanes of the 256-bit
+// forms get different edge values.  The dot product kernels measure throughput
+// with four independent accumulators, as in int8 and int16 inference loops.
+//
+
+const unsigned __int8  MaddubsEdgeA[4] = { 0xFF, 0x80, 0x01, 0x00 };
+const unsigned __int8  MaddubsEdgeB[4] = { 0x7F, 0x80, 0xFF, 0x01 };
+const unsigned __int16 MaddEdge[4]     = { 0x8000, 0x7FFF, 0xFFFF, 0x0001 };
+
+__forceinline void __cdecl test_kernel_madd_epi16_edges(unsigned index) {
+    __m128i a = _mm_set1_epi16((short)MaddEdge[index & 3]);
+    __m128i b = _mm_set1_epi16((short)MaddEdge[(index >> 2) & 3]);
+    __m128i c = _mm_unpacklo_epi16(a, b);
+    Vout[index].___m256i = _mm256_madd_epi16(_mm256_set_m128i(c, a), _mm256_set_m128i(a, b)); }
+
+__forceinline void __cdecl test_kernel_maddubs_epi16_edges(unsigned index) {
+    __m128i a = _mm_set1_epi8((char)MaddubsEdgeA[index & 3]);
+    __m128i b = _mm_set1_epi8((char)MaddubsEdgeB[(index >> 2) & 3]);
+    __m128i c = _mm_unpacklo_epi8(b, _mm_set1_epi8((char)MaddubsEdgeB[index & 3]));
+    Vout[index].___m256i = _mm256_maddubs_epi16(_mm256_set_m128i(a, a), _mm256_set_m128i(c, b)); }
+
+__forceinline void __cdecl test_kernel_madd_epi16_dot(unsigned index) {
+    __m256i acc0 = _mm256_madd_epi16(Vsrc[index + 0].___m256i, Vsrc[index + 1].___m256i);
+    __m256i acc1 = _mm256_madd_epi16(Vsrc[index + 1].___m256i, Vsrc[index + 2].___m256i);
+    __m256i acc2 = _mm256_madd_epi16(Vsrc[index + 2].___m256i, Vsrc[index + 0].___m256i);
+    __m256i acc3 = _mm256_madd_epi16(Vsrc[index + 0].___m256i, Vsrc[index + 0].___m256i);
+    Vout[index].___m256i = _mm256_add_epi32(_mm256_add_epi32(acc0, acc1), _mm256_add_epi32(acc2, acc3)); }
+
+__forceinline void __cdecl test_kernel_maddubs_epi16_dot(unsigned index) {
+    __m256i ones = _mm256_broadcastw_epi16(_mm_set1_epi16(1));
+    __m256i acc0 = _mm256_madd_epi16(_mm256_maddubs_epi16(Vsrc[index + 0].___m256i, Vsrc[index + 1].___m256i), ones);
+    __m256i acc1 = _mm256_madd_epi16(_mm256_maddubs_epi16(Vsrc[index + 1].___m256i, Vsrc[index + 2].___m256i), ones);
+    __m256i acc2 = _mm256_madd_epi16(_mm256_maddubs_epi16(Vsrc[index + 2].___m256i, Vsrc[index + 0].___m256i), ones);
+    __m256i acc3 = _mm256_madd_epi16(_mm256_maddubs_epi16(Vsrc[index + 0].___m256i, Vsrc[index + 2].___m256i), ones);
+    Vout[index].___m256i = _mm256_add_epi32(_mm256_add_epi32(acc0, acc1), _mm256_add_epi32(acc2, acc3)); }
+
+#if defined(TEST_AVX_VNNI)
+
+//
+// AVX-VNNI with accumulators next to INT_MAX and INT_MIN so that the saturating
+// forms clamp, and the int8 dot product where one VPDPBUSD replaces the
+// PMADDUBSW + PMADDWD + PADDD sequence of the maddubs_epi16_dot kernel
+//
+
+const int VnniEdgeAcc[4] = { 0x7FFFFFF0, (int)0x80000010, 0x7FFFFFFF, 0 };
+
+__forceinline void __cdecl test_kernel_dpbusds_epi32_edges(unsigned index) {
+    __m256i acc = _mm256_broadcastd_epi32(_mm_set1_epi32(VnniEdgeAcc[index & 3]));
+    __m256i a   = _mm256_broadcastb_epi8(_mm_set1_epi8((char)MaddubsEdgeA[(index >> 1) & 1]));
+    __m256i b   = _mm256_broadcastb_epi8(_mm_set1_epi8((char)MaddubsEdgeB[(index & 1) ? 0 : 1]));
+    Vout[index].___m256i = _mm256_dpbusds_avx_epi32(acc, a, b); }
+
+__forceinline void __cdecl test_kernel_dpwssds_epi32_edges(unsigned index) {
+    __m256i acc = _mm256_broadcastd_epi32(_mm_set1_epi32(VnniEdgeAcc[index & 3]));
+    __m256i a   = _mm256_broadcastw_epi16(_mm_set1_epi16((short)MaddEdge[(index >> 2) & 3]));
+    __m256i b   = _mm256_broadcastw_epi16(_mm_set1_epi16((short)MaddEdge[(index >> 1) & 1]));
+    Vout[index].___m256i = _mm256_dpwssds_avx_epi32(acc, a, b); }
+
+__forceinline void __cdecl test_kernel_dpbusd_epi32_dot(unsigned index) {
+    __m256i acc0 = _mm256_dpbusd_avx_epi32(Vsrc[index + 0].___m256i, Vsrc[index + 0].___m256i, Vsrc[index + 1].___m256i);
+    __m256i acc1 = _mm256_dpbusd_avx_epi32(Vsrc[index + 1].___m256i, Vsrc[index + 1].___m256i, Vsrc[index + 2].___m256i);
+    __m256i acc2 = _mm256_dpbusd_avx_epi32(Vsrc[index + 2].___m256i, Vsrc[index + 2].___m256i, Vsrc[index + 0].___m256i);
+    __m256i acc3 = _mm256_dpbusd_avx_epi32(Vsrc[index + 0].___m256i, Vsrc[index + 0].___m256i, Vsrc[index + 2].___m256i);
+    Vout[index].___m256i = _mm256_add_epi32(_mm256_add_epi32(acc0, acc1), _mm256_add_epi32(acc2, acc3)); }
+
+#endif // AVX-VNNI kernels
+
+//
+// Motion estimation inner loops: the SAD of a 32x4 pixel block against a
+// reference block, and an MPSADBW search for the minimum SAD over 8 offsets
+// of each 4-byte block within two rows
+//
+
+__forceinline void __cdecl test_kernel_sad_epu8_block(unsigned index) {
+    __m256i s0 = _mm256_sad_epu8(Vsrc[index + 0].___m256i, Vsrc[index + 1].___m256i);
+    __m256i s1 = _mm256_sad_epu8(Vsrc[index + 1].___m256i, Vsrc[index + 2].___m256i);
+    __m256i s2 = _mm256_sad_epu8(Vsrc[index + 2].___m256i, Vsrc[index + 0].___m256i);
+    __m256i s3 = _mm256_sad_epu8(Vsrc[index + 0].___m256i, Vsrc[index + 2].___m256i);
+    Vout[index].___m256i = _mm256_add_epi64(_mm256_add_epi64(s0, s1), _mm256_add_epi64(s2, s3)); }
+
+__forceinline void __cdecl test_kernel_mpsadbw_epu8_search(unsigned index) {
+    __m256i a = Vsrc[index].___m256i;
+    __m256i b = Vsrc[index + 1].___m256i;
+    __m256i m = _mm256_min_epu16(_mm256_mpsadbw_epu8(a, b, 0x00), _mm256_mpsadbw_epu8(a, b, 0x09));
+    m = _mm256_min_epu16(m, _mm256_mpsadbw_epu8(a, b, 0x12));
+    m = _mm256_min_epu16(m, _mm256_mpsadbw_epu8(a, b, 0x1B));
+    Vout[index].___m256i = m; }
+
+//
+// ROUNDPS and ROUNDPD on ties, signed zeros, quiet and signalling NaNs of both
+// signs, infinities, denormals, and values next to 2^23 (2^52) where the last
+// fractional bit is lost.  Each index picks a different window of the edge values
+// and one of the four explicit rounding modes or the current (MXCSR) mode.
+//
+
+const unsigned __int32 RoundEdgeF32[16] = {
+    0x3F000000, 0x3FC00000, 0x40200000, 0xBF000000,     //  0.5,  1.5,  2.5, -0.5
+    0xBFC00000, 0x80000000, 0x00000000, 0x7FC00000,     // -1.5, -0.0, +0.0, QNaN
+    0xFFC00000, 0x7F800001, 0x7F800000, 0xFF800000,     // -QNaN, SNaN, +Inf, -Inf
+    0x4B000001, 0x4AFFFFFF, 0x00000001, 0x80000001,     // 2^23+1, 2^23-0.5, +denormal, -denormal
+};
+
+const unsigned __int64 RoundEdgeF64[16] = {
+    0x3FE0000000000000ull, 0x3FF8000000000000ull, 0x4004000000000000ull, 0xBFE0000000000000ull,
+    0xBFF8000000000000ull, 0x8000000000000000ull, 0x0000000000000000ull, 0x7FF8000000000000ull,
+    0xFFF8000000000000ull, 0x7FF0000000000001ull, 0x7FF0000000000000ull, 0xFFF0000000000000ull,
+    0x4330000000000001ull, 0x432FFFFFFFFFFFFFull, 0x0000000000000001ull, 0x8000000000000001ull,
+};
+
+#define ROUND_EDGE_MODES(index, dst, round_op, ...) \
+    switch ((index) % 5) { \
+    case 0:  dst = round_op(__VA_ARGS__, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); break; \
+    case 1:  dst = round_op(__VA_ARGS__, _MM_FROUND_TO_NEG_INF     | _MM_FROUND_NO_EXC); break; \
+    case 2:  dst = round_op(__VA_ARGS__, _MM_FROUND_TO_POS_INF     | _MM_FROUND_NO_EXC); break; \
+    case 3:  dst = round_op(__VA_ARGS__, _MM_FROUND_TO_ZERO        | _MM_FROUND_NO_EXC); break; \
+    default: dst = round_op(__VA_ARGS__, _MM_FROUND_CUR_DIRECTION); break; }
+
+__forceinline void __cdecl test_kernel_round_pd_edges(unsigned index) {
+    __m256d a = _mm256_loadu_pd((const double *)&RoundEdgeF64[index % 13]);
+    ROUND_EDGE_MODES(index, Vout[index].___m256d, _mm256_round_pd, a) }
+
+__forceinline void __cdecl test_kernel_round_ps_edges(unsigned index) {
+    __m256 a = _mm256_loadu_ps((const float *)&RoundEdgeF32[index & 7]);
+    ROUND_EDGE_MODES(index, Vout[index].___m256, _mm256_round_ps, a) }
+
+__forceinline void __cdecl test_kernel_round_sd_edges(unsigned index) {
+    __m128d a = _mm_loadu_pd((const double *)&RoundEdgeF64[(index + 3) % 15]);
+    __m128d b = _mm_loadu_pd((const double *)&RoundEdgeF64[index % 15]);
+    ROUND_EDGE_MODES(index, Vout[index].___m128d, _mm_round_sd, a, b) }
+
+__forceinline void __cdecl test_kernel_round_ss_edges(unsigned index) {
+    __m128 a = _mm_loadu_ps((const float *)&RoundEdgeF32[(index + 5) % 13]);
+    __m128 b = _mm_loadu_ps((const float *)&RoundEdgeF32[index % 13]);
+    ROUND_EDGE_MODES(index, Vout[index].___m128, _mm_round_ss, a, b) }
+
+
+//
+// Floating point compares of every pair of +0, -0, +Inf, -Inf, QNaN, SNaN, +1 and -1,
+// for each of the 32 VCMPPS/VCMPPD predicates and each of the legacy compares.  Each
+// index fixes the second operand window and the kernel loops over all first operand
+// windows, storing one movemask per window for the ps, pd, ss, and sd forms.  The
+// VCMPPS/VCMPPD kernels store the 256-bit ps and pd masks, and the 128-bit ps and
+// pd masks in the bits above the ss and sd masks.
+//
+
+const unsigned __int32 CmpMatrixF32[16] = {
+    0x00000000, 0x80000000, 0x7F800000, 0xFF800000, 0x7FC00000, 0x7FA00000, 0x3F800000, 0xBF800000,
+    0x00000000, 0x80000000, 0x7F800000, 0xFF800000, 0x7FC00000, 0x7FA00000, 0x3F800000, 0xBF800000,
+};
+
+const unsigned __int64 CmpMatrixF64[16] = {
+    0x0000000000000000ull, 0x8000000000000000ull, 0x7FF0000000000000ull, 0xFFF0000000000000ull,
+    0x7FF8000000000000ull, 0x7FF4000000000000ull, 0x3FF0000000000000ull, 0xBFF0000000000000ull,
+    0x0000000000000000ull, 0x8000000000000000ull, 0x7FF0000000000000ull, 0xFFF0000000000000ull,
+    0x7FF8000000000000ull, 0x7FF4000000000000ull, 0x3FF0000000000000ull, 0xBFF0000000000000ull,
+};
+
+#define DEFINE_CMP_MATRIX_KERNEL(pred) \
+__forceinline void __cdecl test_kernel_cmp_ ## pred ## _matrix(unsigned index) { \
+    __m256  bs = _mm256_loadu_ps((const float *)&CmpMatrixF32[index & 7]); \
+    __m256d bd = _mm256_loadu_pd((const double *)&CmpMatrixF64[index & 7]); \
+    for (unsigned k = 0; k < 8; k++) { \
+        __m256  as = _mm256_loadu_ps((const float *)&CmpMatrixF32[k]); \
+        __m256d ad = _mm256_loadu_pd((const double *)&CmpMatrixF64[k]); \
+        Vout[index].bytes[k +  0] = (uint8_t)_mm256_movemask_ps(_mm256_cmp_ps(as, bs, _CMP_ ## pred)); \
+        Vout[index].bytes[k +  8] = (uint8_t)_mm256_movemask_pd(_mm256_cmp_pd(ad, bd, _CMP_ ## pred)); \
+        Vout[index].bytes[k + 16] = (uint8_t)(_mm_movemask_ps(_mm_cmp_ss(_mm256_castps256_ps128(as), _mm256_castps256_ps128(bs), _CMP_ ## pred)) | \
+                                              (_mm_movemask_ps(_mm_cmp_ps(_mm256_castps256_ps128(as), _mm256_castps256_ps128(bs), _CMP_ ## pred)) << 4)); \
+        Vout[index].bytes[k + 24] = (uint8_t)(_mm_movemask_pd(_mm_cmp_sd(_mm256_castpd256_pd128(ad), _mm256_castpd256_pd128(bd), _CMP_ ## pred)) | \
+                                              (_mm_movemask_pd(_mm_cmp_pd(_mm256_castpd256_pd128(ad), _mm256_castpd256_pd128(bd), _CMP_ ## pred)) << 2)); } }
+
+#define DEFINE_CMP_LEGACY_MATRIX_KERNEL(name) \
+__forceinline void __cdecl test_kernel_ ## name ## _matrix(unsigned index) { \
+    __m128  bs = _mm_loadu_ps((const float *)&CmpMatrixF32[index & 7]); \
+    __m128d bd = _mm_loadu_pd((const double *)&CmpMatrixF64[index & 7]); \
+    for (unsigned k = 0; k < 8; k++) { \
+        __m128  as = _mm_loadu_ps((const float *)&CmpMatrixF32[k]); \
+        __m128d ad = _mm_loadu_pd((const double *)&CmpMatrixF64[k]); \
+        Vout[index].bytes[k +  0] = (uint8_t)_mm_movemask_ps(_mm_ ## name ## _ps(as, bs)); \
+        Vout[index].bytes[k +  8] = (uint8_t)_mm_movemask_pd(_mm_ ## name ## _pd(ad, bd)); \
+        Vout[index].bytes[k + 16] = (uint8_t)_mm_movemask_ps(_mm_ ## name ## _ss(as, bs)); \
+        Vout[index].bytes[k + 24] = (uint8_t)_mm_movemask_pd(_mm_ ## name ## _sd(ad, bd)); } }
+
+DEFINE_CMP_MATRIX_KERNEL(EQ_OQ)
+DEFINE_CMP_MATRIX_KERNEL(LT_OS)
+DEFINE_CMP_MATRIX_KERNEL(LE_OS)
+DEFINE_CMP_MATRIX_KERNEL(UNORD_Q)
+DEFINE_CMP_MATRIX_KERNEL(NEQ_UQ)
+DEFINE_CMP_MATRIX_KERNEL(NLT_US)
+DEFINE_CMP_MATRIX_KERNEL(NLE_US)
+DEFINE_CMP_MATRIX_KERNEL(ORD_Q)
+DEFINE_CMP_MATRIX_KERNEL(EQ_UQ)
+DEFINE_CMP_MATRIX_KERNEL(NGE_US)
+DEFINE_CMP_MATRIX_KERNEL(NGT_US)
+DEFINE_CMP_MATRIX_KERNEL(FALSE_OQ)
+DEFINE_CMP_MATRIX_KERNEL(NEQ_OQ)
+DEFINE_CMP_MATRIX_KERNEL(GE_OS)
+DEFINE_CMP_MATRIX_KERNEL(GT_OS)
+DEFINE_CMP_MATRIX_KERNEL(TRUE_UQ)
+DEFINE_CMP_MATRIX_KERNEL(EQ_OS)
+DEFINE_CMP_MATRIX_KERNEL(LT_OQ)
+DEFINE_CMP_MATRIX_KERNEL(LE_OQ)
+DEFINE_CMP_MATRIX_KERNEL(UNORD_S)
+DEFINE_CMP_MATRIX_KERNEL(NEQ_US)
+DEFINE_CMP_MATRIX_KERNEL(NLT_UQ)
+DEFINE_CMP_MATRIX_KERNEL(NLE_UQ)
+DEFINE_CMP_MATRIX_KERNEL(ORD_S)
+DEFINE_CMP_MATRIX_KERNEL(EQ_US)
+DEFINE_CMP_MATRIX_KERNEL(NGE_UQ)
+DEFINE_CMP_MATRIX_KERNEL(NGT_UQ)
+DEFINE_CMP_MATRIX_KERNEL(FALSE_OS)
+DEFINE_CMP_MATRIX_KERNEL(NEQ_OS)
+DEFINE_CMP_MATRIX_KERNEL(GE_OQ)
+DEFINE_CMP_MATRIX_KERNEL(GT_OQ)
+DEFINE_CMP_MATRIX_KERNEL(TRUE_US)
+
+DEFINE_CMP_LEGACY_MATRIX_KERNEL(cmpeq)
+DEFINE_CMP_LEGACY_MATRIX_KERNEL(cmplt)
+DEFINE_CMP_LEGACY_MATRIX_KERNEL(cmple)
+DEFINE_CMP_LEGACY_MATRIX_KERNEL(cmpgt)
+DEFINE_CMP_LEGACY_MATRIX_KERNEL(cmpge)
+DEFINE_CMP_LEGACY_MATRIX_KERNEL(cmpneq)
+DEFINE_CMP_LEGACY_MATRIX_KERNEL(cmpnlt)
+DEFINE_CMP_LEGACY_MATRIX_KERNEL(cmpnle)
+DEFINE_CMP_LEGACY_MATRIX_KERNEL(cmpngt)
+DEFINE_CMP_LEGACY_MATRIX_KERNEL(cmpnge)
+DEFINE_CMP_LEGACY_MATRIX_KERNEL(cmpord)
+DEFINE_CMP_LEGACY_MATRIX_KERNEL(cmpunord)
+
+
+//
+// BMI1 kernels.  The BEXTR kernels call the three argument _bextr_u32 and
+// _bextr_u64 with fields inside the source, fields that straddle or start past
+// the top bit, and zero starts and lengths.  Each also extracts the field from
+// an all ones source, which shows the width of the field.
+//
+
+const unsigned __int8 BextrFields[14][2] = {
+    // start  len
+    {  4,  8 }, {  0, 32 }, { 24, 16 }, { 31,  2 }, { 32,  4 }, { 40,  8 }, {  5,  0 },
+    {  0,  0 }, {  0, 40 }, { 16, 16 }, {  1, 31 }, { 28,  8 }, {  0,  1 }, {255,  1 },
+};
+
+__forceinline void __cdecl test_kernel_bextr_u32_fields(unsigned index) {
+    unsigned int a = Vsrc[index].___int32;
+    Vout[index].__am128i[0] = _mm_setr_epi32(
+        _bextr_u32(a, BextrFields[index][0], BextrFields[index][1]),
+        _bextr_u32(a, BextrFields[(index + 7) % 14][0], BextrFields[(index + 7) % 14][1]),
+        _bextr_u32(0xFFFFFFFF, BextrFields[index][0], BextrFields[index][1]), 0); }
+
+#if !defined(_M_IX86)
+
+const unsigned __int8 BextrFields64[14][2] = {
+    // start  len
+    {  4,  8 }, {  0, 64 }, { 56, 16 }, { 63,  2 }, { 64,  4 }, { 72,  8 }, {  5,  0 },
+    {  0,  0 }, {  0, 72 }, { 32, 32 }, {  1, 63 }, { 60,  8 }, { 31,  2 }, {255,  1 },
+};
+
+__forceinline void __cdecl test_kernel_bextr_u64_fields(unsigned index) {
+    unsigned __int64 a = Vsrc[index].___int64;
+    Vout[index].__am128i[0] = _mm_set_epi64x(
+        _bextr_u64(a, BextrFields64[(index + 7) % 14][0], BextrFields64[(index + 7) % 14][1]),
+        _bextr_u64(a, BextrFields64[index][0], BextrFields64[index][1]));
+    Vout[index].__am128i[1] = _mm_set_epi64x(0,
+        _bextr_u64(~0ull, BextrFields64[index][0], BextrFields64[index][1])); }
+
+#endif
+
+
+//
+// BMI2 kernels.  The sparse masks are chess bitboard attack masks with a handful of
+// bits in short runs, the dense masks have most bits set with isolated holes as in
+// the rank/select blocks of a succinct bit vector.  Each call applies all 8 masks of
+// one kind to the same source.  The bit scan visits every set bit with TZCNT + BLSR.
+//
+
+__forceinline void __cdecl test_kernel_mulx_u32(unsigned index) {
+    unsigned int hi;
+    unsigned int lo = _mulx_u32(Vsrc[index].___int32, Vsrc[index + 1].___int32, &hi);
+    Vout[index].__am128i[0] = _mm_setr_epi32(lo, hi, 0, 0); }
+
+#if !defined(_M_IX86)
+
+const unsigned __int64 BmiMasks[2][8] = {
+    {
+        0x000101010101017Eull, 0x0040201008040200ull, 0x7E01010101010100ull, 0x0002040810204000ull,
+        0x0010101010106E00ull, 0x0000000000000000ull, 0x8000000000000001ull, 0x0000001C00000000ull,
+    },
+    {
+        0xFFFFFFFFFFFFFFFFull, 0xFFFFFFFFFFFFFFFEull, 0xFFFFFFFF7FFFFFFFull, 0xF7FFFFFFFFFFFFEFull,
+        0xFFFDFFFFFBFFFFFFull, 0x7FFFFFFFFFFFFFFFull, 0xEFFFFFDFFFFFBFFFull, 0xAAAAAAAAAAAAAAAAull,
+    },
+};
+
+#define DEFINE_BMI_MASK_KERNEL(op, kind, row) \
+__forceinline void __cdecl test_kernel ## op ## _ ## kind (unsigned index) { \
+    unsigned __int64 a = Vsrc[index].___int64; \
+    unsigned __int64 T = 0; \
+    for (unsigned i = 0; i < 8; i++) \
+        T ^= op(a, BmiMasks[row][i]) + i; \
+    Vout[index].___int64 = T; }
+
+DEFINE_BMI_MASK_KERNEL(_pext_u64, sparse, 0)
+DEFINE_BMI_MASK_KERNEL(_pext_u64, dense,  1)
+DEFINE_BMI_MASK_KERNEL(_pdep_u64, sparse, 0)
+DEFINE_BMI_MASK_KERNEL(_pdep_u64, dense,  1)
+
+__forceinline void __cdecl test_kernel_mulx_u64(unsigned index) {
+    unsigned __int64 hi;
+    unsigned __int64 lo = _mulx_u64(Vsrc[index].___int64, Vsrc[index + 1].___int64, &hi);
+    Vout[index].__am128i[0] = _mm_set_epi64x(hi, lo); }
+
+__forceinline void __cdecl test_kernel_tzcnt_u64_bitscan(unsigned index) {
+    unsigned __int64 bits = Vsrc[index].___int64;
+    unsigned __int64 T = 0;
+    while (bits != 0) {
+        T += _tzcnt_u64(bits);
+        bits = _blsr_u64(bits); }
+    Vout[index].___int64 = T; }
+
+#endif
+
+
+//
+// Bitmap index intersection counts over two 16KB bitmaps, one dense and one sparse.
+// The nibble kernel is the usual AVX2 idiom of a VPSHUFB lookup of each nibble and
+// VPSADBW into 64-bit sums, the buffer kernel is the _nn_popcount_and_buffer helper
+// on ARM64 and a POPCNT loop on x64, and the loop kernel is a POPCNT loop on both.
+// Each index counts a different length, not always a multiple of 32 bytes.
+//
+
+#if !defined(_M_IX86)
+
+#define POPCNT_BITMAP_VECS (512)
+
+__declspec(align(32)) __m256i PopcntBitmapA[POPCNT_BITMAP_VECS];
+__declspec(align(32)) __m256i PopcntBitmapB[POPCNT_BITMAP_VECS];
+
+__declspec(noinline)
+void init_popcnt_kernels(void)
+{
+    uint32_t Seed = 0x6C078965;
+
+    for (unsigned i = 0; i < POPCNT_BITMAP_VECS * 8; i++)
+    {
+        uint32_t r0, r1, r2;
+
+        Seed = Seed * 1664525 + 1013904223; r0 = Seed;
+        Seed = Seed * 1664525 + 1013904223; r1 = Seed;
+        Seed = Seed * 1664525 + 1013904223; r2 = Seed;
+
+        ((uint32_t *)PopcntBitmapA)[i] = r0 | r1;       // ~75% of bits set
+        ((uint32_t *)PopcntBitmapB)[i] = r0 & r1 & r2;  // ~12% of bits set
+    }
+}
+
+__forceinline unsigned __int64 popcnt_loop_and(const unsigned __int8 *pa, const unsigned __int8 *pb, size_t cb) {
+    unsigned __int64 T = 0;
+    for (; cb >= 8; cb -= 8, pa += 8, pb += 8)
+        T += _mm_popcnt_u64(*(const unsigned __int64 *)pa & *(const unsigned __int64 *)pb);
+    for (; cb != 0; cb--)
+        T += _mm_popcnt_u32(*pa++ & *pb++);
+    return T; }
+
+__forceinline void __cdecl test_kernel_popcnt_u64_loop(unsigned index) {
+    Vout[index].___int64 = popcnt_loop_and((const unsigned __int8 *)PopcntBitmapA, (const unsigned __int8 *)PopcntBitmapB, (index + 1) * 1024 + index * 5); }
+
+__forceinline void __cdecl test_kernel_popcount_and_buffer(unsigned index) {
+#if defined(_M_ARM64) || defined(_M_ARM64EC)
+    Vout[index].___int64 = _nn_popcount_and_buffer(PopcntBitmapA, PopcntBitmapB, (index + 1) * 1024 + index * 5);
+#else
+    Vout[index].___int64 = popcnt_loop_and((const unsigned __int8 *)PopcntBitmapA, (const unsigned __int8 *)PopcntBitmapB, (index + 1) * 1024 + index * 5);
+#endif
+    }
+
+__forceinline void __cdecl test_kernel_popcount_nibble_epi8(unsigned index) {
+    const __m256i Lookup = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+    const __m256i Nibble = _mm256_broadcastb_epi8(_mm_set1_epi8(0x0F));
+    __m256i Sum = _mm256_setzero_si256();
+    for (unsigned i = 0; i < (index + 1) * 32; i++) {
+        __m256i v  = _mm256_and_si256(PopcntBitmapA[i], PopcntBitmapB[i]);
+        __m256i lo = _mm256_shuffle_epi8(Lookup, _mm256_and_si256(v, Nibble));
+        __m256i hi = _mm256_shuffle_epi8(Lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), Nibble));
+        Sum = _mm256_add_epi64(Sum, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256())); }
+    Vout[index].___int64 = _mm256_extract_epi64(Sum, 0) + _mm256_extract_epi64(Sum, 1) + _mm256_extract_epi64(Sum, 2) + _mm256_extract_epi64(Sum, 3); }
+
+//
+// CRC-32C throughput over the dense popcount bitmap, as a storage layer checksums
+// blocks: a single dependent _mm_crc32_u64 chain, and the interleaved bulk helper
+// on ARM64 (the single chain on x64).  The lengths are not multiples of 8 bytes.
+//
+
+__forceinline unsigned int crc32c_loop(unsigned int crc, const unsigned __int8 *p, size_t cb) {
+    for (; cb >= 8; cb -= 8, p += 8)
+        crc = (unsigned int)_mm_crc32_u64(crc, *(const unsigned __int64 *)p);
+    for (; cb != 0; cb--)
+        crc = _mm_crc32_u8(crc, *p++);
+    return crc; }
+
+__forceinline void __cdecl test_kernel_crc32_u64_loop(unsigned index) {
+    Vout[index]._int = ~crc32c_loop(~0u, (const unsigned __int8 *)PopcntBitmapA, (index + 1) * 1024 + index * 7); }
+
+__forceinline void __cdecl test_kernel_crc32c_buffer(unsigned index) {
+#if defined(_M_ARM64) || defined(_M_ARM64EC)
+    Vout[index]._int = ~_nn_crc32c_buffer(~0u, PopcntBitmapA, (index + 1) * 1024 + index * 7);
+#else
+    Vout[index]._int = ~crc32c_loop(~0u, (const unsigned __int8 *)PopcntBitmapA, (index + 1) * 1024 + index * 7);
+#endif
+    }
+
+#endif
+
+
+//
+// AES-128 with the FIPS-197 Appendix C.1 key 000102...0F.  For index 0 the block
+// is the FIPS-197 plaintext 00112233...FF and the ciphertext must be 69C4E0D8...
+// 70B4C55A, other indices XOR the index into each plaintext byte.  The output is
+// the ciphertext followed by the decrypted plaintext.  The key schedule is built
+// with AESKEYGENASSIST as in the Intel AES-NI white paper, and the decryption
+// schedule with AESIMC.  The CTR kernels encrypt 8 independent counter blocks per
+// call as CTR and GCM modes do, with AESENC and with VAESENC on two blocks at a
+// time, and must produce the same XOR of the 8 keystream blocks.
+//
+
+__declspec(align(16)) __m128i AesEncKeys[11];
+__declspec(align(16)) __m128i AesDecKeys[11];
+
+const unsigned __int8 AesFips197Key[16] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+};
+
+const unsigned __int8 AesFips197Plain[16] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF,
+};
+
+__forceinline __m128i aes128_expand_step(__m128i key, __m128i assist) {
+    assist = _mm_shuffle_epi32(assist, 0xFF);
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, assist); }
+
+#define AES128_EXPAND(k, i, rcon) k[i] = aes128_expand_step(k[i - 1], _mm_aeskeygenassist_si128(k[i - 1], rcon))
+
+__forceinline void aes128_expand_key(__m128i *k, __m128i key) {
+    k[0] = key;
+    AES128_EXPAND(k, 1, 0x01);
+    AES128_EXPAND(k, 2, 0x02);
+    AES128_EXPAND(k, 3, 0x04);
+    AES128_EXPAND(k, 4, 0x08);
+    AES128_EXPAND(k, 5, 0x10);
+    AES128_EXPAND(k, 6, 0x20);
+    AES128_EXPAND(k, 7, 0x40);
+    AES128_EXPAND(k, 8, 0x80);
+    AES128_EXPAND(k, 9, 0x1B);
+    AES128_EXPAND(k, 10, 0x36); }
+
+__declspec(noinline)
+void init_aes_kernels(void)
+{
+    aes128_expand_key(AesEncKeys, _mm_loadu_si128((const __m128i *)AesFips197Key));
+
+    AesDecKeys[0] = AesEncKeys[10];
+
+    for (unsigned i = 1; i < 10; i++)
+    {
+        AesDecKeys[i] = _mm_aesimc_si128(AesEncKeys[10 - i]);
+    }
+
+    AesDecKeys[10] = AesEncKeys[0];
+}
+
+__forceinline void __cdecl test_kernel_aes128_fips197(unsigned index) {
+    __m128i b = _mm_xor_si128(_mm_loadu_si128((const __m128i *)AesFips197Plain), _mm_set1_epi8((char)index));
+    b = _mm_xor_si128(b, AesEncKeys[0]);
+    for (unsigned r = 1; r < 10; r++)
+        b = _mm_aesenc_si128(b, AesEncKeys[r]);
+    b = _mm_aesenclast_si128(b, AesEncKeys[10]);
+    Vout[index].__am128i[0] = b;
+    b = _mm_xor_si128(b, AesDecKeys[0]);
+    for (unsigned r = 1; r < 10; r++)
+        b = _mm_aesdec_si128(b, AesDecKeys[r]);
+    Vout[index].__am128i[1] = _mm_aesdeclast_si128(b, AesDecKeys[10]); }
+
+__forceinline void __cdecl test_kernel_aes128_keyexpand(unsigned index) {
+    __m128i k[11];
+    aes128_expand_key(k, Vsrc[index].___m128i);
+    Vout[index].__am128i[0] = k[10];
+    Vout[index].__am128i[1] = k[5]; }
+
+__forceinline void __cdecl test_kernel_aes128_ctr(unsigned index) {
+    __m128i c[8];
+    __m128i x = _mm_setzero_si128();
+    for (unsigned i = 0; i < 8; i++)
+        c[i] = _mm_xor_si128(_mm_set_epi64x(0, index * 8 + i), AesEncKeys[0]);
+    for (unsigned r = 1; r < 10; r++)
+        for (unsigned i = 0; i < 8; i++)
+            c[i] = _mm_aesenc_si128(c[i], AesEncKeys[r]);
+    for (unsigned i = 0; i < 8; i++)
+        x = _mm_xor_si128(x, _mm_aesenclast_si128(c[i], AesEncKeys[10]));
+    Vout[index].___m128i = x; }
+
+#if defined(TEST_VAES)
+
+__forceinline void __cdecl test_kernel_vaes_ctr(unsigned index) {
+    __m256i c[4];
+    __m256i x = _mm256_setzero_si256();
+    for (unsigned i = 0; i < 4; i++)
+        c[i] = _mm256_xor_si256(_mm256_set_m128i(_mm_set_epi64x(0, index * 8 + i * 2 + 1), _mm_set_epi64x(0, index * 8 + i * 2)),
+                                _mm256_broadcastsi128_si256(AesEncKeys[0]));
+    for (unsigned r = 1; r < 10; r++)
+        for (unsigned i = 0; i < 4; i++)
+            c[i] = _mm256_aesenc_epi128(c[i], _mm256_broadcastsi128_si256(AesEncKeys[r]));
+    for (unsigned i = 0; i < 4; i++)
+        x = _mm256_xor_si256(x, _mm256_aesenclast_epi128(c[i], _mm256_broadcastsi128_si256(AesEncKeys[10])));
+    Vout[index].___m128i = _mm_xor_si128(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1)); }
+
+#endif // VAES kernels
+
+
+//
+// Carry-less multiply vectors for each of the four PCLMULQDQ selectors.  Vector 0
+// has a single bit in each qword so that each selector has a distinct product:
+// 0x00 gives 1:0, 0x01 gives 0:2, 0x10 gives 4000000000000000:0 and 0x11 gives
+// 0:8000000000000000 (high:low).  The all ones square is 5555...5555.
+//
+
+const unsigned __int64 ClmulVectors[8][4] = {
+    // a low              a high                b low                 b high
+    { 0x8000000000000000, 0x0000000000000001, 0x0000000000000002, 0x8000000000000000 },
+    { 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF },
+    { 0x0000000000000000, 0xFFFFFFFFFFFFFFFF, 0x123456789ABCDEF0, 0x0000000000000000 },
+    { 0x0000000000000087, 0xC200000000000000, 0x0000000000000001, 0x0000000000000087 },
+    { 0x66E94BD4EF8A2C3B, 0x884CFA59CA342B2E, 0x0388DACE60B6A392, 0xF328C2B971B2FE78 },
+    { 0xAAAAAAAAAAAAAAAA, 0x5555555555555555, 0x5555555555555555, 0xAAAAAAAAAAAAAAAA },
+    { 0x0000000100000001, 0x8000000080000000, 0xFEDCBA9876543210, 0x0123456789ABCDEF },
+    { 0x00000000000000FF, 0xFF00000000000000, 0x00000000000000FF, 0xFF00000000000000 },
+};
+
+__forceinline void __cdecl test_kernel_clmul_vectors(unsigned index) {
+    const __m128i a = _mm_loadu_si128((const __m128i *)&ClmulVectors[index & 7][0]);
+    const __m128i b = _mm_loadu_si128((const __m128i *)&ClmulVectors[index & 7][2]);
+    Vout[index].__am128i[0] = _mm_clmulepi64_si128(a, b, 0x00);
+    Vout[index].__am128i[1] = _mm_clmulepi64_si128(a, b, 0x11); }
+
+__forceinline void __cdecl test_kernel_clmul_vectors_mixed(unsigned index) {
+    const __m128i a = _mm_loadu_si128((const __m128i *)&ClmulVectors[index & 7][0]);
+    const __m128i b = _mm_loadu_si128((const __m128i *)&ClmulVectors[index & 7][2]);
+    Vout[index].__am128i[0] = _mm_clmulepi64_si128(a, b, 0x01);
+    Vout[index].__am128i[1] = _mm_clmulepi64_si128(a, b, 0x10); }
+
+#if defined(TEST_VPCLMULQDQ)
+
+__forceinline void __cdecl test_kernel_vpclmul_vectors(unsigned index) {
+    const __m256i a = _mm256_set_m128i(_mm_loadu_si128((const __m128i *)&ClmulVectors[(index + 1) & 7][0]),
+                                       _mm_loadu_si128((const __m128i *)&ClmulVectors[index & 7][0]));
+    const __m256i b = _mm256_set_m128i(_mm_loadu_si128((const __m128i *)&ClmulVectors[(index + 1) & 7][2]),
+                                       _mm_loadu_si128((const __m128i *)&ClmulVectors[index & 7][2]));
+    Vout[index].___m256i = _mm256_xor_si256(_mm256_clmulepi64_epi128(a, b, 0x01), _mm256_clmulepi64_epi128(a, b, 0x10)); }
+
+#endif // VPCLMULQDQ kernels
+
+//
+// GHASH as in GCM, with the byte reflected multiply and shift reduction from the
+// Intel carry-less multiplication white paper.  The serial kernel does one
+// multiply and reduction per block, the aggregated kernel multiplies 4 blocks by
+// H^4..H^1 and reduces once, which is how GCM implementations reach throughput.
+// The hash key is H from GCM test case 2, where GHASH of the ciphertext block
+// 0388DACE...71B2FE78 and the length block gives F38CBB1A...B6B0F885; the known
+// answer kernel outputs that for every index.
+//
+
+#define GHASH_BLOCKS    256
+
+__declspec(align(16)) __m128i GhashData[GHASH_BLOCKS];
+__declspec(align(16)) __m128i GhashKeyPowers[4];
+
+const unsigned __int8 GhashKeyH[16] = {
+    0x66, 0xE9, 0x4B, 0xD4, 0xEF, 0x8A, 0x2C, 0x3B, 0x88, 0x4C, 0xFA, 0x59, 0xCA, 0x34, 0x2B, 0x2E,
+};
+
+const unsigned __int8 GhashCipher[16] = {
+    0x03, 0x88, 0xDA, 0xCE, 0x60, 0xB6, 0xA3, 0x92, 0xF3, 0x28, 0xC2, 0xB9, 0x71, 0xB2, 0xFE, 0x78,
+};
+
+__forceinline __m128i ghash_bswap(__m128i a) {
+    return _mm_shuffle_epi8(a, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)); }
+
+__forceinline void ghash_mul_wide(__m128i a, __m128i b, __m128i *lo, __m128i *hi) {
+    __m128i mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+    *lo = _mm_xor_si128(*lo, _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x00), _mm_slli_si128(mid, 8)));
+    *hi = _mm_xor_si128(*hi, _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x11), _mm_srli_si128(mid, 8))); }
+
+__forceinline __m128i ghash_reduce(__m128i lo, __m128i hi) {
+    __m128i t7 = _mm_srli_epi32(lo, 31);
+    __m128i t8 = _mm_srli_epi32(hi, 31);
+    __m128i t9 = _mm_srli_si128(t7, 12);
+    lo = _mm_or_si128(_mm_slli_epi32(lo, 1), _mm_slli_si128(t7, 4));
+    hi = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(hi, 1), _mm_slli_si128(t8, 4)), t9);
+    t7 = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)), _mm_slli_epi32(lo, 25));
+    t8 = _mm_srli_si128(t7, 4);
+    lo = _mm_xor_si128(lo, _mm_slli_si128(t7, 12));
+    t9 = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)), _mm_srli_epi32(lo, 7));
+    lo = _mm_xor_si128(lo, _mm_xor_si128(t9, t8));
+    return _mm_xor_si128(hi, lo); }
+
+__forceinline __m128i ghash_mul(__m128i a, __m128i b) {
+    __m128i lo = _mm_setzero_si128();
+    __m128i hi = _mm_setzero_si128();
+    ghash_mul_wide(a, b, &lo, &hi);
+    return ghash_reduce(lo, hi); }
+
+__declspec(noinline)
+void init_clmul_kernels(void)
+{
+    GhashKeyPowers[0] = ghash_bswap(_mm_loadu_si128((const __m128i *)GhashKeyH));
+
+    for (unsigned i = 1; i < 4; i++)
+    {
+        GhashKeyPowers[i] = ghash_mul(GhashKeyPowers[i - 1], GhashKeyPowers[0]);
+    }
+
+    for (unsigned i = 0; i < GHASH_BLOCKS; i++)
+    {
+        GhashData[i] = _mm_set_epi32(i * 0x9E3779B9, ~i, i * 0x01000193, i);
+    }
+}
+
+__forceinline void __cdecl test_kernel_ghash_known_answer(unsigned index) {
+    __m128i x = ghash_mul(ghash_bswap(_mm_loadu_si128((const __m128i *)GhashCipher)), GhashKeyPowers[0]);
+    x = ghash_mul(_mm_xor_si128(x, _mm_set_epi64x(0, 128)), GhashKeyPowers[0]);
+    Vout[index].___m128i = ghash_bswap(x); }
+
+__forceinline void __cdecl test_kernel_ghash_serial(unsigned index) {
+    __m128i x = Vsrc[index].___m128i;
+    for (unsigned i = 0; i < (index + 1) * 16; i++)
+        x = ghash_mul(_mm_xor_si128(x, GhashData[i]), GhashKeyPowers[0]);
+    Vout[index].___m128i = x; }
+
+__forceinline void __cdecl test_kernel_ghash_aggregated(unsigned index) {
+    __m128i x = Vsrc[index].___m128i;
+    for (unsigned i = 0; i < (index + 1) * 16; i += 4) {
+        __m128i lo = _mm_setzero_si128();
+        __m128i hi = _mm_setzero_si128();
+        ghash_mul_wide(_mm_xor_si128(x, GhashData[i + 0]), GhashKeyPowers[3], &lo, &hi);
+        ghash_mul_wide(GhashData[i + 1], GhashKeyPowers[2], &lo, &hi);
+        ghash_mul_wide(GhashData[i + 2], GhashKeyPowers[1], &lo, &hi);
+        ghash_mul_wide(GhashData[i + 3], GhashKeyPowers[0], &lo, &hi);
+        x = ghash_reduce(lo, hi); }
+    Vout[index].___m128i = x; }
+
+
+#if defined(TEST_SHA)
+
+//
+// SHA-256 and SHA-1 block compression in the usual SHA-NI form, with the message
+// schedule for each group of 4 rounds computed in place in a ring of 4 vectors.
+// The NIST kernels hash the padded one block message "abc" on even indices and
+// the two block message "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"
+// on odd indices, and must give these digest words:
+//
+//   SHA-256("abc")  BA7816BF 8F01CFEA 414140DE 5DAE2223 B00361A3 96177A9C B410FF61 F20015AD
+//   SHA-256(448)    248D6A61 D20638B8 E5C02693 0C3E6039 A33CE459 64FF2167 F6ECEDD4 19DB06C1
+//   SHA-1("abc")    A9993E36 4706816A BA3E2571 7850C26C 9CD0D89D
+//   SHA-1(448)      84983E44 1C3BD26E BAAE4AA1 F95129E5 E54670F1
+//
+// The buffer kernels measure hashing throughput over 1 to 14 KB.
+//
+
+#define SHA_DATA_BLOCKS 256
+
+__declspec(align(16)) unsigned __int8 ShaNistAbc[64];
+__declspec(align(16)) unsigned __int8 ShaNist448[128];
+__declspec(align(16)) unsigned __int8 ShaData[SHA_DATA_BLOCKS * 64];
+
+__declspec(align(16)) const unsigned __int32 Sha256K[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+};
+
+__declspec(noinline)
+void init_sha_padded(unsigned __int8 *block, const char *msg, unsigned blocks)
+{
+    unsigned cb = 0;
+
+    for (; msg[cb] != 0; cb++)
+    {
+        block[cb] = (unsigned __int8)msg[cb];
+    }
+
+    block[cb] = 0x80;
+
+    for (unsigned i = cb + 1; i < blocks * 64; i++)
+    {
+        block[i] = 0;
+    }
+
+    block[blocks * 64 - 2] = (unsigned __int8)((cb * 8) >> 8);
+    block[blocks * 64 - 1] = (unsigned __int8)(cb * 8);
+}
+
+__declspec(noinline)
+void init_sha_kernels(void)
+{
+    init_sha_padded(ShaNistAbc, "abc", 1);
+    init_sha_padded(ShaNist448, "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 2);
+
+    for (unsigned i = 0; i < sizeof(ShaData); i++)
+    {
+        ShaData[i] = (unsigned __int8)(i * 167 + (i >> 8));
+    }
+}
+
+__forceinline void sha256_compress(__m128i *abef, __m128i *cdgh, const unsigned __int8 *block) {
+    const __m128i mask = _mm_set_epi64x(0x0C0D0E0F08090A0B, 0x0405060700010203);
+    __m128i s0 = *abef, s1 = *cdgh, msg[4], wk;
+    for (unsigned i = 0; i < 4; i++)
+        msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(block + i * 16)), mask);
+    for (unsigned g = 0; g < 16; g++) {
+        if (g >= 4)
+            msg[g & 3] = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(msg[g & 3], msg[(g + 1) & 3]),
+                                                            _mm_alignr_epi8(msg[(g + 3) & 3], msg[(g + 2) & 3], 4)), msg[(g + 3) & 3]);
+        wk = _mm_add_epi32(msg[g & 3], _mm_loadu_si128((const __m128i *)&Sha256K[g * 4]));
+        s1 = _mm_sha256rnds2_epu32(s1, s0, wk);
+        s0 = _mm_sha256rnds2_epu32(s0, s1, _mm_shuffle_epi32(wk, 0x0E)); }
+    *abef = _mm_add_epi32(s0, *abef);
+    *cdgh = _mm_add_epi32(s1, *cdgh); }
+
+__forceinline void sha256_blocks(__m256i *out, const unsigned __int8 *p, unsigned blocks) {
+    __m128i abef = _mm_set_epi32(0x6A09E667, 0xBB67AE85, 0x510E527F, 0x9B05688C);
+    __m128i cdgh = _mm_set_epi32(0x3C6EF372, 0xA54FF53A, 0x1F83D9AB, 0x5BE0CD19);
+    for (unsigned i = 0; i < blocks; i++)
+        sha256_compress(&abef, &cdgh, p + i * 64);
+    // digest words A..D and E..H in dword order
+    ((__m128i *)out)[0] = _mm_shuffle_epi32(_mm_unpackhi_epi64(cdgh, abef), 0x1B);
+    ((__m128i *)out)[1] = _mm_shuffle_epi32(_mm_unpacklo_epi64(cdgh, abef), 0x1B); }
+
+#define SHA1_ROUNDS20(abcd, e, prev, msg, first, func)                                                     \
+    for (unsigned g = first; g < first + 5; g++) {                                                          \
+        if (g >= 4)                                                                                         \
+            msg[g & 3] = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(msg[g & 3], msg[(g + 1) & 3]), \
+                                                          msg[(g + 2) & 3]), msg[(g + 3) & 3]);             \
+        e = (g == 0) ? _mm_add_epi32(e, msg[0]) : _mm_sha1nexte_epu32(prev, msg[g & 3]);                    \
+        prev = abcd;                                                                                        \
+        abcd = _mm_sha1rnds4_epu32(abcd, e, func); }
+
+__forceinline void sha1_compress(__m128i *abcd, __m128i *e0, const unsigned __int8 *block) {
+    const __m128i mask = _mm_set_epi64x(0x0001020304050607, 0x08090A0B0C0D0E0F);
+    __m128i a = *abcd, e = *e0, prev = a, msg[4];
+    for (unsigned i = 0; i < 4; i++)
+        msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(block + i * 16)), mask);
+    SHA1_ROUNDS20(a, e, prev, msg, 0, 0)
+    SHA1_ROUNDS20(a, e, prev, msg, 5, 1)
+    SHA1_ROUNDS20(a, e, prev, msg, 10, 2)
+    SHA1_ROUNDS20(a, e, prev, msg, 15, 3)
+    *e0 = _mm_sha1nexte_epu32(prev, *e0);
+    *abcd = _mm_add_epi32(a, *abcd); }
+
+__forceinline void sha1_blocks(__m256i *out, const unsigned __int8 *p, unsigned blocks) {
+    __m128i abcd = _mm_set_epi32(0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476);
+    __m128i e = _mm_set_epi32(0xC3D2E1F0, 0, 0, 0);
+    for (unsigned i = 0; i < blocks; i++)
+        sha1_compress(&abcd, &e, p + i * 64);
+    // digest words A..D in dword order, then E
+    ((__m128i *)out)[0] = _mm_shuffle_epi32(abcd, 0x1B);
+    ((__m128i *)out)[1] = _mm_srli_si128(e, 12); }
+
+__forceinline void __cdecl test_kernel_sha256_nist(unsigned index) {
+    if (index & 1) sha256_blocks(&Vout[index].___m256i, ShaNist448, 2);
+    else           sha256_blocks(&Vout[index].___m256i, ShaNistAbc, 1); }
+
+__forceinline void __cdecl test_kernel_sha1_nist(unsigned index) {
+    if (index & 1) sha1_blocks(&Vout[index].___m256i, ShaNist448, 2);
+    else           sha1_blocks(&Vout[index].___m256i, ShaNistAbc, 1); }
+
+__forceinline void __cdecl test_kernel_sha256_buffer(unsigned index) {
+    sha256_blocks(&Vout[index].___m256i, ShaData, (index + 1) * 16); }
+
+__forceinline void __cdecl test_kernel_sha1_buffer(unsigned index) {
+    sha1_blocks(&Vout[index].___m256i, ShaData, (index + 1) * 16); }
+
+#endif // SHA kernels
+
+
+//
+// VCVTPS2PH on overflow and underflow boundaries, ties, binary16 denormals, NaNs
+// with payload bits both kept and dropped, infinities and signed zeros, in each
+// rounding mode, and VCVTPH2PS on the binary16 encodings of the same classes.
+// The buffer kernel checksums fp16 conversion of a weight-like buffer and sums the
+// widened round trip, as fp16 storage code does.
+//
+
+const unsigned __int32 F16EdgeF32[24] = {
+    0x477FE000, 0x477FEFFF, 0x477FF000, 0xC77FF000,     // 65504, 65520-, 65520 (tie), -65520
+    0x501502F9, 0x33800000, 0x33000000, 0x33400000,     // 1e10, 2^-24, 2^-25 (tie), 3*2^-26
+    0x38800000, 0x387FC000, 0x3F801000, 0xBF803000,     // 2^-14, 2^-14-2^-24, 1+2^-11 (tie), -(1+3*2^-11)
+    0x3EAAAAAB, 0xB3400000, 0x7FC00001, 0x7FFFE000,     // 1/3, -3*2^-26, QNaN low payload, QNaN high payload
+    0xFF812345, 0x7F800000, 0xFF800000, 0x80000000,     // -SNaN, +Inf, -Inf, -0.0
+    0x00000000, 0x00000001, 0x80000001, 0x7F7FFFFF,     // +0.0, +denormal, -denormal, FLT_MAX
+};
+
+const unsigned __int16 F16EdgeF16[24] = {
+    0x7BFF, 0xFBFF, 0x0400, 0x03FF, 0x0001, 0x8001, 0x0000, 0x8000,     // max, -max, min normal, denormals, zeros
+    0x7C00, 0xFC00, 0x7E00, 0xFE00, 0x7C01, 0xFDFF, 0x7FFF, 0x7D55,     // infinities, QNaNs, SNaNs with payloads
+    0x3C00, 0x3555, 0xC000, 0x5640, 0x0200, 0x83FF, 0x7800, 0xF800,     // 1, 1/3, -2, 100, denormals, 32768, -32768
+};
+
+#define F16C_DATA_FLOATS    1024
+
+__declspec(align(32)) float F16Data[F16C_DATA_FLOATS];
+
+__declspec(noinline)
+void init_f16c_kernels(void)
+{
+    for (unsigned i = 0; i < F16C_DATA_FLOATS; i++)
+    {
+        // a spread of magnitudes from binary16 denormals to large values
+
+        F16Data[i] = ((float)(int)((i * 2654435761u) >> 16) - 32768.0f) * (1.0f / (float)(1u << (i % 31)));
+    }
+}
+
+__forceinline void __cdecl test_kernel_cvtps_ph_edges(unsigned index) {
+    __m256 a = _mm256_loadu_ps((const float *)&F16EdgeF32[index % 17]);
+    ROUND_EDGE_MODES(index, Vout[index].__am128i[0], _mm256_cvtps_ph, a)
+    ROUND_EDGE_MODES(index, Vout[index].__am128i[1], _mm_cvtps_ph, _mm_loadu_ps((const float *)&F16EdgeF32[(index + 7) % 21])) }
+
+__forceinline void __cdecl test_kernel_cvtph_ps_edges(unsigned index) {
+    __m128i a = _mm_loadu_si128((const __m128i *)&F16EdgeF16[index % 17]);
+    Vout[index].___m256 = _mm256_cvtph_ps(a); }
+
+__forceinline void __cdecl test_kernel_cvtss_sh_edges(unsigned index) {
+    unsigned short h0, h1;
+    ROUND_EDGE_MODES(index, h0, _cvtss_sh, _mm_cvtss_f32(_mm_castsi128_ps(_mm_cvtsi32_si128((int)F16EdgeF32[index]))))
+    ROUND_EDGE_MODES(index, h1, _cvtss_sh, _mm_cvtss_f32(_mm_castsi128_ps(_mm_cvtsi32_si128((int)F16EdgeF32[index + 10]))))
+    Vout[index].__am128i[0] = _mm_setr_epi32(h0, h1, 0, 0);
+    Vout[index].__am128[1] = _mm_setr_ps(_cvtsh_ss(F16EdgeF16[index]), _cvtsh_ss(F16EdgeF16[index + 10]), 0.0f, 0.0f); }
+
+__forceinline void __cdecl test_kernel_cvtps_ph_buffer(unsigned index) {
+    __m128i h = _mm_setzero_si128();
+    __m256 s = _mm256_setzero_ps();
+    for (unsigned i = 0; i < (index + 1) * 64; i += 8) {
+        __m128i t = _mm256_cvtps_ph(_mm256_loadu_ps(&F16Data[i]), _MM_FROUND_TO_NEAREST_INT);
+        h = _mm_xor_si128(_mm_slli_epi32(h, 1), t);
+        s = _mm256_add_ps(s, _mm256_cvtph_ps(t)); }
+    Vout[index].__am128i[0] = h;
+    Vout[index].__am128i[1] = _mm_castps_si128(_mm_add_ps(_mm256_castps256_ps128(s), _mm256_extractf128_ps(s, 1))); }
+
+
+//
+// Streaming stores and loads of every width through a scratch area, and fill
+// bandwidth with ordinary and streaming 256-bit stores at 1 MB to 1 GB.  Each
+// store has its own slot in the scratch area and the 256-bit and 128-bit
+// streaming loads read all of it back.  Each fill index fills its own 1/16th of
+// the buffer so a pass over all the indices writes most of it, and the ps/op
+// figure is the time per (size / 16) bytes.  The fill buffer is allocated and
+// faulted in once by init_fill_kernels, so no fill kernel pays for that.
+//
+//   [0..31] si256  [32..63] 256-bit ps  [64..79] pd  [80..95] si128
+//   [96..99] si32  [104..111] si64  [112..127] ps
+//
+
+__declspec(align(64)) unsigned __int8 StreamScratch[128];
+
+__forceinline void __cdecl test_kernel_stream_roundtrip(unsigned index) {
+    _mm256_stream_si256((__m256i *)&StreamScratch[0], Vsrc[index].___m256i);
+    _mm256_stream_ps((float *)&StreamScratch[32], Vsrc[index + 1].___m256);
+    _mm_stream_pd((double *)&StreamScratch[64], Vsrc[index + 2].___m128d);
+    _mm_stream_si128((__m128i *)&StreamScratch[80], Vsrc[index + 2].__am128i[1]);
+    _mm_stream_si32((int *)&StreamScratch[96], index);
+#if !defined(_M_IX86)
+    _mm_stream_si64((__int64 *)&StreamScratch[104], Vsrc[index].___int64);
+#endif
+    _mm_stream_ps((float *)&StreamScratch[112], Vsrc[index + 1].__am128[1]);
+    _mm_sfence();
+    __m256i L0 = _mm256_stream_load_si256((const __m256i *)&StreamScratch[0]);
+    __m256i L1 = _mm256_stream_load_si256((const __m256i *)&StreamScratch[32]);
+    __m256i L2 = _mm256_set_m128i(_mm_stream_load_si128((const __m128i *)&StreamScratch[80]),
+                                  _mm_stream_load_si128((const __m128i *)&StreamScratch[64]));
+    __m256i L3 = _mm256_stream_load_si256((const __m256i *)&StreamScratch[96]);
+    Vout[index].___m256i = _mm256_add_epi32(_mm256_add_epi32(L0, L1), _mm256_add_epi32(L2, L3)); }
+
+// a 1 GB buffer does not reliably fit in a 32-bit address space
+
+#if !defined(_M_IX86)
+#define FILL_BUFFER_SIZE    ((size_t)1 << 30)
+#else
+#define FILL_BUFFER_SIZE    ((size_t)1 << 28)
+#endif
+
+__m256i *FillBuffer;
+
+__declspec(noinline)
+void init_fill_kernels(void)
+{
+    FillBuffer = (__m256i *)VirtualAlloc(NULL, FILL_BUFFER_SIZE, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (FillBuffer == NULL)
+    {
+        printf("failed to allocate the fill buffer\n");
+        exit(1);
+    }
+
+    // take the demand-zero faults here, outside of the timed fill kernels
+
+    for (size_t i = 0; i < FILL_BUFFER_SIZE; i += 4096)
+    {
+        ((unsigned __int8 *)FillBuffer)[i] = 0;
+    }
+}
+
+__forceinline void fill_chunk(unsigned index, size_t cb, int stream) {
+    const size_t count = cb / 16 / sizeof(__m256i);
+    const __m256i v = Vsrc[index].___m256i;
+    __m256i *p = FillBuffer + index * count;
+    if (stream) {
+        for (size_t i = 0; i < count; i += 2) {
+            _mm256_stream_si256(p + i + 0, v);
+            _mm256_stream_si256(p + i + 1, v); }
+        _mm_sfence(); }
+    else {
+        for (size_t i = 0; i < count; i += 2) {
+            p[i + 0] = v;
+            p[i + 1] = v; } }
+    Vout[index].___m256i = _mm256_add_epi64(p[0], p[count - 1]); }
+
+#define DEFINE_FILL_KERNELS(name, cb) \
+__forceinline void __cdecl test_kernel_fill_store_ ## name(unsigned index)  { fill_chunk(index, cb, 0); } \
+__forceinline void __cdecl test_kernel_fill_stream_ ## name(unsigned index) { fill_chunk(index, cb, 1); }
+
+DEFINE_FILL_KERNELS(1mb,   (size_t)1 << 20)
+DEFINE_FILL_KERNELS(16mb,  (size_t)1 << 24)
+DEFINE_FILL_KERNELS(256mb, (size_t)1 << 28)
+
+#if !defined(_M_IX86)
+DEFINE_FILL_KERNELS(1gb,   (size_t)1 << 30)
+#endif
+
+
+//
+// Spin lock and pointer chasing.  The spin lock kernels take and release a test
+// and test-and-set lock with _mm_pause in the wait loop, alone and against a
+// second thread hammering the same lock, which shows the PAUSE mapping under
+// contention.  The second thread is started at init and sleeps until the
+// contended kernel runs, goes back to sleep 100 ms after that kernel last ran,
+// and the stop kernel listed right after it ends the thread so that it does not
+// disturb the kernels that follow.  The pointer chase walks a random cycle of
+// cache line sized nodes in a 16 MB buffer, plain and with each node prefetching
+// the node 8 hops ahead with the T0 or NTA hint, as B-tree and queue traversals
+// do.  The results are the sums of the node values, which do not depend on the
+// prefetch hint.
+//
+
+#define CHASE_NODES     (1u << 18)
+#define CHASE_STEPS     512
+#define CHASE_AHEAD     8
+
+typedef struct CHASE_NODE
+{
+    struct CHASE_NODE *Next;
+    struct CHASE_NODE *Ahead;
+    unsigned __int32 Value;
+    unsigned __int8 Pad[64 - 2 * sizeof(void *) - sizeof(unsigned __int32)];
+} CHASE_NODE;
+
+C_ASSERT(sizeof(CHASE_NODE) == 64);
+
+CHASE_NODE *ChaseNodes;
+
+volatile long SpinLock;
+volatile DWORD SpinContenderTick;
+volatile long SpinContenderExit;
+HANDLE SpinContender;
+
+__forceinline void spin_acquire(volatile long *lock) {
+    while (_InterlockedExchange(lock, 1) != 0)
+        while (*lock != 0)
+            _mm_pause(); }
+
+__forceinline void spin_release(volatile long *lock) {
+    _InterlockedExchange(lock, 0); }
+
+DWORD WINAPI spin_contender(LPVOID Context)
+{
+    (void)Context;
+
+    while (!SpinContenderExit)
+    {
+        if ((GetTickCount() - SpinContenderTick) > 100)
+        {
+            Sleep(1);
+            continue;
+        }
+
+        spin_acquire(&SpinLock);
+        spin_release(&SpinLock);
+    }
+
+    return 0;
+}
+
+__declspec(noinline)
+void stop_spin_contender(void)
+{
+    if (SpinContender != NULL)
+    {
+        SpinContenderExit = 1;
+        WaitForSingleObject(SpinContender, INFINITE);
+        CloseHandle(SpinContender);
+        SpinContender = NULL;
+        SpinContenderExit = 0;
+    }
+}
+
+__declspec(noinline)
+void init_cache_kernels(void)
+{
+    SpinContender = CreateThread(NULL, 0, spin_contender, NULL, 0, NULL);
+
+    if (SpinContender == NULL)
+    {
+        printf("failed to create the spin lock contender thread\n");
+        exit(1);
+    }
+
+    unsigned *Order = (unsigned *)malloc(CHASE_NODES * sizeof(unsigned));
+
+    ChaseNodes = (CHASE_NODE *)VirtualAlloc(NULL, CHASE_NODES * sizeof(CHASE_NODE), MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if ((Order == NULL) || (ChaseNodes == NULL))
+    {
+        free(Order);
+        return;
+    }
+
+    // a random single cycle through all the nodes (Fisher-Yates with an LCG)
+
+    unsigned Seed = 12345;
+
+    for (unsigned i = 0; i < CHASE_NODES; i++)
+    {
+        Order[i] = i;
+    }
+
+    for (unsigned i = CHASE_NODES - 1; i > 0; i--)
+    {
+        Seed = Seed * 1664525 + 1013904223;
+
+        unsigned j = Seed % (i + 1);
+        unsigned t = Order[i];
+        Order[i] = Order[j];
+        Order[j] = t;
+    }
+
+    for (unsigned i = 0; i < CHASE_NODES; i++)
+    {
+        CHASE_NODE *Node = &ChaseNodes[Order[i]];
+
+        Node->Next  = &ChaseNodes[Order[(i + 1) % CHASE_NODES]];
+        Node->Ahead = &ChaseNodes[Order[(i + CHASE_AHEAD) % CHASE_NODES]];
+        Node->Value = i;
+    }
+
+    free(Order);
+}
+
+__forceinline void __cdecl test_kernel_spinlock_uncontended(unsigned index) {
+    for (unsigned i = 0; i < 64; i++) {
+        spin_acquire(&SpinLock);
+        Vout[index]._int += i;
+        spin_release(&SpinLock); } }
+
+__forceinline void __cdecl test_kernel_spinlock_contended(unsigned index) {
+    SpinContenderTick = GetTickCount();
+    for (unsigned i = 0; i < 64; i++) {
+        spin_acquire(&SpinLock);
+        Vout[index]._int += i;
+        spin_release(&SpinLock); } }
+
+__forceinline void __cdecl test_kernel_spinlock_stop_contender(unsigned index) {
+    stop_spin_contender();
+    Vout[index]._int = (SpinContender == NULL); }
+
+__forceinline void __cdecl test_kernel_pause(unsigned index) {
+    for (unsigned i = 0; i < 16; i++)
+        _mm_pause();
+    Vout[index]._int = index; }
+
+__forceinline void __cdecl test_kernel_fences(unsigned index) {
+    Vout[index].__am128i[0] = Vsrc[index].___m128i;
+    _mm_sfence();
+    Vout[index].__am128i[1] = Vsrc[index + 1].___m128i;
+    _mm_mfence();
+    Vout[index].__am128i[0] = _mm_add_epi32(Vout[index].__am128i[0], Vout[index].__am128i[1]);
+    _mm_lfence(); }
+
+__forceinline void __cdecl test_kernel_clflush(unsigned index) {
+    Vout[index].___m256i = Vsrc[index].___m256i;
+    _mm_clflush(&Vout[index]);
+    _mm_prefetch((char const *)&Vout[index], _MM_HINT_T0); }
+
+__forceinline void __cdecl test_kernel_prefetch_hints(unsigned index) {
+    _mm_prefetch((char const *)&Vsrc[index + 1], _MM_HINT_T1);
+    _mm_prefetch((char const *)&Vsrc[index + 2], _MM_HINT_T2);
+    // older x64 SDK headers do not define the write prefetch hints
+#if defined(_MM_HINT_ET0) && defined(_MM_HINT_ET1) && defined(_MM_HINT_ET2) && defined(_MM_HINT_ENTA)
+    _mm_prefetch((char const *)&Vout[index], _MM_HINT_ET0);
+    _mm_prefetch((char const *)&Vout[index + 1], _MM_HINT_ET1);
+    _mm_prefetch((char const *)&Vout[index + 2], _MM_HINT_ET2);
+    _mm_prefetch((char const *)&StreamScratch[0], _MM_HINT_ENTA);
+#endif
+    _m_prefetchw(&Vout[index]);
+    Vout[index].___m256i = _mm256_add_epi32(Vsrc[index].___m256i, Vsrc[index + 1].___m256i); }
+
+#if defined(TEST_CLWB)
+
+// CLFLUSHOPT and CLWB
+
+__forceinline void __cdecl test_kernel_clflushopt_clwb(unsigned index) {
+    Vout[index].___m256i = Vsrc[index].___m256i;
+    _mm_clwb(&Vout[index]);
+    _mm_sfence();
+    Vout[index].__am128i[1] = _mm_add_epi32(Vout[index].__am128i[0], Vout[index].__am128i[1]);
+    _mm_clflushopt(&Vout[index]);
+    _mm_sfence(); }
+
+#endif // CLFLUSHOPT and CLWB kernels
+
+#define DEFINE_CHASE_KERNEL(name, prefetch) \
+__forceinline void __cdecl test_kernel_pointer_chase_ ## name(unsigned index) { \
+    if (ChaseNodes == NULL) return; \
+    CHASE_NODE *Node = &ChaseNodes[index * (CHASE_NODES / 16)]; \
+    unsigned __int32 Sum = 0; \
+    for (unsigned i = 0; i < CHASE_STEPS; i++) { \
+        prefetch; \
+        Sum += Node->Value; \
+        Node = Node->Next; } \
+    Vout[index]._int = Sum; }
+
+DEFINE_CHASE_KERNEL(plain, (void)0)
+DEFINE_CHASE_KERNEL(t0,    _mm_prefetch((char const *)Node->Ahead, _MM_HINT_T0))
+DEFINE_CHASE_KERNEL(nta,   _mm_prefetch((char const *)Node->Ahead, _MM_HINT_NTA))
+
+
+//
+// String compares in each aggregation mode.  Every row pairs a set, range list
+// or needle with a text, and explicit lengths that exercise negative and over
+// long lengths.  The strings are zero padded, and rows 3 and 7 have zeros inside
+// so that the implicit length forms stop early where the explicit forms do not.
+// Each kernel outputs a mask and packs indexes and the A C O S Z flags in bits 0..4.
+//
+
+const char PcmpstrSets[8][17] = {
+    " \t\r\n",
+    "azAZ09",
+    "needle",
+    "\x80" "\x00" "\x01" "\x7F",
+    "abc",
+    "0123456789abcdef",
+    "",
+    "ab\0cd",
+};
+
+const char PcmpstrText[8][17] = {
+    "GET / HTTP/1.1\r\n",
+    "Hello, World 42!",
+    "haystack needle.",
+    "\x01\x7F\x80\xFF" "q" "\0" "\x81",
+    "xxabcabcab",
+    "fedcba9876543210",
+    "anything",
+    "abcdab\0cd",
+};
+
+const int PcmpstrLengths[8][2] = {
+    {  4,  16 }, {  6,  16 }, {  6,  16 }, {  4,   7 },
+    { -3,  10 }, { 20, -20 }, {  0,   8 }, {  5,  -9 },
+};
+
+#define PCMPESTR_FLAGS(a, la, b, lb, imm8) \
+    (_mm_cmpestra(a, la, b, lb, imm8) | (_mm_cmpestrc(a, la, b, lb, imm8) << 1) | (_mm_cmpestro(a, la, b, lb, imm8) << 2) | \
+    (_mm_cmpestrs(a, la, b, lb, imm8) << 3) | (_mm_cmpestrz(a, la, b, lb, imm8) << 4))
+
+#define PCMPISTR_FLAGS(a, b, imm8) \
+    (_mm_cmpistra(a, b, imm8) | (_mm_cmpistrc(a, b, imm8) << 1) | (_mm_cmpistro(a, b, imm8) << 2) | \
+    (_mm_cmpistrs(a, b, imm8) << 3) | (_mm_cmpistrz(a, b, imm8) << 4))
+
+#define DEFINE_PCMPSTR_KERNEL(name, mode) \
+__forceinline void __cdecl test_kernel_cmpestr_ ## name(unsigned index) { \
+    const __m128i a = _mm_loadu_si128((const __m128i *)PcmpstrSets[index & 7]); \
+    const __m128i b = _mm_loadu_si128((const __m128i *)PcmpstrText[index & 7]); \
+    const int la = PcmpstrLengths[index & 7][0]; \
+    const int lb = PcmpstrLengths[index & 7][1]; \
+    Vout[index].__am128i[0] = _mm_cmpestrm(a, la, b, lb, _SIDD_UBYTE_OPS | mode); \
+    Vout[index].__am128i[1] = _mm_setr_epi32( \
+        _mm_cmpestri(a, la, b, lb, _SIDD_SBYTE_OPS | mode) | (_mm_cmpestri(a, la, b, lb, _SIDD_UWORD_OPS | mode | _SIDD_MOST_SIGNIFICANT) << 8), \
+        _mm_cmpestri(a, la, b, lb, _SIDD_SWORD_OPS | mode | _SIDD_NEGATIVE_POLARITY) | (_mm_cmpestri(a, la, b, lb, _SIDD_UBYTE_OPS | mode | _SIDD_MASKED_NEGATIVE_POLARITY) << 8), \
+        PCMPESTR_FLAGS(a, la, b, lb, _SIDD_UBYTE_OPS | mode) | (PCMPESTR_FLAGS(a, la, b, lb, _SIDD_SWORD_OPS | mode) << 8), \
+        _mm_cvtsi128_si32(_mm_cmpestrm(a, la, b, lb, _SIDD_UWORD_OPS | mode))); } \
+__forceinline void __cdecl test_kernel_cmpistr_ ## name(unsigned index) { \
+    const __m128i a = _mm_loadu_si128((const __m128i *)PcmpstrSets[index & 7]); \
+    const __m128i b = _mm_loadu_si128((const __m128i *)PcmpstrText[index & 7]); \
+    Vout[index].__am128i[0] = _mm_cmpistrm(a, b, _SIDD_SBYTE_OPS | mode | _SIDD_UNIT_MASK); \
+    Vout[index].__am128i[1] = _mm_setr_epi32( \
+        _mm_cmpistri(a, b, _SIDD_UBYTE_OPS | mode) | (_mm_cmpistri(a, b, _SIDD_SWORD_OPS | mode | _SIDD_MOST_SIGNIFICANT) << 8), \
+        _mm_cmpistri(a, b, _SIDD_UWORD_OPS | mode | _SIDD_MASKED_NEGATIVE_POLARITY) | (_mm_cmpistri(a, b, _SIDD_SBYTE_OPS | mode | _SIDD_NEGATIVE_POLARITY) << 8), \
+        PCMPISTR_FLAGS(a, b, _SIDD_UBYTE_OPS | mode) | (PCMPISTR_FLAGS(a, b, _SIDD_UWORD_OPS | mode) << 8), \
+        _mm_cvtsi128_si32(_mm_cmpistrm(a, b, _SIDD_UWORD_OPS | mode))); }
+
+DEFINE_PCMPSTR_KERNEL(equal_any,     _SIDD_CMP_EQUAL_ANY)
+DEFINE_PCMPSTR_KERNEL(ranges,        _SIDD_CMP_RANGES)
+DEFINE_PCMPSTR_KERNEL(equal_each,    _SIDD_CMP_EQUAL_EACH)
+DEFINE_PCMPSTR_KERNEL(equal_ordered, _SIDD_CMP_EQUAL_ORDERED)
+
+//
+// Text scanning as in parsers.  The HTTP kernel finds each ':', '\r' or '\n' in a
+// block of request headers with PCMPESTRI, one call per delimiter or per 16 bytes.
+// The CSV kernel gets a bit mask of ',', '"' and '\n' per 16 bytes with PCMPESTRM
+// and walks the bits to count fields and sum the field lengths.  Both buffers are
+// padded by 16 bytes so that the last load stays inside.
+//
+
+#define PCMPSTR_TEXT_SIZE   4096
+
+__declspec(align(16)) char PcmpstrHttp[PCMPSTR_TEXT_SIZE + 16];
+__declspec(align(16)) char PcmpstrCsv[PCMPSTR_TEXT_SIZE + 16];
+
+void pcmpstr_fill_text(char *Buffer, const char *Text)
+{
+    unsigned Length = 0;
+
+    while (Text[Length] != 0)
+    {
+        Length++;
+    }
+
+    for (unsigned i = 0; i < PCMPSTR_TEXT_SIZE; i++)
+    {
+        Buffer[i] = Text[i % Length];
+    }
+}
+
+__declspec(noinline)
+void init_pcmpstr_kernels(void)
+{
+    pcmpstr_fill_text(PcmpstrHttp,
+        "Host: www.example.com\r\n"
+        "User-Agent: Mozilla/5.0 (Windows NT 10.0; ARM64)\r\n"
+        "Accept: text/html,application/xhtml+xml\r\n"
+        "Accept-Encoding: gzip, deflate, br\r\n"
+        "Connection: keep-alive\r\n");
+
+    pcmpstr_fill_text(PcmpstrCsv,
+        "1024,\"Seattle\",47.6062,-122.3321,737015\n"
+        "2048,\"Vancouver\",49.2827,-123.1207,662248\n"
+        "4096,\"Portland\",45.5152,-122.6784,652503\n");
+}
+
+__forceinline void __cdecl test_kernel_http_header_scan(unsigned index) {
+    const __m128i Delimiters = _mm_setr_epi8(':', '\r', '\n', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    unsigned Count = 0, Sum = 0;
+    for (unsigned i = index * 16; i < PCMPSTR_TEXT_SIZE; ) {
+        const __m128i Text = _mm_loadu_si128((const __m128i *)&PcmpstrHttp[i]);
+        const int j = _mm_cmpestri(Delimiters, 3, Text, PCMPSTR_TEXT_SIZE - i, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY);
+        if (j == 16) {
+            i += 16;
+            continue; }
+        Count++;
+        Sum += i + j;
+        i += j + 1; }
+    Vout[index].___m128i = _mm_setr_epi32(Count, Sum, 0, 0); }
+
+__forceinline void __cdecl test_kernel_csv_tokenize(unsigned index) {
+    const __m128i Delimiters = _mm_setr_epi8(',', '"', '\n', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    unsigned Fields = 0, Lengths = 0, Start = 0;
+    for (unsigned i = 0; i < PCMPSTR_TEXT_SIZE; i += 16) {
+        const __m128i Text = _mm_loadu_si128((const __m128i *)&PcmpstrCsv[i]);
+        unsigned Mask = _mm_cvtsi128_si32(_mm_cmpestrm(Delimiters, 3, Text, PCMPSTR_TEXT_SIZE - i, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY));
+        while (Mask != 0) {
+            const unsigned j = i + _tzcnt_u32(Mask);
+            if (PcmpstrCsv[j] != '"') {
+                Fields++;
+                Lengths += j - Start;
+                Start = j + 1; }
+            Mask &= Mask - 1; } }
+    Vout[index].___m128i = _mm_setr_epi32(Fields, Lengths, index, 0); }
+
+
+//
+// Masked loads and stores of an array tail where the array ends exactly at a
+// PAGE_NOACCESS guard page.  The number of valid elements before the guard
+// page (0 to 8 dwords or 0 to 4 qwords) and the mask are derived from index,
+// so masked-off lanes always lie in the guard page and would fault if touched.
+//
+
+#define GUARD_PAGE_SIZE (4096)
+
+char *GuardPageEnd;     // first byte of the guard page
+
+void init_maskmov_kernels(void)
+{
+    DWORD OldProtect;
+    char *Buffer = (char *)VirtualAlloc(NULL, 2 * GUARD_PAGE_SIZE, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (Buffer == NULL)
+    {
+        printf("failed to allocate the guard page buffer\n");
+        exit(1);
+    }
+
+    for (unsigned i = 0; i < GUARD_PAGE_SIZE; i++)
+        Buffer[i] = (char)(i * 0x9B + 1);
+
+    if (!VirtualProtect(Buffer + GUARD_PAGE_SIZE, GUARD_PAGE_SIZE, PAGE_NOACCESS, &OldProtect))
+    {
+        printf("failed to protect the guard page\n");
+        exit(1);
+    }
+
+    GuardPageEnd = Buffer + GUARD_PAGE_SIZE;
+}
+
+// sliding windows of count all-ones elements followed by zeros
+
+const __int32 TailMask32[16] = { -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0 };
+const __int64 TailMask64[8]  = { -1, -1, -1, -1, 0, 0, 0, 0 };
+
+__forceinline
+__m256i tail_mask_epi32(unsigned count)
+{
+    return _mm256_castps_si256(_mm256_loadu_ps((float const *)&TailMask32[8 - count]));
+}
+
+__forceinline
+__m256i tail_mask_epi64(unsigned count)
+{
+    return _mm256_castpd_si256(_mm256_loadu_pd((double const *)&TailMask64[4 - count]));
+}
+
+__forceinline void __cdecl test_kernel_maskload_ps_tail(unsigned index) {
+    unsigned count = index % 9;
+    Vout[index].___m256 = _mm256_maskload_ps((float const *)GuardPageEnd - count, tail_mask_epi32(count)); }
+
+__forceinline void __cdecl test_kernel_maskload_epi32_tail(unsigned index) {
+    unsigned count = index % 5;
+    Vout[index].___m128i = _mm_maskload_epi32((int const *)GuardPageEnd - count, _mm256_castsi256_si128(tail_mask_epi32(count))); }
+
+__forceinline void __cdecl test_kernel_maskload_pd_tail(unsigned index) {
+    unsigned count = index % 5;
+    Vout[index].___m256d = _mm256_maskload_pd((double const *)GuardPageEnd - count, tail_mask_epi64(count)); }
+
+__forceinline void __cdecl test_kernel_maskload_epi64_tail(unsigned index) {
+    unsigned count = index % 3;
+    Vout[index].___m128i = _mm_maskload_epi64((__int64 const *)GuardPageEnd - count, _mm256_castsi256_si128(tail_mask_epi64(count))); }
+
+__forceinline void __cdecl test_kernel_maskstore_epi32_tail(unsigned index) {
+    unsigned count = index % 9;
+    float *p = (float *)GuardPageEnd - 8;
+    _mm256_storeu_ps(p, _mm256_setzero_ps());
+    _mm256_maskstore_epi32((int *)p + 8 - count, tail_mask_epi32(count), Vsrc[index].___m256i);
+    Vout[index].___m256 = _mm256_loadu_ps(p); }
+
+__forceinline void __cdecl test_kernel_maskstore_pd_tail(unsigned index) {
+    unsigned count = index % 5;
+    double *p = (double *)GuardPageEnd - 4;
+    _mm256_storeu_pd(p, _mm256_setzero_pd());
+    _mm256_maskstore_pd(p + 4 - count, tail_mask_epi64(count), Vsrc[index].___m256d);
+    Vout[index].___m256d = _mm256_loadu_pd(p); }
+
+//
+// Load-fused sign and zero extension of the last bytes before the guard page,
+// which faults if more than the consumed bytes are read.  The ARM64 soft
+// intrinsics expose these as native _mem forms, x64 uses the usual idiom.
+//
+
+#if defined(_M_ARM64) || defined(_M_ARM64EC)
+#define CVTEPU8_EPI32_MEM(p)    _nn256_castn256_si256(_nn256_cvtepu8_epi32_mem(p))
+#define CVTEPI16_EPI64_MEM(p)   _nn256_castn256_si256(_nn256_cvtepi16_epi64_mem(p))
+#define CVTEPI8_EPI32_MEM(p)    _nn128_castn128_si128(_nn_cvtepi8_epi32_mem(p))
+#else
+#define CVTEPU8_EPI32_MEM(p)    _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i const *)(p)))
+#define CVTEPI16_EPI64_MEM(p)   _mm256_cvtepi16_epi64(_mm_loadl_epi64((__m128i const *)(p)))
+#define CVTEPI8_EPI32_MEM(p)    _mm_cvtepi8_epi32(_mm_cvtsi32_si128(*(int const *)(p)))
+#endif
+
+__forceinline void __cdecl test_kernel_cvtepu8_epi32_mem_tail(unsigned index) {
+    Vout[index].___m256i = CVTEPU8_EPI32_MEM(GuardPageEnd - 8 - index); }
+
+__forceinline void __cdecl test_kernel_cvtepi16_epi64_mem_tail(unsigned index) {
+    Vout[index].___m256i = CVTEPI16_EPI64_MEM(GuardPageEnd - 8 - index); }
+
+__forceinline void __cdecl test_kernel_cvtepi8_epi32_mem_tail(unsigned index) {
+    Vout[index].___m128i = CVTEPI8_EPI32_MEM(GuardPageEnd - 4 - index); }
+
+#endif // AVX2 kernels
+
+//
+// Initialize the tables and buffers used by all of the above kernels
+//
+
+__declspec(noinline)
+void init_kernels(void)
+{
+#if defined(__AVX2__) || (defined(USE_SOFT_INTRINSICS) && (USE_SOFT_INTRINSICS >= 2))
+    init_gather_kernels();
+    init_maskmov_kernels();
+    init_aes_kernels();
+    init_clmul_kernels();
+#if defined(TEST_SHA)
+    init_sha_kernels();
+#endif
+    init_f16c_kernels();
+    init_fill_kernels();
+    init_cache_kernels();
+    init_pcmpstr_kernels();
+#if !defined(_M_IX86)
+    init_popcnt_kernels();
+#endif
+#endif
+}